@@ -8,11 +8,15 @@
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cmath>
+#include <cstddef>
 #include <deque>
 #include <fstream>
 #include <iostream>
 #include <list>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <string>
 #include <sstream>
@@ -127,6 +131,8 @@ namespace c74::min {
     class matrix_operator_base;
     class gl_operator_base;
     class mc_operator_base;
+    class mc_lanes_base;
+    class oversampled_base;
     class sample_operator_base;
     class vector_operator_base;
     class ui_operator_base;
@@ -367,6 +373,14 @@ namespace c74::min {
 #include "c74_min_atom.h"
 #include "c74_min_dictionary.h"
 #include "c74_min_limit.h"      // Library of miscellaneous helper functions (e.g. range clipping)
+#include "c74_min_sample_batch.h" // Batches of samples processed in SIMD lanes
+#include "c74_min_audio_kernels.h" // Vectorized loops over samples, chosen for the processor at runtime
+#include "c74_min_function.h"   // Non-allocating callable wrapper used for callbacks
+#include "c74_min_mpsc_queue.h" // Lock-free queue with many producers and one consumer
+#include "c74_min_threadsafety.h" // Thread identity, checks, and triggers
+#include "c74_min_denormals.h" // Flushing denormal numbers to zero
+#include "c74_min_worker_pool.h" // Threads that help the audio thread with independent jobs
+#include "c74_min_profile.h"    // Opt-in timing of message calls
 
 #include "c74_min_notification.h"       // A class representing notifications from attached-to objects
 #include "c74_min_patcher.h"            // Wrapper for interfacing with patchers
@@ -376,15 +390,16 @@ namespace c74::min {
 #include "c74_min_flags.h"              // Class flags
 #include "c74_min_time.h"               // ITM Support
 #include "c74_min_port.h"               // Inlets and Outlets
-#include "c74_min_threadsafety.h"       // ...
 #include "c74_min_inlet.h"              // ...
 #include "c74_min_outlet.h"             // ...
 #include "c74_min_argument.h"           // Arguments to objects
 #include "c74_min_message.h"            // Messages to objects
 #include "c74_min_attribute.h"          // Attributes of objects
+#include "c74_min_smoothing.h"          // Values smoothed on the audio thread
 #include "c74_min_logger.h"             // Console / Max Window output
 #include "c74_min_operator_vector.h"    // Vector-based MSP object add-ins
 #include "c74_min_operator_sample.h"    // Sample-based MSP object add-ins
+#include "c74_min_oversampling.h"       // Sample-based MSP objects at a multiple of the samplerate
 #include "c74_min_operator_mc.h"    	// Vector-based MC object add-ins
 #include "c74_min_operator_matrix.h"    // Jitter MOP add-ins
 #include "c74_min_operator_ui.h"		// User Interface add-ins
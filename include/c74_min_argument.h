@@ -13,7 +13,7 @@ namespace c74::min {
     /// @see		MIN_ARGUMENT_FUNCTION
     /// @see		MIN_FUNCTION
 
-    using argument_function = std::function<void(const atom& a)>;
+    using argument_function = inline_function<void(const atom& a)>;
 
 
     /// Provide the correct lamba function prototype for the min::argument constructor.
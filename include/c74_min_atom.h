@@ -8,6 +8,7 @@
 namespace c74::min {
 
     class event;
+    class atoms;
 
     class atom : public max::t_atom {
     public:
@@ -18,7 +19,7 @@ namespace c74::min {
         }
 
         /// constructor with generic initializer
-        template<class T, typename enable_if<!std::is_enum<T>::value && !is_same<T, std::vector<atom>>::value, int>::type = 0>
+        template<class T, typename enable_if<!std::is_enum<T>::value && !is_same<T, atoms>::value, int>::type = 0>
         atom(const T initial_value) {
             *this = initial_value;
         }
@@ -243,12 +244,388 @@ namespace c74::min {
 
 
     /// The atoms container is the standard means by which zero or more values are passed.
-    /// It is implemented as a std::vector of the atom type, and thus atoms contained in an
+    /// It has the interface of a std::vector of the atom type, and thus atoms contained in an
     /// atoms container are 'owned' copies... not simply a reference to some externally owned atoms.
+    ///
+    /// Unlike a std::vector, up to #inline_capacity atoms are stored inside the container itself.
+    /// Most messages, outlet calls, and attribute values are short lists and so never touch the heap.
+    /// Longer lists spill to the heap as a std::vector would.
+    ///
+    /// The atoms are always contiguous, so `&as[0]` or `as.data()` may be passed to the Max API as a t_atom array.
+
+    class atoms {
+    public:
+        using value_type             = atom;
+        using size_type              = size_t;
+        using difference_type        = std::ptrdiff_t;
+        using reference              = atom&;
+        using const_reference        = const atom&;
+        using pointer                = atom*;
+        using const_pointer          = const atom*;
+        using iterator               = atom*;
+        using const_iterator         = const atom*;
+        using reverse_iterator       = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+
+        /// The number of atoms that can be held without allocating memory.
+
+        static constexpr size_type inline_capacity = 4;
+
+
+        atoms() noexcept {}
+
+        explicit atoms(const size_type count) {
+            resize(count);
+        }
+
+        atoms(const size_type count, const atom& value) {
+            assign(count, value);
+        }
+
+        template<class input_iterator, typename enable_if<!std::is_integral<input_iterator>::value, int>::type = 0>
+        atoms(const input_iterator first, const input_iterator last) {
+            assign(first, last);
+        }
+
+        atoms(const std::initializer_list<atom> values) {
+            assign(values.begin(), values.end());
+        }
+
+        atoms(const atoms& other) {
+            assign(other.begin(), other.end());
+        }
+
+        atoms(atoms&& other) noexcept {
+            take(other);
+        }
+
+        ~atoms() {
+            deallocate();
+        }
+
+        atoms& operator=(const atoms& other) {
+            if (this != &other)
+                assign(other.begin(), other.end());
+            return *this;
+        }
+
+        atoms& operator=(atoms&& other) noexcept {
+            if (this != &other) {
+                deallocate();
+                take(other);
+            }
+            return *this;
+        }
+
+        atoms& operator=(const std::initializer_list<atom> values) {
+            assign(values.begin(), values.end());
+            return *this;
+        }
+
+
+        // iterators
+
+        iterator begin() noexcept {
+            return m_data;
+        }
+        const_iterator begin() const noexcept {
+            return m_data;
+        }
+        const_iterator cbegin() const noexcept {
+            return m_data;
+        }
+        iterator end() noexcept {
+            return m_data + m_size;
+        }
+        const_iterator end() const noexcept {
+            return m_data + m_size;
+        }
+        const_iterator cend() const noexcept {
+            return m_data + m_size;
+        }
+        reverse_iterator rbegin() noexcept {
+            return reverse_iterator(end());
+        }
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator(end());
+        }
+        reverse_iterator rend() noexcept {
+            return reverse_iterator(begin());
+        }
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator(begin());
+        }
+
+
+        // capacity
+
+        size_type size() const noexcept {
+            return m_size;
+        }
+        bool empty() const noexcept {
+            return m_size == 0;
+        }
+        size_type capacity() const noexcept {
+            return m_capacity;
+        }
+        size_type max_size() const noexcept {
+            return std::numeric_limits<size_type>::max() / sizeof(atom);
+        }
+
+        void reserve(const size_type new_capacity) {
+            if (new_capacity > m_capacity)
+                reallocate(new_capacity);
+        }
+
+        void shrink_to_fit() {
+            if (!is_inline() && m_size <= inline_capacity) {
+                auto heap_data = m_data;
+
+                m_data     = m_inline;
+                m_capacity = inline_capacity;
+                std::copy(heap_data, heap_data + m_size, m_data);
+                ::operator delete(heap_data);
+            }
+        }
+
+
+        // element access
+
+        reference operator[](const size_type index) {
+            return m_data[index];
+        }
+        const_reference operator[](const size_type index) const {
+            return m_data[index];
+        }
+
+        reference at(const size_type index) {
+            if (index >= m_size)
+                throw std::out_of_range("atoms index out of range");
+            return m_data[index];
+        }
+        const_reference at(const size_type index) const {
+            if (index >= m_size)
+                throw std::out_of_range("atoms index out of range");
+            return m_data[index];
+        }
+
+        reference front() {
+            return m_data[0];
+        }
+        const_reference front() const {
+            return m_data[0];
+        }
+        reference back() {
+            return m_data[m_size - 1];
+        }
+        const_reference back() const {
+            return m_data[m_size - 1];
+        }
+
+        atom* data() noexcept {
+            return m_data;
+        }
+        const atom* data() const noexcept {
+            return m_data;
+        }
+
+
+        // modifiers
+
+        void clear() noexcept {
+            m_size = 0;
+        }
 
-    // TODO: how to document inherited interface, e.g. size(), begin(), etc. ?
+        void assign(const size_type count, const atom& value) {
+            const atom copy { value };    // value may refer to one of our own atoms
 
-    using atoms = std::vector<atom>;
+            clear();
+            reserve(count);
+            std::uninitialized_fill_n(m_data, count, copy);
+            m_size = count;
+        }
+
+        template<class input_iterator, typename enable_if<!std::is_integral<input_iterator>::value, int>::type = 0>
+        void assign(input_iterator first, const input_iterator last) {
+            clear();
+            append(first, last);
+        }
+
+        void assign(const std::initializer_list<atom> values) {
+            assign(values.begin(), values.end());
+        }
+
+        void push_back(const atom& value) {
+            if (m_size == m_capacity) {
+                const atom copy { value };    // value may refer to one of our own atoms
+                grow(m_size + 1);
+                new (m_data + m_size) atom(copy);
+            }
+            else
+                new (m_data + m_size) atom(value);
+            ++m_size;
+        }
+
+        template<class... argument_types>
+        reference emplace_back(argument_types&&... args) {
+            atom value(std::forward<argument_types>(args)...);
+            push_back(value);
+            return back();
+        }
+
+        void pop_back() {
+            --m_size;
+        }
+
+        void resize(const size_type count) {
+            resize(count, atom {});
+        }
+
+        void resize(const size_type count, const atom& value) {
+            if (count > m_size) {
+                const atom copy { value };
+
+                reserve(count);
+                std::uninitialized_fill(m_data + m_size, m_data + count, copy);
+            }
+            m_size = count;
+        }
+
+        iterator insert(const_iterator position, const atom& value) {
+            return insert(position, size_type(1), value);
+        }
+
+        iterator insert(const_iterator position, const size_type count, const atom& value) {
+            const auto index = static_cast<size_type>(position - begin());
+            const atom copy { value };
+
+            make_gap(index, count);
+            std::fill_n(m_data + index, count, copy);
+            return m_data + index;
+        }
+
+        template<class input_iterator, typename enable_if<!std::is_integral<input_iterator>::value, int>::type = 0>
+        iterator insert(const_iterator position, const input_iterator first, const input_iterator last) {
+            const auto index = static_cast<size_type>(position - begin());
+            const atoms values(first, last);    // the range may refer to our own atoms
+
+            make_gap(index, values.size());
+            std::copy(values.begin(), values.end(), m_data + index);
+            return m_data + index;
+        }
+
+        iterator insert(const_iterator position, const std::initializer_list<atom> values) {
+            return insert(position, values.begin(), values.end());
+        }
+
+        iterator erase(const_iterator position) {
+            return erase(position, position + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            const auto index = static_cast<size_type>(first - begin());
+            const auto count = static_cast<size_type>(last - first);
+
+            std::copy(m_data + index + count, m_data + m_size, m_data + index);
+            m_size -= count;
+            return m_data + index;
+        }
+
+        void swap(atoms& other) noexcept {
+            atoms tmp { std::move(other) };
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+
+        // comparison
+
+        friend bool operator==(const atoms& lhs, const atoms& rhs) {
+            return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](const atom& a, const atom& b) {
+                return a == b;
+            });
+        }
+
+        friend bool operator!=(const atoms& lhs, const atoms& rhs) {
+            return !(lhs == rhs);
+        }
+
+    private:
+        static_assert(std::is_trivially_copyable<atom>::value, "atoms are relocated by copying");
+
+        atom*     m_data { m_inline };
+        size_type m_size {};
+        size_type m_capacity { inline_capacity };
+        atom      m_inline[inline_capacity];
+
+
+        bool is_inline() const noexcept {
+            return m_data == m_inline;
+        }
+
+        void deallocate() noexcept {
+            if (!is_inline())
+                ::operator delete(m_data);
+        }
+
+        // move the contents of other into this container, leaving other empty
+        // our own heap memory (if any) must have been released already
+
+        void take(atoms& other) noexcept {
+            if (other.is_inline()) {
+                m_data     = m_inline;
+                m_capacity = inline_capacity;
+                std::copy(other.m_data, other.m_data + other.m_size, m_data);
+            }
+            else {
+                m_data           = other.m_data;
+                m_capacity       = other.m_capacity;
+                other.m_data     = other.m_inline;
+                other.m_capacity = inline_capacity;
+            }
+            m_size       = other.m_size;
+            other.m_size = 0;
+        }
+
+        void reallocate(const size_type new_capacity) {
+            auto new_data = static_cast<atom*>(::operator new(new_capacity * sizeof(atom)));
+
+            std::uninitialized_copy(m_data, m_data + m_size, new_data);
+            deallocate();
+            m_data     = new_data;
+            m_capacity = new_capacity;
+        }
+
+        void grow(const size_type minimum_capacity) {
+            reallocate(std::max(minimum_capacity, m_capacity * 2));
+        }
+
+        template<class input_iterator>
+        void append(input_iterator first, const input_iterator last) {
+            if (std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<input_iterator>::iterator_category>::value) {
+                const auto count = static_cast<size_type>(std::distance(first, last));
+
+                reserve(m_size + count);
+                for (; first != last; ++first, ++m_size)
+                    new (m_data + m_size) atom(*first);
+            }
+            else {
+                for (; first != last; ++first)
+                    push_back(atom(*first));
+            }
+        }
+
+        // open a gap of count default atoms at index, moving the atoms that follow it towards the end
+
+        void make_gap(const size_type index, const size_type count) {
+            if (m_size + count > m_capacity)
+                grow(m_size + count);
+            std::uninitialized_fill_n(m_data + m_size, count, atom {});
+            std::copy_backward(m_data + index, m_data + m_size, m_data + m_size + count);
+            m_size += count;
+        }
+    };
 
 
 #ifdef __APPLE__
@@ -304,11 +681,25 @@ namespace c74::min {
         // pop_front
         // pop_back
 
-        // TODO: we could consider implementing the following (but we may not need them due to limited role of this type):
-        // front()
-        // back()
-        // operator []
-        // at()
+        // Read-only element access returns copies of the atoms, which are trivially copyable.
+
+        atom operator[](const size_type index) const {
+            return atom(m_av + index);
+        }
+
+        atom at(const size_type index) const {
+            if (index < 0 || index >= m_ac)
+                throw std::out_of_range("atomref index out of range");
+            return (*this)[index];
+        }
+
+        atom front() const {
+            return at(0);
+        }
+
+        atom back() const {
+            return at(m_ac - 1);
+        }
 
         // The ctor does not alter the atoms, 
         // but note that some future operations done to the atom_reference could unless it is a const atom_reference
@@ -426,6 +817,12 @@ namespace std {
 
 namespace c74::min {
 
+    // Make the std::to_string() overloads above available to argument-dependent lookup for the atoms type
+    // (as they were when atoms was a std::vector).
+
+    using std::to_string;
+
+
     /// Expose atom for use in std output streams.
     template<class charT, class traits>
     std::basic_ostream<charT, traits>& operator<<(std::basic_ostream<charT, traits>& stream, const c74::min::atom& a) {
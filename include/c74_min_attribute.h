@@ -26,7 +26,7 @@ namespace c74::min {
     /// @return		A vector of atoms that represent the current state of the attribute.
     /// @see		MIN_GETTER_FUNCTION
 
-    using getter = std::function<atoms()>;
+    using getter = inline_function<atoms()>;
 
 
     /// Provide the correct lamba function prototype for a getter parameter to the min::attribute constructor.
@@ -134,6 +134,38 @@ namespace c74::min {
 	};
 
 
+    class attribute_base;
+
+
+    // Writes the samples of an audio inlet directly to the value of the attribute mapped to it.
+    // Used internally by sample_operator<> so that mapping a signal to an attribute neither allocates nor boxes samples in atoms.
+    // An empty writer means the attribute can only be set with atoms, e.g. because it has a setter function.
+
+    class attribute_sample_writer {
+    public:
+        using write_function = void (*)(attribute_base* an_attribute, const sample a_value);
+
+        attribute_sample_writer() = default;
+
+        attribute_sample_writer(attribute_base* an_attribute, const write_function a_function)
+        : m_attribute { an_attribute }
+        , m_function { a_function }
+        {}
+
+        explicit operator bool() const {
+            return m_function != nullptr;
+        }
+
+        void operator()(const sample a_value) const {
+            m_function(m_attribute, a_value);
+        }
+
+    private:
+        attribute_base* m_attribute { nullptr };
+        write_function  m_function { nullptr };
+    };
+
+
     // Represents any type of attribute.
     // Used internally to allow heterogenous containers of attributes for the Min class.
     /// @ingroup attributes
@@ -145,8 +177,9 @@ namespace c74::min {
         attribute_base(object_base& an_owner, const std::string& a_name)
         : m_owner{an_owner}
         , m_name{a_name}
-        , m_title{a_name}
-        {}
+        , m_title{a_name} {
+            m_owner.register_attribute(a_name, this);    // add the attribute to the owning object's pile
+        }
 
     public:
         attribute_base(const attribute_base& other)  = delete;    // no copying allowed!
@@ -165,6 +198,14 @@ namespace c74::min {
         virtual void set(const atoms& args, const bool notify = true, const bool override_readonly = false) = 0;
 
 
+        // Attributes with a numeric value may be written directly from the samples of an audio inlet mapped to them.
+        // Others return an empty writer and are set with atoms.
+
+        virtual attribute_sample_writer sample_writer() {
+            return {};
+        }
+
+
         // All attributes must define what happens when you get their value.
 
         virtual operator atoms() const = 0;
@@ -629,6 +670,16 @@ namespace c74::min {
         }
 
 
+        /// Get a writer that sets the attribute directly from the samples of an audio inlet mapped to it.
+        /// The value is limited to the attribute's range, but there is no notification and no setter function is called,
+        /// so the writer is empty for attributes with a setter function, readonly attributes, and those whose type is not numeric.
+        /// @return	The writer, which is only valid for the lifetime of the attribute.
+
+        attribute_sample_writer sample_writer() override {
+            return make_sample_writer();
+        }
+
+
         /// Get the raw attribute value from an attribute.
         /// @return The attribute value.
 
@@ -767,6 +818,38 @@ namespace c74::min {
         }
 
 
+        // Apply range limiting to a single value of the native type, as used when writing samples from an audio inlet.
+
+        template<class U = T, typename enable_if<is_same<limit_type<U>, limit::none<U>>::value, int>::type = 0>
+        T constrain(const T value) const {
+            return value;
+        }
+
+        template<class U = T, typename enable_if<!is_same<limit_type<U>, limit::none<U>>::value, int>::type = 0>
+        T constrain(const T value) const {
+            return limit_type<T>::apply(value, m_range[0], m_range[1]);
+        }
+
+
+        // Writers for samples from an audio inlet are made only for numeric attributes
+        // that can be assigned without calling a setter function.
+
+        template<class U = T, typename enable_if<std::is_arithmetic<U>::value, int>::type = 0>
+        attribute_sample_writer make_sample_writer() {
+            if (m_setter || !writable())
+                return {};
+            return { this, [](attribute_base* an_attribute, const sample a_value) {
+                auto self { static_cast<attribute*>(an_attribute) };
+                self->m_value = self->constrain(static_cast<T>(a_value));
+            }};
+        }
+
+        template<class U = T, typename enable_if<!std::is_arithmetic<U>::value, int>::type = 0>
+        attribute_sample_writer make_sample_writer() {
+            return {};
+        }
+
+
         // Assign the value to the internal data storage member.
         // Occurs after the limits are constrained, the setter is called, etc.
 
@@ -954,7 +1037,7 @@ namespace c74::min {
     template<class T>
     max::t_max_err min_attr_getter(minwrap<T>* self, max::t_object* maxattr, long* ac, max::t_atom** av) {
         const symbol	attr_name	= static_cast<const max::t_symbol*>(max::object_method(maxattr, k_sym_getname));
-        auto&	        attr		= self->m_min_object.attributes()[attr_name.c_str()];
+        auto	        attr		= self->m_min_object.attributes()[attr_name.c_str()];
         atoms	        rvals		= *attr;
 
         if ((*ac) != rvals.size() || !(*av)) {		 // otherwise use memory passed in
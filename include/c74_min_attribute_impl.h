@@ -14,8 +14,6 @@ namespace c74::min {
     template<typename... ARGS>
     attribute<T, threadsafety, limit_type, repetitions>::attribute(object_base* an_owner, const std::string a_name, const T a_default_value, ARGS... args)
     : attribute_base{ *an_owner, a_name } {
-        m_owner.attributes()[a_name] = this;
-
         if (is_same<T, bool>::value)
             m_datatype = k_sym_long;
         else if (is_same<T, int>::value)
@@ -60,8 +58,6 @@ namespace c74::min {
     attribute<time_value>::attribute(object_base* an_owner, const std::string a_name, const time_value a_default_value, ARGS... args)
     : attribute_base{ *an_owner, a_name }
     , m_value{ an_owner, a_name, static_cast<double>(a_default_value) } {
-        m_owner.attributes()[a_name] = this;
-
         m_datatype = k_sym_time;
         m_style    = style::time;
 
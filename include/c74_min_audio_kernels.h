@@ -0,0 +1,274 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#pragma once
+
+// The kernels are plain loops that the compiler vectorizes for the baseline instruction set of the target:
+// SSE2 on x86-64 and NEON on arm64.
+// GCC and Clang additionally compile them for AVX2 and AVX-512 on x86-64, and the best of these is picked when first used.
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define C74_MIN_KERNELS_X86
+    #if defined(__GNUC__) || defined(__clang__)
+        #define C74_MIN_KERNELS_MULTIVERSION
+    #endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define C74_MIN_KERNEL_INLINE inline __attribute__((always_inline))
+    #define C74_MIN_KERNEL_TARGET(isa) __attribute__((target(isa)))
+#elif defined(_MSC_VER)
+    #define C74_MIN_KERNEL_INLINE __forceinline
+    #define C74_MIN_KERNEL_TARGET(isa)
+#else
+    #define C74_MIN_KERNEL_INLINE inline
+    #define C74_MIN_KERNEL_TARGET(isa)
+#endif
+
+
+namespace c74::min {
+
+
+    /// The instruction sets for which the audio kernels are compiled.
+
+    enum class simd_level {
+        scalar,    ///< No SIMD instructions are known to be available.
+        sse2,      ///< The baseline of x86-64.
+        neon,      ///< The baseline of arm64.
+        avx2,      ///< x86-64 processors with AVX2 and FMA.
+        avx512     ///< x86-64 processors with AVX-512.
+    };
+
+
+    /// The audio kernels compiled for an instruction set.
+    /// Each operates on count samples, and the destination may be the same as a source to operate in place.
+    /// @see audio_kernels()
+
+    struct audio_kernel_table {
+        simd_level level;
+
+        void (*copy)(sample* destination, const sample* source, size_t count);                                       ///< destination = source
+        void (*fill)(sample* destination, sample value, size_t count);                                              ///< destination = value
+        void (*add)(sample* destination, const sample* a, const sample* b, size_t count);                           ///< destination = a + b
+        void (*multiply)(sample* destination, const sample* a, const sample* b, size_t count);                      ///< destination = a * b
+        void (*multiply_add)(sample* destination, const sample* a, const sample* b, size_t count);                  ///< destination += a * b
+        void (*add_scaled)(sample* destination, const sample* source, sample gain, size_t count);                   ///< destination += source * gain
+        void (*scale)(sample* destination, const sample* source, sample gain, sample increment, size_t count);      ///< destination = source * (gain + increment * index)
+        sample (*peak)(const sample* source, size_t count);                                                         ///< the largest absolute value
+        sample (*sum_of_squares)(const sample* source, size_t count);                                               ///< the sum of the squared values
+    };
+
+
+    namespace detail {
+
+        // The loops of the kernels, inlined into the functions of each table so that they are vectorized for its instruction set.
+        // Reductions accumulate in k_kernel_lanes partial results, so that they vectorize and give the same result for every instruction set.
+
+        static constexpr size_t k_kernel_lanes { 8 };
+
+
+        C74_MIN_KERNEL_INLINE void kernel_copy(sample* destination, const sample* source, const size_t count) {
+            for (size_t i = 0; i < count; ++i)
+                destination[i] = source[i];
+        }
+
+        C74_MIN_KERNEL_INLINE void kernel_fill(sample* destination, const sample value, const size_t count) {
+            for (size_t i = 0; i < count; ++i)
+                destination[i] = value;
+        }
+
+        C74_MIN_KERNEL_INLINE void kernel_add(sample* destination, const sample* a, const sample* b, const size_t count) {
+            for (size_t i = 0; i < count; ++i)
+                destination[i] = a[i] + b[i];
+        }
+
+        C74_MIN_KERNEL_INLINE void kernel_multiply(sample* destination, const sample* a, const sample* b, const size_t count) {
+            for (size_t i = 0; i < count; ++i)
+                destination[i] = a[i] * b[i];
+        }
+
+        C74_MIN_KERNEL_INLINE void kernel_multiply_add(sample* destination, const sample* a, const sample* b, const size_t count) {
+            for (size_t i = 0; i < count; ++i)
+                destination[i] += a[i] * b[i];
+        }
+
+        C74_MIN_KERNEL_INLINE void kernel_add_scaled(sample* destination, const sample* source, const sample gain, const size_t count) {
+            for (size_t i = 0; i < count; ++i)
+                destination[i] += source[i] * gain;
+        }
+
+        C74_MIN_KERNEL_INLINE void kernel_scale(sample* destination, const sample* source, const sample gain, const sample increment, const size_t count) {
+            if (increment == 0.0) {
+                for (size_t i = 0; i < count; ++i)
+                    destination[i] = source[i] * gain;
+            }
+            else {
+                for (size_t i = 0; i < count; ++i)
+                    destination[i] = source[i] * (gain + increment * static_cast<sample>(i));
+            }
+        }
+
+        C74_MIN_KERNEL_INLINE sample kernel_peak(const sample* source, const size_t count) {
+            sample peaks[k_kernel_lanes] {};
+            size_t i { 0 };
+
+            for (; i + k_kernel_lanes <= count; i += k_kernel_lanes) {
+                for (size_t lane = 0; lane < k_kernel_lanes; ++lane) {
+                    const auto value { std::fabs(source[i + lane]) };
+                    peaks[lane] = value > peaks[lane] ? value : peaks[lane];
+                }
+            }
+            for (; i < count; ++i) {
+                const auto value { std::fabs(source[i]) };
+                peaks[0] = value > peaks[0] ? value : peaks[0];
+            }
+
+            sample peak {};
+            for (auto lane_peak : peaks)
+                peak = lane_peak > peak ? lane_peak : peak;
+            return peak;
+        }
+
+        C74_MIN_KERNEL_INLINE sample kernel_sum_of_squares(const sample* source, const size_t count) {
+            sample sums[k_kernel_lanes] {};
+            size_t i { 0 };
+
+            for (; i + k_kernel_lanes <= count; i += k_kernel_lanes) {
+                for (size_t lane = 0; lane < k_kernel_lanes; ++lane)
+                    sums[lane] += source[i + lane] * source[i + lane];
+            }
+            for (; i < count; ++i)
+                sums[0] += source[i] * source[i];
+
+            sample sum {};
+            for (auto lane_sum : sums)
+                sum += lane_sum;
+            return sum;
+        }
+
+
+        // The baseline table, compiled for the target's baseline instruction set.
+
+        inline void baseline_copy(sample* d, const sample* s, size_t n) { kernel_copy(d, s, n); }
+        inline void baseline_fill(sample* d, sample v, size_t n) { kernel_fill(d, v, n); }
+        inline void baseline_add(sample* d, const sample* a, const sample* b, size_t n) { kernel_add(d, a, b, n); }
+        inline void baseline_multiply(sample* d, const sample* a, const sample* b, size_t n) { kernel_multiply(d, a, b, n); }
+        inline void baseline_multiply_add(sample* d, const sample* a, const sample* b, size_t n) { kernel_multiply_add(d, a, b, n); }
+        inline void baseline_add_scaled(sample* d, const sample* s, sample g, size_t n) { kernel_add_scaled(d, s, g, n); }
+        inline void baseline_scale(sample* d, const sample* s, sample g, sample inc, size_t n) { kernel_scale(d, s, g, inc, n); }
+        inline sample baseline_peak(const sample* s, size_t n) { return kernel_peak(s, n); }
+        inline sample baseline_sum_of_squares(const sample* s, size_t n) { return kernel_sum_of_squares(s, n); }
+
+        inline simd_level baseline_simd_level() {
+#if defined(C74_MIN_KERNELS_X86)
+            return simd_level::sse2;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+            return simd_level::neon;
+#else
+            return simd_level::scalar;
+#endif
+        }
+
+        inline const audio_kernel_table& baseline_kernels() {
+            static const audio_kernel_table table { baseline_simd_level(), baseline_copy, baseline_fill, baseline_add, baseline_multiply,
+                baseline_multiply_add, baseline_add_scaled, baseline_scale, baseline_peak, baseline_sum_of_squares };
+            return table;
+        }
+
+
+#ifdef C74_MIN_KERNELS_MULTIVERSION
+
+        // The table for AVX2 and FMA.
+
+        C74_MIN_KERNEL_TARGET("avx2,fma") inline void avx2_copy(sample* d, const sample* s, size_t n) { kernel_copy(d, s, n); }
+        C74_MIN_KERNEL_TARGET("avx2,fma") inline void avx2_fill(sample* d, sample v, size_t n) { kernel_fill(d, v, n); }
+        C74_MIN_KERNEL_TARGET("avx2,fma") inline void avx2_add(sample* d, const sample* a, const sample* b, size_t n) { kernel_add(d, a, b, n); }
+        C74_MIN_KERNEL_TARGET("avx2,fma") inline void avx2_multiply(sample* d, const sample* a, const sample* b, size_t n) { kernel_multiply(d, a, b, n); }
+        C74_MIN_KERNEL_TARGET("avx2,fma") inline void avx2_multiply_add(sample* d, const sample* a, const sample* b, size_t n) { kernel_multiply_add(d, a, b, n); }
+        C74_MIN_KERNEL_TARGET("avx2,fma") inline void avx2_add_scaled(sample* d, const sample* s, sample g, size_t n) { kernel_add_scaled(d, s, g, n); }
+        C74_MIN_KERNEL_TARGET("avx2,fma") inline void avx2_scale(sample* d, const sample* s, sample g, sample inc, size_t n) { kernel_scale(d, s, g, inc, n); }
+        C74_MIN_KERNEL_TARGET("avx2,fma") inline sample avx2_peak(const sample* s, size_t n) { return kernel_peak(s, n); }
+        C74_MIN_KERNEL_TARGET("avx2,fma") inline sample avx2_sum_of_squares(const sample* s, size_t n) { return kernel_sum_of_squares(s, n); }
+
+        inline const audio_kernel_table& avx2_kernels() {
+            static const audio_kernel_table table { simd_level::avx2, avx2_copy, avx2_fill, avx2_add, avx2_multiply,
+                avx2_multiply_add, avx2_add_scaled, avx2_scale, avx2_peak, avx2_sum_of_squares };
+            return table;
+        }
+
+
+        // The table for AVX-512.
+
+        C74_MIN_KERNEL_TARGET("avx512f,fma") inline void avx512_copy(sample* d, const sample* s, size_t n) { kernel_copy(d, s, n); }
+        C74_MIN_KERNEL_TARGET("avx512f,fma") inline void avx512_fill(sample* d, sample v, size_t n) { kernel_fill(d, v, n); }
+        C74_MIN_KERNEL_TARGET("avx512f,fma") inline void avx512_add(sample* d, const sample* a, const sample* b, size_t n) { kernel_add(d, a, b, n); }
+        C74_MIN_KERNEL_TARGET("avx512f,fma") inline void avx512_multiply(sample* d, const sample* a, const sample* b, size_t n) { kernel_multiply(d, a, b, n); }
+        C74_MIN_KERNEL_TARGET("avx512f,fma") inline void avx512_multiply_add(sample* d, const sample* a, const sample* b, size_t n) { kernel_multiply_add(d, a, b, n); }
+        C74_MIN_KERNEL_TARGET("avx512f,fma") inline void avx512_add_scaled(sample* d, const sample* s, sample g, size_t n) { kernel_add_scaled(d, s, g, n); }
+        C74_MIN_KERNEL_TARGET("avx512f,fma") inline void avx512_scale(sample* d, const sample* s, sample g, sample inc, size_t n) { kernel_scale(d, s, g, inc, n); }
+        C74_MIN_KERNEL_TARGET("avx512f,fma") inline sample avx512_peak(const sample* s, size_t n) { return kernel_peak(s, n); }
+        C74_MIN_KERNEL_TARGET("avx512f,fma") inline sample avx512_sum_of_squares(const sample* s, size_t n) { return kernel_sum_of_squares(s, n); }
+
+        inline const audio_kernel_table& avx512_kernels() {
+            static const audio_kernel_table table { simd_level::avx512, avx512_copy, avx512_fill, avx512_add, avx512_multiply,
+                avx512_multiply_add, avx512_add_scaled, avx512_scale, avx512_peak, avx512_sum_of_squares };
+            return table;
+        }
+
+#endif    // C74_MIN_KERNELS_MULTIVERSION
+
+    }    // namespace detail
+
+
+    /// Is an instruction set supported by both the processor and the kernels compiled for it?
+    /// @param	a_level		The instruction set.
+    /// @return				True if audio_kernels() can return a table for the instruction set.
+
+    inline bool simd_level_supported(const simd_level a_level) {
+        if (a_level == simd_level::scalar || a_level == detail::baseline_simd_level())
+            return true;
+#ifdef C74_MIN_KERNELS_MULTIVERSION
+        __builtin_cpu_init();
+        if (a_level == simd_level::avx2)
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        if (a_level == simd_level::avx512)
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("fma");
+#endif
+        return false;
+    }
+
+
+    /// Get the audio kernels compiled for an instruction set, e.g. to compare them in a benchmark.
+    /// @param	a_level		The instruction set, which must be supported.
+    ///						The scalar level returns the baseline kernels, as the compiler may vectorize them for the baseline instruction set.
+    /// @return				The table of kernels.
+
+    inline const audio_kernel_table& audio_kernels(const simd_level a_level) {
+        assert(simd_level_supported(a_level));
+#ifdef C74_MIN_KERNELS_MULTIVERSION
+        if (a_level == simd_level::avx512)
+            return detail::avx512_kernels();
+        if (a_level == simd_level::avx2)
+            return detail::avx2_kernels();
+#endif
+        return detail::baseline_kernels();
+    }
+
+
+    /// Get the audio kernels for the best instruction set that the processor supports.
+    /// The choice is made once, when first called.
+    /// @return	The table of kernels.
+
+    inline const audio_kernel_table& audio_kernels() {
+        static const audio_kernel_table& table {
+            simd_level_supported(simd_level::avx512) ? audio_kernels(simd_level::avx512)
+          : simd_level_supported(simd_level::avx2)   ? audio_kernels(simd_level::avx2)
+          : audio_kernels(detail::baseline_simd_level())
+        };
+        return table;
+    }
+
+
+}    // namespace c74::min
@@ -0,0 +1,155 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#pragma once
+
+// Denormal numbers are handled by the floating-point control register of each thread:
+// MXCSR on x86-64, where FTZ flushes denormal results and DAZ treats denormal inputs as zero,
+// and FPCR on arm64, where FZ does both.
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #include <xmmintrin.h>
+    #define C74_MIN_DENORMALS_X86
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+    #define C74_MIN_DENORMALS_ARM64
+#endif
+
+
+namespace c74::min {
+
+
+    /// Flags that determine how the perform routine of an audio class treats denormal numbers.
+    /// @see MIN_DENORMAL_FLAGS
+
+    enum class denormal_flags : int {
+        none,     ///< No flags. The perform routine runs with the floating-point mode of the audio thread.
+        flush     ///< Flush denormal numbers to zero while the perform routine runs, and restore the mode of the thread afterwards.
+    };
+
+
+    /// Declare how the perform routine of your audio class treats denormal numbers.
+    /// The flags are a compile-time constant, e.g. `MIN_DENORMAL_FLAGS { denormal_flags::flush };`
+    /// @see denormal_flags
+
+    #define MIN_DENORMAL_FLAGS static constexpr denormal_flags class_denormal_flags
+
+
+    /// The floating-point control state of the calling thread, as far as it concerns denormal numbers.
+    /// On processors without such a state this is always 0, and setting it does nothing.
+
+    class floating_point_mode {
+    public:
+
+        /// Whether denormals can be flushed on this processor.
+
+        static constexpr bool supported() {
+        #if defined(C74_MIN_DENORMALS_X86) || defined(C74_MIN_DENORMALS_ARM64)
+            return true;
+        #else
+            return false;
+        #endif
+        }
+
+
+        /// Get the control register of the calling thread.
+        /// @return	The value of the register.
+
+        static uint64_t get() {
+        #if defined(C74_MIN_DENORMALS_X86)
+            return _mm_getcsr();
+        #elif defined(C74_MIN_DENORMALS_ARM64)
+            uint64_t fpcr;
+            __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+            return fpcr;
+        #else
+            return 0;
+        #endif
+        }
+
+
+        /// Set the control register of the calling thread.
+        /// @param	mode	A value returned by get(), possibly with the bits of k_flush_bits added.
+
+        static void set(const uint64_t mode) {
+        #if defined(C74_MIN_DENORMALS_X86)
+            _mm_setcsr(static_cast<unsigned int>(mode));
+        #elif defined(C74_MIN_DENORMALS_ARM64)
+            __asm__ __volatile__("msr fpcr, %0" : : "r"(mode));
+        #endif
+        }
+
+
+        /// The bits of the control register that flush denormals to zero.
+
+    #if defined(C74_MIN_DENORMALS_X86)
+        static constexpr uint64_t k_flush_bits { 0x8040 };       // FTZ | DAZ
+    #elif defined(C74_MIN_DENORMALS_ARM64)
+        static constexpr uint64_t k_flush_bits { 1 << 24 };      // FZ
+    #else
+        static constexpr uint64_t k_flush_bits { 0 };
+    #endif
+    };
+
+
+    /// Flushes denormals to zero on the calling thread for as long as it exists, and then restores the previous mode.
+    /// Writing the control register is slow on some processors, so it is written only if the thread does not flush already,
+    /// as is the case on the audio thread of many hosts.
+
+    class denormal_guard {
+    public:
+        denormal_guard()
+        : m_mode { floating_point_mode::get() }
+        {
+            if ((m_mode & floating_point_mode::k_flush_bits) != floating_point_mode::k_flush_bits)
+                floating_point_mode::set(m_mode | floating_point_mode::k_flush_bits);
+        }
+
+        ~denormal_guard() {
+            if ((m_mode & floating_point_mode::k_flush_bits) != floating_point_mode::k_flush_bits)
+                floating_point_mode::set(m_mode);
+        }
+
+        denormal_guard(const denormal_guard&) = delete;
+        denormal_guard& operator=(const denormal_guard&) = delete;
+
+    private:
+        const uint64_t m_mode;
+    };
+
+
+    // SFINAE implementation used internally to determine if the Min class has
+    // declared class_denormal_flags using the macro above.
+
+    template<typename min_class_type>
+    struct has_class_denormal_flags {
+        template<class, class>
+        class checker;
+
+        template<typename C>
+        static std::true_type test(checker<C, decltype(&C::class_denormal_flags)>*);
+
+        template<typename C>
+        static std::false_type test(...);
+
+        typedef decltype(test<min_class_type>(nullptr)) type;
+        static const bool value = is_same<std::true_type, decltype(test<min_class_type>(nullptr))>::value;
+    };
+
+
+    // Used internally.
+    // Returns the declared class_denormal_flags, or denormal_flags::none if there are none.
+
+    template<class min_class_type>
+    constexpr typename enable_if<has_class_denormal_flags<min_class_type>::value, denormal_flags>::type class_get_denormal_flags() {
+        return min_class_type::class_denormal_flags;
+    }
+
+    template<class min_class_type>
+    constexpr typename enable_if<!has_class_denormal_flags<min_class_type>::value, denormal_flags>::type class_get_denormal_flags() {
+        return denormal_flags::none;
+    }
+
+
+}    // namespace c74::min
@@ -116,6 +116,14 @@ namespace c74::min {
         }
 
 
+        /// Get the Max dictionary, e.g. to fill it using the C Max API.
+        /// Unlike casting to max::t_object* this does not retain the dictionary.
+
+        max::t_dictionary* instance() const {
+            return m_instance;
+        }
+
+
         bool valid() const {
             return m_instance != nullptr;
         }
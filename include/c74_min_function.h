@@ -0,0 +1,219 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#pragma once
+
+namespace c74::min {
+
+
+    /// The number of bytes of captured state that an #inline_function can hold by default.
+    /// This is enough for a lambda capturing `this` and a few more pointers or numbers,
+    /// and for a std::function, whose size differs between standard libraries, so that code passing one keeps compiling.
+
+    static constexpr size_t inline_function_capacity { std::max(4 * sizeof(void*), sizeof(std::function<void()>)) };
+
+
+    template<class signature, size_t capacity = inline_function_capacity>
+    class inline_function;
+
+
+    /// A callable wrapper, like std::function, that stores its callable inside the object itself.
+    /// Constructing, copying, or calling an inline_function never allocates memory.
+    /// A callable (e.g. a lambda and its captures) that does not fit the capacity is a compile-time error
+    /// rather than a silent allocation: capture less (a pointer to the state rather than the state itself)
+    /// or use a larger capacity.
+    ///
+    /// @tparam	return_type		The return type of the function.
+    /// @tparam	argument_types	The types of the function's arguments.
+    /// @tparam	capacity		The number of bytes available to store the callable.
+
+    template<class return_type, class... argument_types, size_t capacity>
+    class inline_function<return_type(argument_types...), capacity> {
+    public:
+
+        /// Create an empty function.
+
+        inline_function() noexcept = default;
+
+
+        /// Create an empty function.
+
+        inline_function(std::nullptr_t) noexcept {}
+
+
+        /// Create a function from a callable such as a lambda.
+        /// A null function pointer or an empty std::function produces an empty inline_function.
+
+        template<class callable_type, typename enable_if<
+            !is_same<typename std::decay<callable_type>::type, inline_function>::value
+            && std::is_invocable_r<return_type, typename std::decay<callable_type>::type&, argument_types...>::value, int>::type = 0>
+        inline_function(callable_type&& a_callable) {
+            using stored_type = typename std::decay<callable_type>::type;
+
+            static_assert(sizeof(stored_type) <= capacity,
+                "The callable is too large to store inline. Capture less (e.g. only 'this') or increase the capacity.");
+            static_assert(alignof(stored_type) <= alignof(std::max_align_t),
+                "The callable is over-aligned and cannot be stored inline.");
+            static_assert(std::is_copy_constructible<stored_type>::value,
+                "The callable must be copyable.");
+
+            if (is_empty(a_callable))
+                return;
+
+            new (&m_storage) stored_type(std::forward<callable_type>(a_callable));
+            m_invoke = &invoke<stored_type>;
+            m_manage = &manage<stored_type>;
+        }
+
+
+        inline_function(const inline_function& other)
+        : m_invoke { other.m_invoke }
+        , m_manage { other.m_manage } {
+            if (m_manage)
+                m_manage(operation::copy, &m_storage, const_cast<storage*>(&other.m_storage));
+        }
+
+
+        inline_function(inline_function&& other) noexcept
+        : m_invoke { other.m_invoke }
+        , m_manage { other.m_manage } {
+            if (m_manage)
+                m_manage(operation::move, &m_storage, &other.m_storage);
+            other.reset();
+        }
+
+
+        ~inline_function() {
+            reset();
+        }
+
+
+        inline_function& operator=(const inline_function& other) {
+            if (this != &other) {
+                reset();
+                if (other.m_manage)
+                    other.m_manage(operation::copy, &m_storage, const_cast<storage*>(&other.m_storage));
+                m_invoke = other.m_invoke;
+                m_manage = other.m_manage;
+            }
+            return *this;
+        }
+
+
+        inline_function& operator=(inline_function&& other) noexcept {
+            if (this != &other) {
+                reset();
+                if (other.m_manage)
+                    other.m_manage(operation::move, &m_storage, &other.m_storage);
+                m_invoke = other.m_invoke;
+                m_manage = other.m_manage;
+                other.reset();
+            }
+            return *this;
+        }
+
+
+        inline_function& operator=(std::nullptr_t) noexcept {
+            reset();
+            return *this;
+        }
+
+
+        /// Call the function.
+        /// As with std::function, calling an empty function throws std::bad_function_call.
+
+        return_type operator()(argument_types... args) const {
+            if (!m_invoke)
+                throw std::bad_function_call();
+            return m_invoke(&m_storage, std::forward<argument_types>(args)...);
+        }
+
+
+        /// Determine if the function holds a callable.
+
+        explicit operator bool() const noexcept {
+            return m_invoke != nullptr;
+        }
+
+
+        friend bool operator==(const inline_function& f, std::nullptr_t) noexcept {
+            return !f;
+        }
+
+        friend bool operator==(std::nullptr_t, const inline_function& f) noexcept {
+            return !f;
+        }
+
+        friend bool operator!=(const inline_function& f, std::nullptr_t) noexcept {
+            return static_cast<bool>(f);
+        }
+
+        friend bool operator!=(std::nullptr_t, const inline_function& f) noexcept {
+            return static_cast<bool>(f);
+        }
+
+    private:
+        using storage = typename std::aligned_storage<capacity, alignof(std::max_align_t)>::type;
+
+        enum class operation { copy, move, destroy };
+
+        using invoke_function = return_type (*)(storage*, argument_types&&...);
+        using manage_function = void (*)(operation, storage*, storage*);
+
+        mutable storage m_storage;
+        invoke_function m_invoke { nullptr };
+        manage_function m_manage { nullptr };
+
+
+        template<class stored_type>
+        static return_type invoke(storage* a_storage, argument_types&&... args) {
+            return (*reinterpret_cast<stored_type*>(a_storage))(std::forward<argument_types>(args)...);
+        }
+
+
+        template<class stored_type>
+        static void manage(const operation an_operation, storage* destination, storage* source) {
+            switch (an_operation) {
+                case operation::copy:
+                    new (destination) stored_type(*reinterpret_cast<const stored_type*>(source));
+                    break;
+                case operation::move:
+                    new (destination) stored_type(std::move(*reinterpret_cast<stored_type*>(source)));
+                    break;
+                case operation::destroy:
+                    reinterpret_cast<stored_type*>(destination)->~stored_type();
+                    break;
+            }
+        }
+
+
+        void reset() noexcept {
+            if (m_manage)
+                m_manage(operation::destroy, &m_storage, nullptr);
+            m_invoke = nullptr;
+            m_manage = nullptr;
+        }
+
+
+        // Callables that may be null when given to us: function pointers and std::function.
+
+        template<class T>
+        static bool is_empty(const T&) noexcept {
+            return false;
+        }
+
+        template<class T>
+        static bool is_empty(T* const a_pointer) noexcept {
+            return a_pointer == nullptr;
+        }
+
+        template<class T>
+        static bool is_empty(const std::function<T>& a_function) noexcept {
+            return !a_function;
+        }
+    };
+
+
+}    // namespace c74::min
@@ -18,9 +18,8 @@ namespace c74::min {
     // implemented out-of-line because of bi-directional dependency of min::message<> and min::object_base
 
     atoms object_base::try_call(const std::string& name, const atoms& args) {
-        auto found_message = m_messages.find(name);
-        if (found_message != m_messages.end())
-            return (*found_message->second)(args);
+        if (auto found_message = messages()[name])
+            return (*found_message)(args);
         return {};
     }
 
@@ -158,47 +157,6 @@ namespace c74::min {
     }
 
 
-#ifdef __APPLE__
-#pragma mark -
-#pragma mark outlet_call_is_safe
-#endif
-
-
-    // specialized implementations of outlet_call_is_safe() used by outlet<> implementation
-
-    template<>
-    bool outlet_call_is_safe<thread_check::main>() {
-        if (max::systhread_ismainthread())
-            return true;
-        else
-            return false;
-    };
-
-
-    template<>
-    bool outlet_call_is_safe<thread_check::scheduler>() {
-        if (max::systhread_istimerthread())
-            return true;
-        else
-            return false;
-    };
-
-
-    template<>
-    bool outlet_call_is_safe<thread_check::any>() {
-        if (max::systhread_ismainthread() || max::systhread_istimerthread())
-            return true;
-        else
-            return false;
-    };
-
-
-    template<>
-    bool outlet_call_is_safe<thread_check::none>() {
-        return true;
-    };
-
-
 #ifdef __APPLE__
 #pragma mark -
 #pragma mark vector_operator
@@ -228,10 +186,13 @@ namespace c74::min {
 #endif
 
 
-    void deferred_message::pop() {
-        deferred_message x;
-        if (m_owning_message->m_deferred_messages.try_dequeue(x))
-            x.m_owning_message->m_function(x.m_args, x.m_inlet);
+    void deferred_message::call() {
+#ifdef C74_MIN_WITH_PROFILING
+        if (m_owning_message->m_profile)
+            m_owning_message->m_profile->add_deferral(profile_clock::now() - m_queued);
+#endif
+        auto profiling = m_owning_message->profile_call();
+        m_owning_message->m_function(m_args, m_inlet);
     }
 
 
@@ -12,9 +12,11 @@ namespace c74::min {
     /// Typically this is provided to argument as a lamba function using the #MIN_FUNCTION macro.
     /// @param	as		A vector of atoms which may contain any arguments passed to your function.
     /// @param	inlet	The number (zero-based index) of the inlet at which the message was received, if relevant. Otherwise -1.
+    /// The function is stored without allocating, so the lambda's captures must fit in #inline_function_capacity.
     /// @see		MIN_FUNCTION
+    /// @see		inline_function
 
-    using function = std::function<atoms(const atoms& as, const int inlet)>;
+    using function = inline_function<atoms(const atoms& as, const int inlet)>;
 
 
     /// Provide the correct lamba function prototype for the min::argument constructor.
@@ -78,8 +80,11 @@ namespace c74::min {
                     name = "mt_mouseleave";
             }
 
-            m_name                    = name;
-            m_owner->messages()[name] = this;    // add the message to the owning object's pile
+            m_name = name;
+            m_slot = m_owner->register_message(name, this);    // add the message to the owning object's pile
+#ifdef C74_MIN_WITH_PROFILING
+            m_profile = m_owner->profile_message(m_slot);
+#endif
         }
 
     public:
@@ -89,6 +94,60 @@ namespace c74::min {
         virtual atoms operator()(const atom arg, const int inlet = -1)        = 0;
 
 
+        /// Call the message with an int as sent by Max.
+        /// Typed messages override this to pass the value to their handler without boxing it in atoms.
+        /// @param	value	The int.
+        /// @param	inlet	Optional inlet number associated with the incoming message.
+
+        virtual void dispatch_int(const max::t_atom_long value, const int inlet = -1) {
+            (*this)(atom(value), inlet);
+        }
+
+
+        /// Call the message with a float as sent by Max.
+        /// Typed messages override this to pass the value to their handler without boxing it in atoms.
+        /// @param	value	The float.
+        /// @param	inlet	Optional inlet number associated with the incoming message.
+
+        virtual void dispatch_float(const double value, const int inlet = -1) {
+            (*this)(atom(value), inlet);
+        }
+
+
+        /// Call the message with no arguments (e.g. a bang) as sent by Max.
+        /// @param	inlet	Optional inlet number associated with the incoming message.
+
+        virtual void dispatch_bang(const int inlet = -1) {
+            (*this)(atoms {}, inlet);
+        }
+
+
+        /// Call the message with a list of atoms as sent by Max.
+        /// View messages override this to pass the caller's atoms to their handler without copying them.
+        /// @param	args	The atoms, which belong to the caller and are valid only for the duration of the call.
+        /// @param	inlet	Optional inlet number associated with the incoming message.
+
+        virtual void dispatch_atoms(const atom_reference& args, const int inlet = -1) {
+            (*this)(atoms(args.begin(), args.end()), inlet);
+        }
+
+
+        /// Call the message with a message whose name the object does not otherwise handle, as sent by Max to "anything".
+        /// View messages override this to pass the caller's atoms to their handler without copying them.
+        /// @param	name	The name of the message that was received.
+        /// @param	args	The atoms, which belong to the caller and are valid only for the duration of the call.
+        /// @param	inlet	Optional inlet number associated with the incoming message.
+
+        virtual void dispatch_anything(const symbol name, const atom_reference& args, const int inlet = -1) {
+            atoms as(args.size() + 1);
+
+            as[0] = name;
+            for (auto i = 0; i < args.size(); ++i)
+                as[i + 1] = args[i];
+            (*this)(as, inlet);
+        }
+
+
         /// Return the Max C API message type constant for this message.
         /// @return The type of the message as a numeric constant.
 
@@ -120,14 +179,52 @@ namespace c74::min {
             return m_name;
         }
 
+
+        /// Return the slot of the message in the owning object's message_slots().
+        /// @return	The zero-based position at which the message was registered with its owner.
+
+        size_t slot() const {
+            return m_slot;
+        }
+
     protected:
         object_base* m_owner;
         function     m_function;
         message_type m_type { message_type::gimme };
         symbol       m_name;
+        size_t       m_slot {};
         description  m_description;
+#ifdef C74_MIN_WITH_PROFILING
+        message_profile* m_profile {};
+#endif
 
         friend class object_base;
+        friend class deferred_message;
+
+        // Create the owning object's queue of deferred calls, if it has none yet.
+        // Called from the constructor, on the main thread, by messages that can be deferred,
+        // so that deferring a call from another thread neither allocates nor calls Max.
+
+        void prepare_to_defer() {
+            m_owner->deferred_calls();
+        }
+
+        // Queue a call to be run on the main thread by the owning object.
+
+        void defer(const atoms& args, const int inlet) {
+            m_owner->defer_message(this, args, inlet);
+        }
+
+        // Time a call of the message's action, which must happen while the returned scope is alive.
+        // Without C74_MIN_WITH_PROFILING this does nothing.
+
+        profile_scope profile_call() const {
+#ifdef C74_MIN_WITH_PROFILING
+            return profile_scope { m_profile };
+#else
+            return profile_scope {};
+#endif
+        }
 
         void update_inlet_number(int& inlet) {
             if (inlet == -1 && m_owner->maxobj()) {
@@ -144,32 +241,6 @@ namespace c74::min {
     class message;
 
 
-    class deferred_message {
-    public:
-        deferred_message(message<threadsafe::no>* an_owning_message, const atoms& args, const int inlet)
-        : m_owning_message{an_owning_message}
-        , m_args{args}
-        , m_inlet{inlet}
-        {}
-
-
-        deferred_message()
-        {}
-
-
-        // call a message's action and remove it from the queue
-        // will free the deferred_message in the process
-
-        void pop();
-
-
-    private:
-        message<threadsafe::no>* m_owning_message { nullptr };
-        atoms                    m_args {};
-        int                      m_inlet { -1 };
-    };
-
-
     /// A message.
     /// Messages (sometimes called Methods) in Max are how actions are triggered in objects.
     /// When you create a message in your Min class you provide the action that it should trigger as an argument,
@@ -198,8 +269,10 @@ namespace c74::min {
         ///							In most cases you should _not_ pass anything here and accept the default.
 
         message(object_base* an_owner, const std::string& a_name, const function& a_function, const description& a_description = {}, const message_type a_type = message_type::gimme)
-        : message_base(an_owner, a_name, a_function, a_description, a_type)
-        {}
+        : message_base(an_owner, a_name, a_function, a_description, a_type) {
+            if (!m_owner->is_assumed_threadsafe())
+                prepare_to_defer();
+        }
 
 
         /// Create a new message for a Min class.
@@ -211,8 +284,10 @@ namespace c74::min {
         ///							This is typically provided as a lamba function using the #MIN_FUNCTION definition.
 
         message(object_base* an_owner, const std::string& a_name, const description& a_description, const function& a_function)
-        : message_base(an_owner, a_name, a_function, a_description)
-        {}
+        : message_base(an_owner, a_name, a_function, a_description) {
+            if (!m_owner->is_assumed_threadsafe())
+                prepare_to_defer();
+        }
 
 
         /// Create a new message for a Min class.
@@ -239,29 +314,16 @@ namespace c74::min {
             update_inlet_number(inlet);
 
             // this is the same as what happens in a defer() call
-            if (m_owner->is_assumed_threadsafe() || max::systhread_ismainthread())
+            if (m_owner->is_assumed_threadsafe() || max::systhread_ismainthread()) {
+                auto profiling = profile_call();
                 return m_function(args, inlet);
-            else {
-                deferred_message m { reinterpret_cast<message<threadsafe::no>*>(this), args, inlet };
-                if (m_deferred_messages.try_enqueue(m)) {
-                    max::defer(this->m_owner->maxobj(), reinterpret_cast<max::method>(message<threadsafety>::defer_callback),
-                               reinterpret_cast<c74::max::t_symbol*>(this), 0, nullptr);
-                }
             }
+            else
+                defer(args, inlet);
             return {};
         }
 
 
-        void pop() {
-            auto r = m_deferred_messages.peek();
-            r->pop();
-        }
-
-        static void defer_callback(max::t_object* self, message<threadsafety>* m, const long, max::t_atom*) {
-            m->pop();
-        }
-
-
         /// Call the message's action.
         /// @param	arg		A single argument to send to the message's action.
         /// @return			Any return values will be returned as atoms.
@@ -270,12 +332,6 @@ namespace c74::min {
             atoms as { arg };
             return (*this)(as, inlet);
         }
-
-    private:
-        // Any messages received from outside the main thread will be deferred using the queue below.
-
-        friend class deferred_message;
-        fifo<deferred_message> m_deferred_messages { 2 };
     };
 
 
@@ -295,8 +351,9 @@ namespace c74::min {
         ///							In most cases you should _not_ pass anything here and accept the default.
 
         message(object_base* an_owner, const std::string& a_name, const function& a_function, const description& a_description = {}, const message_type type = message_type::gimme)
-        : message_base(an_owner, a_name, a_function, a_description)
-        {}
+        : message_base(an_owner, a_name, a_function, a_description) {
+            prepare_to_defer();
+        }
 
 
         /// Create a new message for a Min class.
@@ -308,8 +365,9 @@ namespace c74::min {
         ///							This is typically provided as a lamba function using the #MIN_FUNCTION definition.
 
         message(object_base* an_owner, const std::string& a_name, const description& a_description, const function& a_function)
-        : message_base(an_owner, a_name, a_function, a_description)
-        {}
+        : message_base(an_owner, a_name, a_function, a_description) {
+            prepare_to_defer();
+        }
 
 
         /// Call the message's action.
@@ -321,27 +379,15 @@ namespace c74::min {
             update_inlet_number(inlet);
 
             // this is the same as what happens in a defer() call
-            if (max::systhread_ismainthread())
+            if (max::systhread_ismainthread()) {
+                auto profiling = profile_call();
                 return m_function(args, inlet);
-            else {
-                deferred_message m { this, args, inlet };
-                if (m_deferred_messages.try_enqueue(m)) {
-                    max::defer(this->m_owner->maxobj(), reinterpret_cast<max::method>(message<threadsafe::no>::defer_callback),
-                               reinterpret_cast<c74::max::t_symbol*>(this), 0, nullptr);
-                }
             }
+            else
+                defer(args, inlet);
             return {};
         }
 
-        void pop() {
-            auto r = m_deferred_messages.peek();
-            r->pop();
-        }
-
-        static void defer_callback(max::t_object* self, message<threadsafe::no>* m, long, const max::t_atom*) {
-            m->pop();
-        }
-
 
         /// Call the message's action.
         /// @param	arg		A single argument to send to the message's action.
@@ -351,12 +397,6 @@ namespace c74::min {
             atoms as { arg };
             return (*this)(as, inlet);
         }
-
-    private:
-        // Any messages received from outside the main thread will be deferred using the queue below.
-
-        friend class deferred_message;
-        fifo<deferred_message> m_deferred_messages { 2 };
     };
 
 
@@ -401,6 +441,8 @@ namespace c74::min {
         atoms operator()(const atoms& args = {}, const int an_inlet = -1) override {
 			int inlet {an_inlet};
             update_inlet_number(inlet);
+
+            auto profiling = profile_call();
             return m_function(args, inlet);
         }
 
@@ -411,8 +453,252 @@ namespace c74::min {
         /// @return			Any return values will be returned as atoms.
 
         atoms operator()(const atom arg, const int inlet = -1) override {
+            auto profiling = profile_call();
             return m_function({arg}, inlet);
         }
     };
 
+
+    /// A message whose handler receives a single number rather than atoms.
+    /// When Max sends an int or float to a typed message the value is passed straight to the handler
+    /// without being boxed in atoms, so the call does not allocate any memory.
+    /// Calls that arrive as atoms (e.g. from try_call() or an inlet that isn't bound to "int" or "float")
+    /// and calls that must be deferred to the main thread are converted and take the same path as any other message.
+    ///
+    /// @tparam	T				The type of the value passed to the handler. Typically max::t_atom_long or double.
+    /// @tparam	threadsafety	Same as for min::message<>.
+    /// @see	int_message
+    /// @see	float_message
+    /// @see	bang_message
+
+    template<class T, threadsafe threadsafety = threadsafe::undefined>
+    class typed_message : public message<threadsafety> {
+    public:
+        /// The type of function called when the message is received.
+        /// @param	value	The value sent to the message.
+        /// @param	inlet	The number (zero-based index) of the inlet at which the message was received, if relevant. Otherwise -1.
+
+        using handler = inline_function<void(const T value, const int inlet)>;
+
+
+        /// Create a new typed message for a Min class.
+        ///
+        /// @param	an_owner		The Min object instance that owns this message. Typically you should pass 'this'.
+        /// @param	a_name			The name of the message. Typically "int" or "float".
+        /// @param	a_handler		The function to be called when the message is received by your object.
+        /// @param	a_description	Optional, but highly encouraged, description string to document the message.
+
+        typed_message(object_base* an_owner, const std::string& a_name, const handler& a_handler, const description& a_description = {})
+        : message<threadsafety>(an_owner, a_name, [this](const atoms& args, const int inlet) -> atoms {
+              m_handler(args.empty() ? T {} : static_cast<T>(args[0]), inlet);
+              return {};
+          }, a_description)
+        , m_handler { a_handler }
+        {}
+
+
+        /// Create a new typed message for a Min class.
+        ///
+        /// @param	an_owner		The Min object instance that owns this message. Typically you should pass 'this'.
+        /// @param	a_name			The name of the message. Typically "int" or "float".
+        /// @param	a_description	Optional, but highly encouraged, description string to document the message.
+        /// @param	a_handler		The function to be called when the message is received by your object.
+
+        typed_message(object_base* an_owner, const std::string& a_name, const description& a_description, const handler& a_handler)
+        : typed_message(an_owner, a_name, a_handler, a_description)
+        {}
+
+
+        void dispatch_int(const max::t_atom_long value, const int inlet = -1) override {
+            dispatch(static_cast<T>(value), inlet);
+        }
+
+
+        void dispatch_float(const double value, const int inlet = -1) override {
+            dispatch(static_cast<T>(value), inlet);
+        }
+
+    private:
+        handler m_handler;
+
+        void dispatch(const T value, const int an_inlet) {
+            if (threadsafety == threadsafe::yes || (threadsafety == threadsafe::undefined && this->m_owner->is_assumed_threadsafe())
+                || max::systhread_ismainthread()) {
+                int inlet {an_inlet};
+                this->update_inlet_number(inlet);
+
+                auto profiling = this->profile_call();
+                m_handler(value, inlet);
+            }
+            else
+                (*this)(atom(value), an_inlet);    // box the value so that it can be deferred like any other message
+        }
+    };
+
+
+    /// A typed message with no value, typically a "bang".
+    /// @tparam	threadsafety	Same as for min::message<>.
+
+    template<threadsafe threadsafety>
+    class typed_message<void, threadsafety> : public message<threadsafety> {
+    public:
+        /// The type of function called when the message is received.
+        /// @param	inlet	The number (zero-based index) of the inlet at which the message was received, if relevant. Otherwise -1.
+
+        using handler = inline_function<void(const int inlet)>;
+
+
+        /// Create a new typed message for a Min class.
+        ///
+        /// @param	an_owner		The Min object instance that owns this message. Typically you should pass 'this'.
+        /// @param	a_name			The name of the message. Typically "bang".
+        /// @param	a_handler		The function to be called when the message is received by your object.
+        /// @param	a_description	Optional, but highly encouraged, description string to document the message.
+
+        typed_message(object_base* an_owner, const std::string& a_name, const handler& a_handler, const description& a_description = {})
+        : message<threadsafety>(an_owner, a_name, [this](const atoms&, const int inlet) -> atoms {
+              m_handler(inlet);
+              return {};
+          }, a_description)
+        , m_handler { a_handler }
+        {}
+
+
+        /// Create a new typed message for a Min class.
+        ///
+        /// @param	an_owner		The Min object instance that owns this message. Typically you should pass 'this'.
+        /// @param	a_name			The name of the message. Typically "bang".
+        /// @param	a_description	Optional, but highly encouraged, description string to document the message.
+        /// @param	a_handler		The function to be called when the message is received by your object.
+
+        typed_message(object_base* an_owner, const std::string& a_name, const description& a_description, const handler& a_handler)
+        : typed_message(an_owner, a_name, a_handler, a_description)
+        {}
+
+
+        void dispatch_bang(const int an_inlet = -1) override {
+            if (threadsafety == threadsafe::yes || (threadsafety == threadsafe::undefined && this->m_owner->is_assumed_threadsafe())
+                || max::systhread_ismainthread()) {
+                int inlet {an_inlet};
+                this->update_inlet_number(inlet);
+
+                auto profiling = this->profile_call();
+                m_handler(inlet);
+            }
+            else
+                (*this)(atoms {}, an_inlet);
+        }
+
+    private:
+        handler m_handler;
+    };
+
+
+    /// A message whose handler receives its arguments as a read-only view of the atoms sent by Max.
+    /// Long lists (e.g. from zl or OSC) are passed to the handler without being copied into atoms,
+    /// so the call neither allocates nor copies.
+    /// Calls that must be deferred to the main thread are copied, because the caller's atoms will be gone by then.
+    ///
+    /// When the message is named "anything" the name of the message that was received is passed to the handler.
+    /// Otherwise the name of this message is passed.
+    ///
+    /// @tparam	threadsafety	Same as for min::message<>.
+
+    template<threadsafe threadsafety = threadsafe::undefined>
+    class view_message : public message<threadsafety> {
+    public:
+        /// The type of function called when the message is received.
+        /// @param	name	The name of the message that was received.
+        /// @param	args	The arguments of the message. They belong to the caller and must not be kept after the call.
+        /// @param	inlet	The number (zero-based index) of the inlet at which the message was received, if relevant. Otherwise -1.
+
+        using handler = inline_function<void(const symbol name, const atom_reference& args, const int inlet)>;
+
+
+        /// Create a new view message for a Min class.
+        ///
+        /// @param	an_owner		The Min object instance that owns this message. Typically you should pass 'this'.
+        /// @param	a_name			The name of the message.
+        /// @param	a_handler		The function to be called when the message is received by your object.
+        /// @param	a_description	Optional, but highly encouraged, description string to document the message.
+
+        view_message(object_base* an_owner, const std::string& a_name, const handler& a_handler, const description& a_description = {})
+        : message<threadsafety>(an_owner, a_name, [this](const atoms& args, const int inlet) -> atoms {
+              // calls made with atoms (e.g. try_call() or deferred calls) carry the name of an "anything" message as the first atom
+              if (this->m_name == k_sym_anything && !args.empty())
+                  m_handler(args[0], atom_reference(static_cast<long>(args.size() - 1), args.data() + 1), inlet);
+              else
+                  m_handler(this->m_name, atom_reference(static_cast<long>(args.size()), args.data()), inlet);
+              return {};
+          }, a_description)
+        , m_handler { a_handler }
+        {}
+
+
+        /// Create a new view message for a Min class.
+        ///
+        /// @param	an_owner		The Min object instance that owns this message. Typically you should pass 'this'.
+        /// @param	a_name			The name of the message.
+        /// @param	a_description	Optional, but highly encouraged, description string to document the message.
+        /// @param	a_handler		The function to be called when the message is received by your object.
+
+        view_message(object_base* an_owner, const std::string& a_name, const description& a_description, const handler& a_handler)
+        : view_message(an_owner, a_name, a_handler, a_description)
+        {}
+
+
+        void dispatch_atoms(const atom_reference& args, const int inlet = -1) override {
+            if (is_safe())
+                call(this->m_name, args, inlet);
+            else
+                message_base::dispatch_atoms(args, inlet);    // copies the atoms so that they can be deferred
+        }
+
+
+        void dispatch_anything(const symbol name, const atom_reference& args, const int inlet = -1) override {
+            if (is_safe())
+                call(name, args, inlet);
+            else
+                message_base::dispatch_anything(name, args, inlet);    // copies the atoms so that they can be deferred
+        }
+
+    private:
+        handler m_handler;
+
+        bool is_safe() const {
+            return threadsafety == threadsafe::yes || (threadsafety == threadsafe::undefined && this->m_owner->is_assumed_threadsafe())
+                || max::systhread_ismainthread();
+        }
+
+        void call(const symbol name, const atom_reference& args, const int an_inlet) {
+            int inlet {an_inlet};
+            this->update_inlet_number(inlet);
+
+            auto profiling = this->profile_call();
+            m_handler(name, args, inlet);
+        }
+    };
+
+
+    /// A message that receives an int from Max without allocating.
+    /// @see typed_message
+
+    template<threadsafe threadsafety = threadsafe::undefined>
+    using int_message = typed_message<max::t_atom_long, threadsafety>;
+
+
+    /// A message that receives a float from Max without allocating.
+    /// An int sent to this message (when there is no "int" message) is converted to a float.
+    /// @see typed_message
+
+    template<threadsafe threadsafety = threadsafe::undefined>
+    using float_message = typed_message<double, threadsafety>;
+
+
+    /// A message that receives a bang (or any other message without arguments) from Max without allocating.
+    /// @see typed_message
+
+    template<threadsafe threadsafety = threadsafe::undefined>
+    using bang_message = typed_message<void, threadsafety>;
+
 }    // namespace c74::min
@@ -0,0 +1,236 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#pragma once
+
+namespace c74::min {
+
+
+    /// What an #mpsc_queue does with an item pushed while the queue is full.
+
+    enum class queue_overflow {
+        drop,         ///< Discard the new item.
+        overwrite,    ///< Discard the oldest item to make room for the new item.
+        grow          ///< Keep the new item in an overflow list, which allocates memory.
+    };
+
+
+    /// A bounded queue which any number of threads may push to and one thread pops from.
+    /// Items are stored in a ring allocated up front, so pushing and popping neither lock nor allocate
+    /// until the ring is full, at which point the overflow policy applies.
+    /// Items pushed from one thread are popped in the order they were pushed.
+    ///
+    /// @tparam	T	The type of item stored in the queue. It must be default-constructible and assignable.
+
+    template<class T>
+    class mpsc_queue {
+    public:
+
+        /// Create a queue.
+        /// @param	a_capacity	The number of items the ring holds. Rounded up to a power of two.
+        /// @param	a_policy	What to do when an item is pushed while the ring is full.
+
+        explicit mpsc_queue(const size_t a_capacity, const queue_overflow a_policy = queue_overflow::drop) {
+            configure(a_capacity, a_policy);
+        }
+
+        mpsc_queue(const mpsc_queue&) = delete;
+        mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+
+        /// Change the capacity and overflow policy of the queue.
+        /// Any items in the queue are discarded.
+        /// This is not threadsafe: call it only when no other thread is using the queue, e.g. from the owning object's constructor.
+        /// @param	a_capacity	The number of items the ring holds. Rounded up to a power of two.
+        /// @param	a_policy	What to do when an item is pushed while the ring is full.
+
+        void configure(const size_t a_capacity, const queue_overflow a_policy) {
+            size_t capacity { 2 };
+            while (capacity < a_capacity)
+                capacity <<= 1;
+
+            m_cells = std::make_unique<cell[]>(capacity);
+            for (auto i = 0u; i < capacity; ++i)
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+
+            m_mask   = capacity - 1;
+            m_policy = a_policy;
+            m_enqueue_position.store(0, std::memory_order_relaxed);
+            m_dequeue_position.store(0, std::memory_order_relaxed);
+            m_overflow.clear();
+            m_overflow_count.store(0, std::memory_order_relaxed);
+            m_dropped.store(0, std::memory_order_relaxed);
+        }
+
+
+        /// Push an item onto the queue. Threadsafe.
+        /// @param	an_item	The item to push.
+        /// @return			False if the item was dropped because the queue is full. Otherwise true.
+
+        bool try_enqueue(const T& an_item) {
+            if (m_policy == queue_overflow::grow) {
+                // while anything is waiting in the overflow list new items go there too, so that they stay in order
+                if (m_overflow_count.load(std::memory_order_acquire) == 0 && push(an_item))
+                    return true;
+
+                std::lock_guard<std::mutex> lock { m_overflow_mutex };
+                m_overflow.push_back(an_item);
+                m_overflow_count.fetch_add(1, std::memory_order_release);
+                return true;
+            }
+
+            while (!push(an_item)) {
+                if (m_policy == queue_overflow::drop) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                T oldest;
+                if (pop(oldest))
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            return true;
+        }
+
+
+        /// Pop the oldest item from the queue.
+        /// Only one thread may pop from a queue.
+        /// @param	an_item	Receives the item.
+        /// @return			False if the queue was empty. Otherwise true.
+
+        bool try_dequeue(T& an_item) {
+            if (pop(an_item))
+                return true;
+
+            if (m_overflow_count.load(std::memory_order_acquire) == 0)
+                return false;
+
+            // a producer may have claimed a cell of the ring without having filled it yet,
+            // in which case its item is older than anything in the overflow list
+            if (m_enqueue_position.load(std::memory_order_acquire) != m_dequeue_position.load(std::memory_order_relaxed))
+                return false;
+
+            std::lock_guard<std::mutex> lock { m_overflow_mutex };
+            if (m_overflow.empty())
+                return false;
+            an_item = std::move(m_overflow.front());
+            m_overflow.pop_front();
+            m_overflow_count.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+
+
+        /// The approximate number of items in the queue.
+        /// The count is exact if no other thread is using the queue.
+
+        size_t size_approx() const {
+            auto enqueued = m_enqueue_position.load(std::memory_order_relaxed);
+            auto dequeued = m_dequeue_position.load(std::memory_order_relaxed);
+            auto overflow = m_overflow_count.load(std::memory_order_relaxed);
+            return (enqueued > dequeued ? enqueued - dequeued : 0) + overflow;
+        }
+
+
+        /// The number of items the ring holds before the overflow policy applies.
+
+        size_t capacity() const {
+            return m_mask + 1;
+        }
+
+
+        /// The overflow policy of the queue.
+
+        queue_overflow policy() const {
+            return m_policy;
+        }
+
+
+        /// The number of items discarded by the drop or overwrite policies since the queue was configured.
+
+        size_t dropped() const {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        // A cell is ready to be pushed to when its sequence equals the enqueue position,
+        // and ready to be popped when its sequence is one past the dequeue position.
+
+        struct cell {
+            std::atomic<size_t> sequence;
+            T                   item;
+        };
+
+        // The positions are padded apart rather than aligned so that the queue can live in objects allocated by Max,
+        // which makes no promise of alignment beyond that of a pointer.
+
+        static constexpr size_t k_cache_line { 64 };
+
+        std::unique_ptr<cell[]> m_cells;
+        size_t                  m_mask {};
+        queue_overflow          m_policy { queue_overflow::drop };
+        std::atomic<size_t>     m_enqueue_position {};
+        char                    m_enqueue_padding[k_cache_line];
+        std::atomic<size_t>     m_dequeue_position {};
+        char                    m_dequeue_padding[k_cache_line];
+        std::atomic<size_t>     m_overflow_count {};
+        std::atomic<size_t>     m_dropped {};
+        std::mutex              m_overflow_mutex;
+        std::deque<T>           m_overflow;
+
+
+        bool push(const T& an_item) {
+            auto  position = m_enqueue_position.load(std::memory_order_relaxed);
+            cell* c;
+
+            while (true) {
+                c                   = &m_cells[position & m_mask];
+                const auto sequence = c->sequence.load(std::memory_order_acquire);
+                const auto distance = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+                if (distance == 0) {
+                    if (m_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (distance < 0)
+                    return false;    // full
+                else
+                    position = m_enqueue_position.load(std::memory_order_relaxed);
+            }
+
+            c->item = an_item;
+            c->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+
+        // Producers pop too when overwriting, so popping also claims its position with a compare-and-swap.
+
+        bool pop(T& an_item) {
+            auto  position = m_dequeue_position.load(std::memory_order_relaxed);
+            cell* c;
+
+            while (true) {
+                c                   = &m_cells[position & m_mask];
+                const auto sequence = c->sequence.load(std::memory_order_acquire);
+                const auto distance = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+                if (distance == 0) {
+                    if (m_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (distance < 0)
+                    return false;    // empty
+                else
+                    position = m_dequeue_position.load(std::memory_order_relaxed);
+            }
+
+            an_item = std::move(c->item);
+            c->sequence.store(position + m_mask + 1, std::memory_order_release);
+            return true;
+        }
+    };
+
+
+}    // namespace c74::min
@@ -132,7 +132,8 @@ namespace c74::min {
     public:
         /// Constructor.
 
-        object() {
+        object()
+        : object_base { shared_registry() } {
 
             // The way objects are created for the Max environment requires that memory be allocated first
             // using object_alloc() or jit_object_alloc(), which is followed by the use of placement-new to contruct the C++ class.
@@ -180,6 +181,14 @@ namespace c74::min {
 
 
 
+    private:
+        // The names of the messages and attributes of the class, shared by all of its instances.
+
+        static class_registry& shared_registry() {
+            static class_registry s_registry;
+            return s_registry;
+        }
+
     protected:
         logger cout     { this, logger::type::message };
         logger cwarn    { this, logger::type::warning };
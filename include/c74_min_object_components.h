@@ -72,6 +72,226 @@ namespace c74::min {
     };
 
 
+    // A call to a message that has been deferred to the main thread.
+    // Used internally by the owning object's queue of deferred messages.
+
+    class deferred_message {
+    public:
+        deferred_message(message_base* an_owning_message, const atoms& args, const int inlet)
+        : m_owning_message{an_owning_message}
+        , m_args{args}
+        , m_inlet{inlet}
+#ifdef C74_MIN_WITH_PROFILING
+        , m_queued{profile_clock::now()}
+#endif
+        {}
+
+
+        deferred_message()
+        {}
+
+
+        // call the message's action (defined in c74_min_impl.h)
+
+        void call();
+
+
+    private:
+        message_base* m_owning_message { nullptr };
+        atoms         m_args {};
+        int           m_inlet { -1 };
+#ifdef C74_MIN_WITH_PROFILING
+        profile_clock::time_point m_queued {};
+#endif
+    };
+
+
+    /// The default number of deferred message calls an object queues before its overflow policy applies.
+    /// @see object_base::deferred_messages()
+
+    static constexpr size_t k_deferred_message_capacity { 16 };
+
+
+    /// The names of one kind of component (e.g. the messages) of a class.
+    /// Each name is given a slot, which is where every instance of the class keeps its pointer to the component with that name.
+    /// Components are members of the class, so their names are the same for every instance
+    /// and are stored here once per class rather than once per instance.
+    /// Names are added as instances are constructed, which happens on the main thread.
+
+    class component_registry {
+    public:
+        static constexpr size_t npos { std::numeric_limits<size_t>::max() };
+
+
+        /// Get the slot for a name, adding the name if it has not been registered before.
+        /// @param	a_name	The name of the component.
+        /// @return			The slot of the component.
+
+        size_t add(const std::string& a_name) {
+            auto found = m_slots.find(a_name);
+            if (found != m_slots.end())
+                return found->second;
+
+            auto inserted = m_slots.emplace(a_name, m_names.size()).first;
+            m_names.push_back(&inserted->first);
+            return inserted->second;
+        }
+
+
+        /// Find the slot for a name.
+        /// @param	a_name	The name of the component.
+        /// @return			The slot of the component, or npos if no component with this name has been registered.
+
+        size_t find(const std::string& a_name) const {
+            auto found = m_slots.find(a_name);
+            return found != m_slots.end() ? found->second : npos;
+        }
+
+
+        /// Get the name registered for a slot.
+
+        const std::string& name(const size_t slot) const {
+            return *m_names[slot];
+        }
+
+
+        /// The number of names registered.
+
+        size_t size() const {
+            return m_names.size();
+        }
+
+    private:
+        std::unordered_map<std::string, size_t> m_slots;
+        std::vector<const std::string*>         m_names;    // the keys of m_slots, by slot
+    };
+
+
+    /// The registries of the components of a class, shared by all of its instances.
+
+    struct class_registry {
+        component_registry messages;
+        component_registry attributes;
+#ifdef C74_MIN_WITH_PROFILING
+        class_profile      profile;
+#endif
+    };
+
+
+    /// A read-only view of the components of an object by name, used like a std::unordered_map<std::string, component_type*>.
+    /// The names come from the class's registry and the pointers from the object's own slots.
+    /// Iterating visits the components in the order in which their names were first registered.
+
+    template<class component_type>
+    class component_map {
+    public:
+        using value_type = std::pair<const std::string&, component_type*>;
+
+
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = component_map::value_type;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const value_type*;
+            using reference         = const value_type&;
+
+            // The iterator refers to the registry and the slots rather than to the view, which is often a temporary.
+
+            iterator(const component_map& a_map, const size_t a_slot)
+            : m_registry { &a_map.m_registry }
+            , m_slots { &a_map.m_slots }
+            , m_slot { a_slot } {
+                skip_empty_slots();
+            }
+
+            reference operator*() const {
+                m_value.emplace(m_registry->name(m_slot), (*m_slots)[m_slot]);
+                return *m_value;
+            }
+
+            pointer operator->() const {
+                return &**this;
+            }
+
+            iterator& operator++() {
+                ++m_slot;
+                skip_empty_slots();
+                return *this;
+            }
+
+            iterator operator++(int) {
+                auto previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const iterator& other) const {
+                return m_slot == other.m_slot;
+            }
+
+            bool operator!=(const iterator& other) const {
+                return m_slot != other.m_slot;
+            }
+
+        private:
+            const component_registry*           m_registry;
+            const std::vector<component_type*>* m_slots;
+            size_t                              m_slot;
+            mutable std::optional<value_type>   m_value;
+
+            // an instance may not have every component that has been registered for its class
+            void skip_empty_slots() {
+                while (m_slot < m_slots->size() && !(*m_slots)[m_slot])
+                    ++m_slot;
+            }
+        };
+
+        using const_iterator = iterator;
+
+
+        component_map(const component_registry& a_registry, const std::vector<component_type*>& a_slots)
+        : m_registry { a_registry }
+        , m_slots { a_slots }
+        {}
+
+        iterator begin() const {
+            return { *this, 0 };
+        }
+
+        iterator end() const {
+            return { *this, m_slots.size() };
+        }
+
+        iterator find(const std::string& a_name) const {
+            const auto slot = m_registry.find(a_name);
+            return slot < m_slots.size() && m_slots[slot] ? iterator { *this, slot } : end();
+        }
+
+        /// Unlike std::unordered_map this does not insert anything: it returns nullptr if there is no component with the name.
+        component_type* operator[](const std::string& a_name) const {
+            const auto slot = m_registry.find(a_name);
+            return slot < m_slots.size() ? m_slots[slot] : nullptr;
+        }
+
+        size_t count(const std::string& a_name) const {
+            return (*this)[a_name] ? 1 : 0;
+        }
+
+        size_t size() const {
+            return static_cast<size_t>(std::count_if(m_slots.begin(), m_slots.end(), [](const component_type* c) { return c != nullptr; }));
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+    private:
+        const component_registry&          m_registry;
+        const std::vector<component_type*>& m_slots;
+    };
+
+
     /// An object_base is a generic way to pass around a min::object.
     /// Required because a min::object<>, though sharing common code,
     /// is actually specific to the the user's defined class due to template specialization.
@@ -84,8 +304,11 @@ namespace c74::min {
         // The dictionary representing the object in the patcher is referenced (owned) by m_state.
         // Inheriting classes can retrieve information from this dictionary using the state() method.
 
-        object_base()
-        : m_state { (max::t_dictionary*)k_sym__pound_d, false }
+        // The registry holds the names of the components of the class, and is shared by all its instances.
+
+        explicit object_base(class_registry& a_registry)
+        : m_registry { a_registry }
+        , m_state { (max::t_dictionary*)k_sym__pound_d, false }
         {}
 
 
@@ -206,35 +429,44 @@ namespace c74::min {
         }
 
 
-        /// Get a reference to this object's messages.
-        /// @return	A reference to this object's messages.
+        /// Get this object's messages by name.
+        /// @return	A view of this object's messages, which can be used like a std::unordered_map<std::string, message_base*>.
 
-        auto messages() -> std::unordered_map<std::string, message_base*>& {
-            return m_messages;
+        auto messages() const -> component_map<message_base> {
+            return { m_registry.messages, m_message_slots };
         }
 
-        /// Get a reference to this object's messages.
-        /// @return	A reference to this object's messages.
 
-        auto messages() const -> const std::unordered_map<std::string, message_base*>& {
-            return m_messages;
+        /// Get this object's messages in the order in which they were registered.
+        /// The position of a message in this list is its slot.
+        /// Because messages are members of the class the slots are the same for every instance of a class,
+        /// which allows the wrapper to resolve a message once at class setup rather than by name on every call.
+        /// A slot is nullptr if this instance has no message with the name registered for that slot by another instance.
+        /// @return	A reference to this object's message slots.
+
+        auto message_slots() const -> const std::vector<message_base*>& {
+            return m_message_slots;
         }
 
 
-        /// Get a reference to this object's attributes.
-        /// @return	A reference to this object's attributes.
+        /// Get this object's attributes by name.
+        /// @return	A view of this object's attributes, which can be used like a std::unordered_map<std::string, attribute_base*>.
 
-        auto attributes() -> std::unordered_map<std::string, attribute_base*>& {
-            return m_attributes;
+        auto attributes() const -> component_map<attribute_base> {
+            return { m_registry.attributes, m_attribute_slots };
         }
 
 
-        /// Get a reference to this object's attributes.
-        /// @return	A reference to this object's attributes.
+#ifdef C74_MIN_WITH_PROFILING
+        /// Get the profile of the calls to the messages of this object's class.
+        /// Only available when Min is compiled with C74_MIN_WITH_PROFILING defined.
+        /// The profile of a message is at the same position as the message in message_slots().
+        /// @return	A reference to the profile, which is shared by all instances of the class.
 
-        auto attributes() const -> const std::unordered_map<std::string, attribute_base*>& {
-            return m_attributes;
+        const class_profile& profile() const {
+            return m_registry.profile;
         }
+#endif
 
 
         /// Is this object done being initialized?
@@ -318,26 +550,59 @@ namespace c74::min {
         /// @see				try_call()
 
         bool has_call(const std::string& name) const {
-            auto found_message = m_messages.find(name);
-            return (found_message != m_messages.end());
+            return messages()[name] != nullptr;
+        }
+
+
+        /// The queue of message calls received outside the main thread and waiting to be run on it.
+        /// All of the object's messages share the queue, and every call waiting in it is run by a single main-thread callback.
+        /// The queue is created with the first message that can be deferred, so objects without one do not pay for it.
+        /// To change the capacity or the overflow policy call configure() on the queue from your object's constructor, e.g.
+        /// `deferred_messages().configure(256, queue_overflow::overwrite);`
+        /// @return	The queue of deferred messages.
+
+        mpsc_queue<deferred_message>& deferred_messages() {
+            return deferred_calls().queue;
         }
 
     private:
+        // The queue of message calls waiting to be run on the main thread, and the qelem that runs them.
+
+        struct deferred_call_queue {
+            explicit deferred_call_queue(object_base* an_owner)
+            : qelem { max::qelem_new(an_owner, reinterpret_cast<max::method>(deferred_messages_qfn)) }
+            {}
+
+            ~deferred_call_queue() {
+                max::qelem_free(qelem);
+            }
+
+            deferred_call_queue(const deferred_call_queue&) = delete;
+            deferred_call_queue& operator=(const deferred_call_queue&) = delete;
+
+            mpsc_queue<deferred_message> queue { k_deferred_message_capacity, queue_overflow::grow };
+            max::t_qelem*                qelem;
+        };
+
         max::t_object*                                   m_maxobj;       // initialized prior to placement new
         long                                             m_min_magic;    // should be valid if m_maxobj has been assigned
         bool                                             m_initialized { false };
         std::vector<inlet_base*>                         m_inlets;
         std::vector<outlet_base*>                        m_outlets;
         std::vector<argument_base*>                      m_arguments;
-        std::unordered_map<std::string, message_base*>   m_messages;      // written at class init -- readonly thereafter
-        std::unordered_map<std::string, attribute_base*> m_attributes;    // written at class init -- readonly thereafter
+        class_registry&                                  m_registry;     // the names of the components, shared with all instances of the class
+        std::vector<message_base*>                       m_message_slots;    // written at class init -- readonly thereafter
+        std::vector<attribute_base*>                     m_attribute_slots;  // written at class init -- readonly thereafter
         dict                                             m_state;
         symbol                                           m_classname;    // what's typed in the max box
+        std::unique_ptr<deferred_call_queue>             m_deferred_calls;       // created by the first message that can defer
 
         friend class inlet_base;
         friend class outlet_base;
 
         friend class argument_base;
+        friend class message_base;
+        friend class attribute_base;
 
         template<class min_class_type, class>
         friend struct minwrap;
@@ -398,12 +663,92 @@ namespace c74::min {
         }
 
 
+        // Return the queue of deferred calls, creating it if there is none yet.
+        // Called on the main thread only: by a min::message that can be deferred, as it is created, or by deferred_messages().
+        // The threads that defer calls therefore neither allocate nor call Max to create the queue,
+        // and objects whose messages never defer never pay for it.
+
+        deferred_call_queue& deferred_calls() {
+            if (!m_deferred_calls)
+                m_deferred_calls = std::make_unique<deferred_call_queue>(this);
+            return *m_deferred_calls;
+        }
+
+
+        // Called by a min::message to run a call on the main thread.
+        // Setting the qelem when it is already set does nothing, so however many calls are waiting they are all run by one callback.
+
+        void defer_message(message_base* a_message, const atoms& args, const int inlet) {
+            assert(m_deferred_calls);    // created by the message, which can defer
+
+            if (m_deferred_calls->queue.try_enqueue({ a_message, args, inlet }))
+                max::qelem_set(m_deferred_calls->qelem);
+        }
+
+
+        // Called on the main thread when the qelem is serviced.
+        // Only the calls already waiting are run, so that a thread that keeps calling cannot hold up the main thread.
+
+        static void deferred_messages_qfn(object_base* self) {
+            auto&            calls = *self->m_deferred_calls;
+            auto             count = calls.queue.size_approx();
+            deferred_message m;
+
+            while (count-- && calls.queue.try_dequeue(m))
+                m.call();
+
+            if (calls.queue.size_approx())
+                max::qelem_set(calls.qelem);
+        }
+
+
         // Called by the min::argument to add an argument to the object.
 
         void register_argument(argument_base* arg) {
             m_arguments.push_back(arg);
         }
 
+
+        // Called by the min::message to add a message to the object.
+        // A message registered with the name of an existing message replaces it in its slot.
+        // Returns the slot of the message.
+
+        size_t register_message(const std::string& name, message_base* a_message) {
+            return register_component(m_registry.messages, m_message_slots, name, a_message);
+        }
+
+
+#ifdef C74_MIN_WITH_PROFILING
+        // Called by the min::message to find where its calls are counted.
+
+        message_profile* profile_message(const size_t slot) {
+            return &m_registry.profile.message(slot);
+        }
+#endif
+
+
+        // Called by the min::attribute to add an attribute to the object.
+
+        void register_attribute(const std::string& name, attribute_base* an_attribute) {
+            register_component(m_registry.attributes, m_attribute_slots, name, an_attribute);
+        }
+
+
+        // The first instance of a class adds the names of its components to the registry.
+        // Later instances find the names already there, and only need to size their slots once.
+
+        template<class component_type>
+        static size_t register_component(component_registry& a_registry, std::vector<component_type*>& slots, const std::string& name, component_type* a_component) {
+            const auto slot = a_registry.add(name);
+
+            if (slot >= slots.size()) {
+                slots.reserve(a_registry.size());
+                slots.resize(slot + 1, nullptr);
+            }
+            slots[slot] = a_component;
+            return slot;
+        }
+
     public:
         // DO NOT USE
         // Intended to be private but made public to avoid excessive contortions required to make min_ctor<> a friend function
@@ -111,36 +111,220 @@ namespace c74::min {
     }
 
 
+    // Each message that is bound to one of the wrapper methods below is resolved to its slot when the class is set up.
+    // The hot path is then an indexed load from the object's message_slots() rather than constructing a string,
+    // hashing it, and probing the messages() map for every incoming int, float or bang.
+
+    template<class min_class_type, class message_name_type>
+    struct wrapper_message_slot {
+        static inline size_t         index { std::numeric_limits<size_t>::max() };
+        static inline max::t_symbol* name { nullptr };
+
+        static void resolve(const message_base& a_message) {
+            index = a_message.slot();
+            name  = a_message.name();
+        }
+    };
+
+
+    // Find the message bound to a wrapper method.
+    // The name of the message in the slot is checked (a pointer comparison) so that an instance whose messages
+    // differ from those of the dummy instance used at class setup still finds the correct message.
+    // Returns nullptr if the object has no message with this name.
+
+    template<class min_class_type, class message_name_type>
+    message_base* wrapper_find_message(minwrap<min_class_type>* self) {
+        using slot        = wrapper_message_slot<min_class_type, message_name_type>;
+        const auto& slots = self->m_min_object.message_slots();
+
+        if (slot::index < slots.size() && slots[slot::index] && static_cast<max::t_symbol*>(slots[slot::index]->name()) == slot::name)
+            return slots[slot::index];
+
+        const auto& messages = self->m_min_object.messages();
+        auto        found    = messages.find(message_name_type::name);
+        return found != messages.end() ? found->second : nullptr;
+    }
+
+
+    // A perfect hash table from the names of a class's messages to their slots.
+    // It is built once when the class is set up and shared by all instances of the class.
+    // Messages that arrive with a t_symbol* are found by hashing the pointer, which Max interns, so no string is touched.
+    // Messages that arrive with only a c-string (e.g. ellipsis messages) are found by their Murmur3 hash().
+    // The multipliers are searched at setup until no two names share a bucket, so a lookup is one hash and one compare.
+
+    class message_table {
+    public:
+        static constexpr size_t npos { std::numeric_limits<size_t>::max() };
+
+
+        void build(const std::vector<message_base*>& slots) {
+            std::vector<entry> entries;
+
+            for (auto i = 0u; i < slots.size(); ++i) {
+                if (!slots[i])
+                    continue;
+                const auto name = static_cast<max::t_symbol*>(slots[i]->name());
+                entries.push_back({ name, hash(name->s_name), i });
+            }
+
+            m_symbol_multiplier = search(entries, m_by_symbol, m_symbol_shift, [](const entry& e, const uint64_t multiplier) {
+                return reinterpret_cast<uintptr_t>(e.name) * multiplier;
+            });
+            m_hash_multiplier = search(entries, m_by_hash, m_hash_shift, [](const entry& e, const uint64_t multiplier) {
+                return static_cast<uint64_t>(e.hash) * multiplier;
+            });
+        }
+
+
+        // Return the slot of the message with this name, or npos if the class has no such message.
+
+        size_t find(const max::t_symbol* name) const {
+            if (m_by_symbol.empty())
+                return npos;
+
+            const auto& e = m_by_symbol[(reinterpret_cast<uintptr_t>(name) * m_symbol_multiplier) >> m_symbol_shift];
+            return e.name == name ? e.slot : npos;
+        }
+
+
+        // Return the slot of the message with this name, or npos if the class has no such message.
+
+        size_t find(const char* name) const {
+            if (m_by_hash.empty())
+                return npos;
+
+            const auto  h = hash(name);
+            const auto& e = m_by_hash[(static_cast<uint64_t>(h) * m_hash_multiplier) >> m_hash_shift];
+            return e.name && e.hash == h && !strcmp(e.name->s_name, name) ? e.slot : npos;
+        }
+
+    private:
+        struct entry {
+            const max::t_symbol* name { nullptr };
+            uint32_t             hash {};
+            size_t               slot { npos };
+        };
+
+        static constexpr unsigned k_max_bits { 16 };
+
+        std::vector<entry> m_by_symbol;
+        std::vector<entry> m_by_hash;
+        uint64_t           m_symbol_multiplier {};
+        uint64_t           m_hash_multiplier {};
+        unsigned           m_symbol_shift { 63 };
+        unsigned           m_hash_shift { 63 };
+
+
+        // Find an odd multiplier that places every entry in its own bucket of a table with a power-of-two size,
+        // doubling the size of the table whenever a few dozen multipliers have been tried without success.
+        // The bucket of an entry is taken from the high bits of the product, which are the best mixed.
+        // Two names with the same hash can never be separated, in which case the table is left empty
+        // and every lookup falls back to the messages() map.
+
+        template<class hash_function_type>
+        static uint64_t search(const std::vector<entry>& entries, std::vector<entry>& table, unsigned& shift, hash_function_type&& hash_function) {
+            unsigned bits { 1 };
+            while ((size_t(1) << bits) < entries.size() * 2)
+                ++bits;
+
+            uint64_t multiplier { 0x9E3779B97F4A7C15ull };
+
+            while (true) {
+                for (auto attempt = 0; attempt < 32; ++attempt) {
+                    table.assign(size_t(1) << bits, entry {});
+                    shift = 64 - bits;
+
+                    bool collision { false };
+                    for (const auto& e : entries) {
+                        auto& bucket = table[hash_function(e, multiplier) >> shift];
+                        if (bucket.name) {
+                            collision = true;
+                            break;
+                        }
+                        bucket = e;
+                    }
+                    if (!collision)
+                        return multiplier;
+
+                    multiplier = multiplier * 6364136223846793005ull + 1442695040888963407ull;
+                    multiplier |= 1;
+                }
+                if (++bits > k_max_bits) {
+                    table.clear();
+                    return 0;
+                }
+            }
+        }
+    };
+
+
+    template<class min_class_type>
+    struct wrapper_message_table {
+        static inline message_table table;
+    };
+
+
+    // Find a message by the name with which it was sent.
+    // The slot from the class's table is checked against the name of the message in that slot (a pointer comparison)
+    // so that an instance whose messages differ from those of the dummy instance used at class setup still finds the correct message.
+    // Returns nullptr if the object has no message with this name.
+
+    template<class min_class_type>
+    message_base* wrapper_find_message(minwrap<min_class_type>* self, const max::t_symbol* name) {
+        const auto  index = wrapper_message_table<min_class_type>::table.find(name);
+        const auto& slots = self->m_min_object.message_slots();
+
+        if (index < slots.size() && slots[index] && static_cast<max::t_symbol*>(slots[index]->name()) == name)
+            return slots[index];
+
+        const auto& messages = self->m_min_object.messages();
+        auto        found    = messages.find(name->s_name);
+        return found != messages.end() ? found->second : nullptr;
+    }
+
+
+    template<class min_class_type>
+    message_base* wrapper_find_message(minwrap<min_class_type>* self, const char* name) {
+        const auto  index = wrapper_message_table<min_class_type>::table.find(name);
+        const auto& slots = self->m_min_object.message_slots();
+
+        if (index < slots.size() && slots[index] && !strcmp(slots[index]->name().c_str(), name))
+            return slots[index];
+
+        const auto& messages = self->m_min_object.messages();
+        auto        found    = messages.find(name);
+        return found != messages.end() ? found->second : nullptr;
+    }
+
+
     template<class min_class_type, class message_name_type>
     void wrapper_method_zero(max::t_object* o) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[message_name_type::name];
+        auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
 
-        meth();
+        meth.dispatch_bang();
     }
 
     template<class min_class_type, class message_name_type>
     void wrapper_method_int(max::t_object* o, const max::t_atom_long v) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[message_name_type::name];
-        atoms as   = {v};
+        auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
 
-        meth(as);
+        meth.dispatch_int(v);
     }
 
     template<class min_class_type, class message_name_type>
     void wrapper_method_float(max::t_object* o, const double v) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[message_name_type::name];
-        atoms as   = {v};
+        auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
 
-        meth(as);
+        meth.dispatch_float(v);
     }
 
     template<class min_class_type, class message_name_type>
     void wrapper_method_symbol(max::t_object* o, const max::t_symbol* v) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[message_name_type::name];
+        auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
         atoms as   = {symbol(v)};
 
         meth(as);
@@ -149,28 +333,24 @@ namespace c74::min {
     template<class min_class_type, class message_name_type>
     void wrapper_method_anything(max::t_object* o, const max::t_symbol* s, const long ac, const max::t_atom* av) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[message_name_type::name];
-        atoms as(ac + 1L);
+        auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
 
-        as[0] = s;
-        for (long i = 0; i < ac; ++i)
-            as[i + 1L] = av[i];
-        meth(as);
+        meth.dispatch_anything(s, atom_reference(ac, av));
     }
 
     template<class min_class_type, class message_name_type>
     void wrapper_method_ptr(max::t_object* o, const void* v) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[message_name_type::name];
+        auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
         atoms as   = {v};
 
         meth(as);
     }
 
-    template<class min_class_type>
+    template<class min_class_type, class message_name_type>
     void wrapper_method_savestate(max::t_object* o, const max::t_dictionary* d) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()["savestate"];
+        auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
         atoms as   = {d};
         meth(as);
     }
@@ -178,7 +358,7 @@ namespace c74::min {
     template<class min_class_type, class message_name_type>
     void wrapper_method_self_ptr(max::t_object* o, const void* arg1) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[message_name_type::name];
+        auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
         atoms as{o, arg1};
 
         meth(as);
@@ -192,7 +372,7 @@ namespace c74::min {
         if ( self->m_min_object.messages().empty() )
             return 0;
         else {
-            auto& meth = *self->m_min_object.messages()[message_name_type::name];
+            auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
             atoms as{arg1};
             atoms r = meth(as);
             return r[0];
@@ -204,7 +384,7 @@ namespace c74::min {
         if (is_base_of<ui_operator_base, min_class_type>::value) {
             auto  self = wrapper_find_self<min_class_type>(o);
             auto& ui_op = const_cast<ui_operator_base&>(dynamic_cast<const ui_operator_base&>(self->m_min_object));
-            auto& meth = *self->m_min_object.messages()[message_name_type::name];
+            auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
             atoms as{ o, arg1 };
 
             ui_op.update_colors();
@@ -217,7 +397,7 @@ namespace c74::min {
     template<class min_class_type, class message_name_type>
     void wrapper_method_mouse(max::t_object* o, max::t_object* a_patcherview, const max::t_pt position, const max::t_atom_long modifiers) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[message_name_type::name];
+        auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
         max::t_mouseevent an_event {};
 
         an_event.type = max::eMouseEvent;
@@ -240,21 +420,7 @@ namespace c74::min {
     template<class min_class_type, class message_name_type>
     void wrapper_method_multitouch(max::t_object* o, max::t_object* a_patcherview, const max::t_mouseevent* an_event) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto  name = message_name_type::name;
-
-        if (name == "mt_mouseenter")
-            name = "mouseenter";
-        else if (name == "mt_mouseleave")
-            name = "mouseleave";
-        else if (name == "mt_mousedown")
-            name = "mousedown";
-        else if (name == "mt_mouseup")
-            name = "mouseup";
-        else if (name == "mt_mousemove")
-            name = "mousemove";
-        else if (name == "mt_mousedrag")
-            name = "mousedrag";
-        auto& meth = *self->m_min_object.messages()[name];
+        auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);    // registered with its "mt_" name
 
         event e { o, a_patcherview, *an_event };
         atoms as { e };
@@ -267,8 +433,8 @@ namespace c74::min {
         auto  self = wrapper_find_self<min_class_type>(o);
 
         // This supports notify methods for UI objects which don't actually have a notify method member in the min class
-        if (self->m_min_object.messages().find(message_name_type::name) != self->m_min_object.messages().end()) {
-            auto& meth = *self->m_min_object.messages()[message_name_type::name];
+        if (auto found_meth = wrapper_find_message<min_class_type, message_name_type>(self)) {
+            auto& meth = *found_meth;
             atoms as{o, s1, s2, p1, p2};    // NOTE: self could be the jitter object rather than the max object -- so we pass `o` which is
                                             // always the correct `self` for box operations
             auto ret = meth(as);
@@ -294,7 +460,7 @@ namespace c74::min {
     template<class min_class_type, class message_name_type>
     void wrapper_method_self_ptr_long_ptr_long_ptr_long(max::t_object* o, const void* arg1, const max::t_atom_long arg2, const max::t_atom_long* arg3, const max::t_atom_long arg4, const max::t_atom_long* arg5, const max::t_atom_long arg6) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[message_name_type::name];
+        auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
         atoms as {o, arg1, arg2, arg3, arg4, arg5, arg6};   // NOTE: self could be the jitter object rather than the max object -- so we
                                                             // pass `o` which is always the correct `self` for box operations
         meth(as);
@@ -304,7 +470,7 @@ namespace c74::min {
     template<class min_class_type, class message_name_type>
     max::t_atom_long wrapper_method_self_ptr_long_long_long(max::t_object* o, const void* arg1, const max::t_atom_long arg2, const max::t_atom_long arg3, const max::t_atom_long arg4) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[message_name_type::name];
+        auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
         atoms as {o, arg1, arg2, arg3, arg4};   // NOTE: self could be the jitter object rather than the max object -- so we
                                                 // pass `o` which is always the correct `self` for box operations
         auto return_value = static_cast<max::t_atom_long>(meth(as)[0]);
@@ -314,7 +480,7 @@ namespace c74::min {
     template<class min_class_type, class message_name_type>
     void wrapper_method_getplaystate(max::t_object* o, long* play, double* pos, long* loop) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[message_name_type::name];
+        auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
         atoms as = meth();
 
         assert(as.size() == 3);
@@ -327,7 +493,7 @@ namespace c74::min {
     template<class min_class_type, class message_name_type>
     void wrapper_method_dictionary(max::t_object* o, const max::t_symbol* s) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[message_name_type::name];
+        auto& meth = *wrapper_find_message<min_class_type, message_name_type>(self);
         auto  d    = dictobj_findregistered_retain(const_cast<max::t_symbol*>(s));
         atoms as   = {atom(d)};
 
@@ -338,8 +504,8 @@ namespace c74::min {
 
     template<class min_class_type>
     void wrapper_method_ellipsis(max::t_object* o, void* fun_name, ...) {
-        auto self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[(char *)fun_name];
+        auto  self = wrapper_find_self<min_class_type>(o);
+        auto& meth = *wrapper_find_message(self, static_cast<const char*>(fun_name));
         atoms as;
 
         va_list fun_args;
@@ -357,19 +523,16 @@ namespace c74::min {
     template<class min_class_type>
     void wrapper_method_generic(max::t_object* o, const max::t_symbol* s, const long ac, const max::t_atom* av) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[s->s_name];
-        atoms as(ac);
+        auto& meth = *wrapper_find_message(self, s);
 
-        for (auto i = 0; i < ac; ++i)
-            as[i] = av[i];
-        meth(as);
+        meth.dispatch_atoms(atom_reference(ac, av));
     }
 
     // same as wrapper_method_generic but can return values in an atom (A_GIMMEBACK)
     template<class min_class_type>
     void wrapper_method_generic_typed(max::t_object* o, const max::t_symbol* s, const long ac, const max::t_atom* av, max::t_atom* rv) {
         auto  self = wrapper_find_self<min_class_type>(o);
-        auto& meth = *self->m_min_object.messages()[s->s_name];
+        auto& meth = *wrapper_find_message(self, s);
         atoms as(ac);
 
         for (auto i = 0; i < ac; ++i)
@@ -380,6 +543,101 @@ namespace c74::min {
             *rv = ra[0];
     }
 
+#ifdef C74_MIN_WITH_PROFILING
+
+    // Add the counters of the calls of a message on one thread (or of its deferrals) to a dictionary.
+
+    inline void wrapper_profile_counters_to_dictionary(max::t_dictionary* d, const symbol key, const profile_counters& counters) {
+        if (!counters.count())
+            return;
+
+        auto  entry = max::dictionary_new();
+        atoms histogram(k_profile_histogram_size);
+
+        for (auto i = 0u; i < k_profile_histogram_size; ++i)
+            histogram[i] = static_cast<max::t_atom_long>(counters.histogram(i));
+
+        max::dictionary_appendlong(entry, symbol("calls"), static_cast<max::t_atom_long>(counters.count()));
+        max::dictionary_appendfloat(entry, symbol("total_ms"), counters.total() / 1.0e6);
+        max::dictionary_appendfloat(entry, symbol("mean_us"), counters.total() / 1.0e3 / counters.count());
+        max::dictionary_appendfloat(entry, symbol("longest_us"), counters.longest() / 1.0e3);
+        max::dictionary_appendatoms(entry, symbol("histogram"), static_cast<long>(histogram.size()), histogram.data());
+        max::dictionary_appenddictionary(d, key, reinterpret_cast<max::t_object*>(entry));
+    }
+
+
+    // Respond to the "minprofile" message, which every class has when Min is compiled with C74_MIN_WITH_PROFILING defined.
+    // Writes the profile of the class's messages to the dictionary named by the argument, or to "minprofile_<classname>".
+    // The histograms count calls taking less than 1, 2, 4, ... microseconds.
+
+    template<class min_class_type>
+    void wrapper_method_minprofile(max::t_object* o, const max::t_symbol* s, const long ac, const max::t_atom* av) {
+        auto        self     = wrapper_find_self<min_class_type>(o);
+        const auto& instance = self->m_min_object;
+        const auto& profile  = instance.profile();
+        symbol      name     = ac ? symbol(atom(av[0])) : symbol("minprofile_" + std::string(instance.classname().c_str()));
+        dict        d { name };
+        auto        messages = max::dictionary_new();
+
+        d.clear();
+        for (const auto& a_message : instance.messages()) {
+            const auto slot = a_message.second->slot();
+            if (slot >= profile.size())
+                continue;
+
+            const auto& message_profile = profile[slot];
+            auto        entry           = max::dictionary_new();
+
+            wrapper_profile_counters_to_dictionary(entry, "main", message_profile.calls(profile_thread::main));
+            wrapper_profile_counters_to_dictionary(entry, "scheduler", message_profile.calls(profile_thread::scheduler));
+            wrapper_profile_counters_to_dictionary(entry, "other", message_profile.calls(profile_thread::other));
+            wrapper_profile_counters_to_dictionary(entry, "deferred", message_profile.deferrals());
+            max::dictionary_appenddictionary(messages, symbol(a_message.first), reinterpret_cast<max::t_object*>(entry));
+        }
+
+        max::dictionary_appendsym(d.instance(), symbol("class"), instance.classname());
+        max::dictionary_appenddictionary(d.instance(), symbol("messages"), reinterpret_cast<max::t_object*>(messages));
+        d.touch();
+        max::object_post(o, "profile written to dictionary %s", name.c_str());
+    }
+
+
+    // Respond to the "dspload" message, which every audio class has when Min is compiled with C74_MIN_WITH_PROFILING defined.
+    // Writes the time taken by this instance's perform routine to the dictionary named by the argument, or to "dspload_<classname>".
+    // The loads are fractions of the duration of a vector, so a load above 1.0 missed the audio deadline on its own.
+
+    template<class min_class_type>
+    void wrapper_method_dspload(max::t_object* o, const max::t_symbol* s, const long ac, const max::t_atom* av) {
+        auto        self     = wrapper_find_self<min_class_type>(o);
+        const auto& instance = self->m_min_object;
+        const auto& load     = self->m_dsp_load;
+        symbol      name     = ac ? symbol(atom(av[0])) : symbol("dspload_" + std::string(instance.classname().c_str()));
+        dict        d { name };
+
+        d.clear();
+        max::dictionary_appendsym(d.instance(), symbol("class"), instance.classname());
+        wrapper_profile_counters_to_dictionary(d.instance(), "vectors", load.vectors());
+        max::dictionary_appendlong(d.instance(), symbol("frames"), static_cast<max::t_atom_long>(load.frames()));
+        if (load.frames())
+            max::dictionary_appendfloat(d.instance(), symbol("ns_per_sample"), static_cast<double>(load.vectors().total()) / load.frames());
+        max::dictionary_appendfloat(d.instance(), symbol("recent_load"), load.recent());
+        max::dictionary_appendfloat(d.instance(), symbol("peak_load"), load.peak());
+        d.touch();
+        max::object_post(o, "dsp load written to dictionary %s", name.c_str());
+    }
+
+
+    template<class min_class_type>
+    type_enable_if_audio_class<min_class_type> wrap_as_max_external_dspload(max::t_class* c) {
+        max::class_addmethod(c, reinterpret_cast<max::method>(wrapper_method_dspload<min_class_type>), "dspload", max::A_GIMME, 0);
+    }
+
+    template<class min_class_type>
+    type_enable_if_not_audio_class<min_class_type> wrap_as_max_external_dspload(max::t_class*) {}
+
+#endif    // C74_MIN_WITH_PROFILING
+
+
     template<class min_class_type>
     max::t_max_err wrapper_method_getvalueof(max::t_object* o, long* ac, max::t_atom** av) {
         return max::object_attr_getvalueof(o, k_sym_value, ac, av);
@@ -476,12 +734,15 @@ namespace c74::min {
     MIN_WRAPPER_CREATE_TYPE_FROM_STRING(oksize)
     MIN_WRAPPER_CREATE_TYPE_FROM_STRING(paint)
     MIN_WRAPPER_CREATE_TYPE_FROM_STRING(patchlineupdate)
+    MIN_WRAPPER_CREATE_TYPE_FROM_STRING(savestate)
 
 
     // Simplify the meth switches in the following code to reduce excessive and tedious code duplication
+    // Each message is also resolved to its slot so that the wrapper method doesn't need to look it up by name.
 
     #define MIN_WRAPPER_ADDMETHOD(c, methname, wrappermethod, methtype)                                                                    \
     if (a_message.first == #methname) {                                                                                                    \
+        wrapper_message_slot<min_class_type, wrapper_message_name_##methname>::resolve(*a_message.second);                                 \
         max::class_addmethod(c,                                                                                                            \
             reinterpret_cast<max::method>(wrapper_method_##wrappermethod<min_class_type, wrapper_message_name_##methname>), #methname,     \
             max::methtype, 0);                                                                                                             \
@@ -509,6 +770,8 @@ namespace c74::min {
 
         // messages
 
+        wrapper_message_table<min_class_type>::table.build(instance.message_slots());
+
         for (auto& a_message : instance.messages()) {
             MIN_WRAPPER_ADDMETHOD(c, bang, zero, A_NOTHING)
             else MIN_WRAPPER_ADDMETHOD(c, dblclick, zero, A_CANT)
@@ -547,8 +810,10 @@ namespace c74::min {
                 max::class_addmethod(c, reinterpret_cast<method>(wrapper_method_ellipsis<min_class_type>), a_message.first.c_str(), max::A_CANT, 0);
             else if (a_message.first == "dspsetup");    // skip -- handle it in operator classes
             else if (a_message.first == "maxclass_setup");          // for min class construction only, do not add for exposure to max
-            else if (a_message.first == "savestate")
-                max::class_addmethod(c, reinterpret_cast<max::method>(wrapper_method_savestate<min_class_type>), "appendtodictionary", max::A_CANT, 0);
+            else if (a_message.first == "savestate") {
+                wrapper_message_slot<min_class_type, wrapper_message_name_savestate>::resolve(*a_message.second);
+                max::class_addmethod(c, reinterpret_cast<max::method>(wrapper_method_savestate<min_class_type, wrapper_message_name_savestate>), "appendtodictionary", max::A_CANT, 0);
+            }
             else {
               if (a_message.second->type() == max::A_GIMMEBACK) {
                 max::class_addmethod(c, reinterpret_cast<method>(wrapper_method_generic_typed<min_class_type>),
@@ -566,6 +831,11 @@ namespace c74::min {
             }
         }
 
+#ifdef C74_MIN_WITH_PROFILING
+        max::class_addmethod(c, reinterpret_cast<method>(wrapper_method_minprofile<min_class_type>), "minprofile", max::A_GIMME, 0);
+        wrap_as_max_external_dspload<min_class_type>(c);
+#endif
+
         // attributes
 
         for (auto& an_attribute : instance.attributes()) {
@@ -804,6 +1074,8 @@ namespace c74::min {
 
         // add special messages to max class, and object messages to jitter class
         // must happen pror to max_jit_class_wrap_standard call
+        wrapper_message_table<min_class_type>::table.build(instance->message_slots());
+
         for (auto& a_message : instance->messages()) {
             MIN_WRAPPER_ADDMETHOD(c, bang, zero, A_NOTHING)
             else MIN_WRAPPER_ADDMETHOD(c, dblclick, zero, A_CANT)
@@ -834,8 +1106,10 @@ namespace c74::min {
             else MIN_WRAPPER_ADDMETHOD(c, oksize, oksize, A_CANT)
             else MIN_WRAPPER_ADDMETHOD(c, mousedragdelta, mouse, A_CANT)
             else MIN_WRAPPER_ADDMETHOD(c, mousedoubleclick, mouse, A_CANT)
-            else if (a_message.first == "savestate")
-                max::class_addmethod(c, reinterpret_cast<max::method>(wrapper_method_savestate<min_class_type>), "appendtodictionary", max::A_CANT, 0);
+            else if (a_message.first == "savestate") {
+                wrapper_message_slot<min_class_type, wrapper_message_name_savestate>::resolve(*a_message.second);
+                max::class_addmethod(c, reinterpret_cast<max::method>(wrapper_method_savestate<min_class_type, wrapper_message_name_savestate>), "appendtodictionary", max::A_CANT, 0);
+            }
             else if (a_message.first == "dspsetup");          // skip -- handle it in operator classes
             else if (a_message.first == "maxclass_setup");    // for min class construction only, do not add for exposure to max
             else if (a_message.first == "jitclass_setup");    // for min class construction only, do not add for exposure to max
@@ -10,7 +10,7 @@ namespace c74::min {
 
     /// The base class for all template specializations of sample_operator.
 
-    class mc_operator_base {};
+    class mc_operator_base : public smoother_host {};
 
 
     /// Inheriting from sample_operator extends your class functionality to processing audio
@@ -88,6 +88,95 @@ namespace c74::min {
         vector<std::pair<int,attribute_base*>> m_attributes_mapped_to_inlets;
     };
 
+
+
+    /// The base class for all template specializations of mc_parallel.
+
+    class mc_parallel_base {};
+
+
+    /// Inheriting from mc_parallel, together with mc_operator, spreads the processing of an object's output channels
+    /// across the threads of the shared #worker_pool.
+    /// Use it when the work for each channel is independent of the work for the others, as in a bank of filters.
+    ///
+    /// The output channels are divided into groups, and your call operator is called once for each group,
+    /// possibly on different threads at the same time.
+    /// It takes the whole input, the group's output channels, and the index of the group's first output channel:
+    /// @code
+    /// void operator()(audio_bundle input, audio_bundle output, size_t first_channel);
+    /// @endcode
+    /// With fewer output channels than minimum_channel_count, or when the pool is busy, it is called once with all of them
+    /// on the audio thread, so that small objects do not pay the cost of waking up the workers.
+    ///
+    /// @tparam channels_per_job		The number of output channels in each group.
+    /// @tparam minimum_channel_count	The smallest number of output channels to spread across threads.
+
+    template<size_t channels_per_job = 4, size_t minimum_channel_count = 16>
+    class mc_parallel : public mc_parallel_base {
+    public:
+        static_assert(channels_per_job > 0, "each job must process at least one channel");
+
+        static constexpr size_t k_channels_per_job { channels_per_job };
+        static constexpr size_t k_minimum_channel_count { minimum_channel_count };
+
+
+        /// Default constructor.
+        /// Starts the shared worker pool, if no other object has, because this runs on the main thread.
+
+        mc_parallel()
+        : m_pool { worker_pool::shared() }
+        {}
+
+
+        /// Constructor for classes that run their channels in a pool of their own.
+        /// @param	a_pool	The pool, which must outlive the object.
+
+        explicit mc_parallel(worker_pool& a_pool)
+        : m_pool { a_pool }
+        {}
+
+
+        /// The pool that runs the groups of channels.
+        /// @return	The pool.
+
+        worker_pool& pool() {
+            return m_pool;
+        }
+
+    private:
+        worker_pool& m_pool;
+    };
+
+
+    // The performer for classes that spread their channels across the worker pool.
+    // The generic performer for vector_operator and mc_operator classes is in c74_min_operator_vector.h
+
+    template<class min_class_type>
+    class performer<min_class_type, typename enable_if<is_base_of<mc_parallel_base, min_class_type>::value>::type> {
+    public:
+        static void perform(minwrap<min_class_type>* self, max::t_object* dsp64, double** in_chans, const long numins, double** out_chans, const long numouts, const long sampleframes, const long, const void*) {
+            constexpr auto channels_per_job { min_class_type::k_channels_per_job };
+
+            auto&        instance { self->m_min_object };
+            audio_bundle input { in_chans, numins, sampleframes };
+            const auto   channel_count { static_cast<size_t>(numouts) };
+
+            instance.advance_smoothers(sampleframes);
+
+            auto job = [&](const size_t index) {
+                const auto   first_channel { index * channels_per_job };
+                audio_bundle output { out_chans + first_channel, static_cast<long>(std::min(channels_per_job, channel_count - first_channel)), sampleframes };
+                instance(input, output, first_channel);
+            };
+
+            const auto job_count { (channel_count + channels_per_job - 1) / channels_per_job };
+
+            if (channel_count < min_class_type::k_minimum_channel_count || job_count < 2 || !instance.pool().run(job_count, job))
+                instance(input, audio_bundle { out_chans, numouts, sampleframes }, 0);
+        }
+    };
+
+
     template<class min_class_type, enable_if_mc_operator<min_class_type> = 0>
     void min_dsp64_attrmap(minwrap<min_class_type>* self, const short* count) {}
 
@@ -10,7 +10,76 @@ namespace c74::min {
 
     /// The base class for all template specializations of sample_operator.
 
-    class sample_operator_base {};
+    class sample_operator_base : public smoother_host {};
+
+
+    /// The attributes of a sample_operator that are mapped to audio inlets with a signal connection, which are set from every sample.
+    /// Numeric attributes are written directly, neither allocating nor boxing the samples in atoms.
+    /// Others, such as those with a setter function, are set through atoms that are allocated when the mapping is made,
+    /// so their setter is still called for every sample.
+    /// Inlets without a signal connection are not mapped, so their attributes keep the values set by messages.
+    /// Mappings are made when the dsp chain is compiled, after which writing them is real-time safe.
+
+    class attribute_inlet_mappings {
+    public:
+        /// Remove all mappings.
+
+        void clear() {
+            m_mappings.clear();
+        }
+
+
+        /// Map an attribute to an audio inlet.
+        /// @param	an_inlet		The zero-based index of the audio inlet.
+        /// @param	an_attribute	The attribute to set from the inlet's samples.
+
+        void add(const int an_inlet, attribute_base* an_attribute) {
+            m_mappings.push_back({ an_inlet, an_attribute->sample_writer(), an_attribute, { 0.0 } });
+        }
+
+
+        /// Are there no mappings?
+
+        bool empty() const {
+            return m_mappings.empty();
+        }
+
+
+        /// Are there mappings written from every sample?
+
+        bool per_sample() const {
+            return !m_mappings.empty();
+        }
+
+
+        /// Write the attributes from one sample of their inlets.
+        /// Inputs that are null, such as those of inlets without channels, are skipped, so their attributes keep their values.
+        /// @param	in_chans	The audio inputs of the vector.
+        /// @param	index		The index of the sample in the vector.
+
+        void write_sample(const double** in_chans, const size_t index) {
+            for (auto& mapping : m_mappings) {
+                if (!in_chans[mapping.inlet])
+                    continue;
+                if (mapping.writer)
+                    mapping.writer(in_chans[mapping.inlet][index]);
+                else {
+                    mapping.value[0] = in_chans[mapping.inlet][index];
+                    mapping.attribute->set(mapping.value, false, false);
+                }
+            }
+        }
+
+    private:
+        struct mapping {
+            int                     inlet;
+            attribute_sample_writer writer;       // empty if the attribute must be set with atoms
+            attribute_base*         attribute;
+            atoms                   value;        // the atoms it is set with
+        };
+
+        vector<mapping> m_mappings;
+    };
 
 
     /// Inheriting from sample_operator extends your class functionality to processing audio
@@ -109,7 +178,188 @@ namespace c74::min {
         double m_samplerate {c74::max::sys_getsr()};    // initialized to the global samplerate, but updated to the local samplerate when the
                                                        // dsp chain is compiled.
         int m_vector_size {c74::max::sys_getblksize()};    // ...
-        vector<std::pair<int,attribute_base*>> m_attributes_mapped_to_inlets;
+        attribute_inlet_mappings m_attributes_mapped_to_inlets;
+    };
+
+
+    /// The base class for all template specializations of sample_lanes.
+
+    class sample_lanes_base {};
+
+
+    /// Inherit from sample_lanes in addition to sample_operator to have your call operator called with a sample_batch
+    /// of lane_count consecutive samples from each inlet, rather than a single sample, for most of each vector.
+    /// Samples left over at the end of a vector that is not a multiple of lane_count are processed one at a time,
+    /// so your call operator must accept both, which is simplest as a template:
+    /// @code
+    /// class gain : public object<gain>, public sample_operator<1, 1>, public sample_lanes<4> {
+    /// public:
+    ///     template<class T>
+    ///     T operator()(T input) {
+    ///         return input * m_gain;
+    ///     }
+    /// };
+    /// @endcode
+    ///
+    /// With several outputs the call operator returns `sample_batches<output_count, lane_count>` for a batch
+    /// and `samples<output_count>` for a single sample.
+    /// The lanes are processed together, so this suits operators whose output for one sample does not depend on the previous sample.
+    /// Objects with audio inlets mapped to numeric attributes are processed one sample at a time, because the attributes are written from every sample.
+    ///
+    /// @tparam lane_count_param	The number of samples in a batch, typically 4 or 8.
+
+    template<size_t lane_count_param>
+    class sample_lanes : public sample_lanes_base {
+    public:
+        /// Return the number of samples in a batch.
+        /// @return The number of samples in a batch.
+
+        static constexpr size_t lane_count() {
+            return lane_count_param;
+        }
+    };
+
+
+    /// The value returned by the call operator of a sample_lanes class with more than one output.
+
+    template<size_t count, size_t lane_count>
+    using sample_batches = std::array<sample_batch<lane_count>, count>;
+
+
+    /// The base class for all template specializations of mc_lanes.
+    /// It keeps the number of channels connected to each inlet, which Max reports when the connections change.
+    /// The counts are written on the main thread and read by the performer on the audio thread,
+    /// so they are atomic and kept in storage that is sized once, when the object is created, and never resized.
+
+    class mc_lanes_base {
+    public:
+
+        /// Return the number of channels processed, which is the most connected to any inlet.
+        /// Each outlet has this many channels.
+        /// @return The number of channels.
+
+        size_t channel_count() const {
+            return m_channel_count.load(std::memory_order_acquire);
+        }
+
+
+        ///	Make room for the channel counts of the inlets, each of which starts with one channel.
+        /// You will not typically have any need to call this.
+        /// It is called internally, once, when the object is created and before any audio is processed.
+        /// @param	an_inlet_count	The number of inputs of the sample_operator.
+
+        void input_channel_counts(const size_t an_inlet_count) {
+            m_inlet_count          = an_inlet_count;
+            m_input_channel_counts = std::make_unique<std::atomic<size_t>[]>(an_inlet_count);
+            for (auto inlet = 0u; inlet < an_inlet_count; ++inlet)
+                m_input_channel_counts[inlet].store(1, std::memory_order_relaxed);
+        }
+
+
+        ///	Set the number of channels connected to an inlet.
+        /// You will not typically have any need to call this.
+        /// It is called internally when Max reports a change to the connections of an inlet.
+        /// @param	an_inlet	The zero-based index of the inlet.
+        /// @param	a_count		The number of channels connected to it.
+        /// @return				True if the number of channels processed has changed.
+
+        bool input_channel_count(const size_t an_inlet, const size_t a_count) {
+            if (an_inlet >= m_inlet_count)
+                return false;
+            m_input_channel_counts[an_inlet].store(a_count, std::memory_order_relaxed);
+
+            size_t count { 1 };
+            for (auto inlet = 0u; inlet < m_inlet_count; ++inlet)
+                count = std::max(count, m_input_channel_counts[inlet].load(std::memory_order_relaxed));
+            return m_channel_count.exchange(count, std::memory_order_acq_rel) != count;
+        }
+
+
+        /// Return the number of channels connected to an inlet.
+        /// @param	an_inlet	The zero-based index of the inlet.
+        /// @return				The number of channels connected to it.
+
+        size_t input_channel_count(const size_t an_inlet) const {
+            return an_inlet < m_inlet_count ? m_input_channel_counts[an_inlet].load(std::memory_order_relaxed) : 1;
+        }
+
+
+        /// Return the index of the group of channels that the call operator is processing.
+        /// Use it to find the state of those channels.
+        /// @return The index of the group, from 0 up to the number of groups.
+
+        size_t group() const {
+            return m_group;
+        }
+
+
+        ///	Set the index of the group of channels being processed.
+        /// You will not typically have any need to call this.
+        /// It is called internally before the call operator is called for a group.
+        /// @param	a_group	The index of the group.
+
+        void group(const size_t a_group) {
+            m_group = a_group;
+        }
+
+    private:
+        std::unique_ptr<std::atomic<size_t>[]> m_input_channel_counts;
+        size_t                                 m_inlet_count {};
+        std::atomic<size_t>                    m_channel_count { 1 };
+        size_t                                 m_group {};
+    };
+
+
+    /// Inherit from mc_lanes in addition to sample_operator to process all of the channels of multichannel connections
+    /// in a single instance, rather than in an instance for each channel.
+    /// Your call operator is called for each sample with a sample_batch holding lane_count channels, one per lane,
+    /// and keeps the state of each channel in the matching lane of a sample_batch of its own.
+    /// Filters and other operators whose output depends on the previous samples thus run lane_count channels in one pass.
+    ///
+    /// The channels are processed in groups of lane_count, and group() returns the index of the group being processed,
+    /// so that the state is stored as a vector with one batch for each group:
+    /// @code
+    /// class lowpass : public object<lowpass>, public sample_operator<1, 1>, public mc_lanes<4> {
+    /// public:
+    ///     message<> dspsetup { this, "dspsetup", MIN_FUNCTION {
+    ///         m_history.assign(group_count(), {});
+    ///         return {};
+    ///     }};
+    ///
+    ///     sample_batch<4> operator()(sample_batch<4> input) {
+    ///         auto& history { m_history[group()] };
+    ///         history = input * 0.1 + history * 0.9;
+    ///         return history;
+    ///     }
+    ///
+    /// private:
+    ///     vector<sample_batch<4>> m_history;
+    /// };
+    /// @endcode
+    ///
+    /// Each outlet has channel_count() channels.
+    /// An inlet with fewer channels repeats them, so a single channel applies to every channel, as with Max's mc objects.
+    /// In the last group, lanes past the last channel are given zeroes and their output is discarded.
+    ///
+    /// @tparam lane_count_param	The number of channels in a group, typically 4 or 8.
+
+    template<size_t lane_count_param>
+    class mc_lanes : public mc_lanes_base {
+    public:
+        /// Return the number of channels in a group.
+        /// @return The number of channels in a group.
+
+        static constexpr size_t lane_count() {
+            return lane_count_param;
+        }
+
+
+        /// Return the number of groups of channels, the last of which may not be full.
+        /// @return The number of groups.
+
+        size_t group_count() const {
+            return (channel_count() + lane_count_param - 1) / lane_count_param;
+        }
     };
 
 
@@ -123,7 +373,7 @@ namespace c74::min {
         for (auto i=0; i<inlets.size(); ++i) {
             auto& inlet = inlets[i];
             if (inlet->has_signal_connection() && inlet->has_attribute_mapping())
-                attrs.push_back( { i, inlet->attribute() } );
+                attrs.add(i, inlet->attribute());
         }
     }
 
@@ -177,6 +427,33 @@ namespace c74::min {
     };
 
 
+    // A container of N batches of samples, one for each inlet, that then makes a call to be processed by a sample_operator<> with sample_lanes<>.
+
+    template<class min_class_type, int count, size_t lane_count>
+    struct callable_batches {
+
+        explicit callable_batches(minwrap<min_class_type>* a_self)
+        : self(a_self)
+        {}
+
+        void load(const size_t index, const sample* source) {
+            data[index] = sample_batch<lane_count>::load(source);
+        }
+
+        auto call() {
+            return call(detail::gen_seq<count>());
+        }
+
+        template<int... Is>
+        auto call(detail::seq<Is...>) {
+            return self->m_min_object(data[Is]...);
+        }
+
+        sample_batches<count, lane_count> data;
+        minwrap<min_class_type>*          self;
+    };
+
+
     // version of perform_copy_output() for samples<N> returned by the sample_operator<>'s call operator in the performer below.
 
     template<class min_class_type, typename type_returned_from_call_operator>
@@ -194,6 +471,39 @@ namespace c74::min {
     }
 
 
+    // versions of perform_copy_output() for the batches returned by the call operator of a sample_operator<> with sample_lanes<>.
+
+    template<class min_class_type, size_t count, size_t lane_count>
+    void perform_copy_output(minwrap<min_class_type>* self, const size_t index, double** out_chans, const sample_batches<count, lane_count>& vals) {
+        for (auto chan = 0u; chan < count; ++chan)
+            vals[chan].store(out_chans[chan] + index);
+    }
+
+    template<class min_class_type, size_t lane_count>
+    void perform_copy_output(minwrap<min_class_type>* self, const size_t index, double** out_chans, const sample_batch<lane_count>& val) {
+        val.store(out_chans[0] + index);
+    }
+
+
+    // Make the call to a sample_operator<> with sample_lanes<> and copy its output, of which there may be none.
+
+    template<class min_class_type, size_t output_count = min_class_type::output_count()>
+    struct perform_call {
+        template<class callable_type>
+        static void call(minwrap<min_class_type>* self, callable_type& ins, const size_t index, double** out_chans) {
+            perform_copy_output(self, index, out_chans, ins.call());
+        }
+    };
+
+    template<class min_class_type>
+    struct perform_call<min_class_type, 0> {
+        template<class callable_type>
+        static void call(minwrap<min_class_type>* self, callable_type& ins, const size_t index, double** out_chans) {
+            ins.call();
+        }
+    };
+
+
     // The performer class wraps the C callback routine for a Max audio "perform" method.
     // It adapts the calls coming from the Max application to the call operator implemented in the Min class.
     // The correct version of this enabled using SFINAE template enabling depending on whether this is a
@@ -203,7 +513,10 @@ namespace c74::min {
     // This one is optimized for the most common case: a single input and a single output.
 
     template<class min_class_type>
-    class performer<min_class_type, typename enable_if<is_base_of<sample_operator<1, 1>, min_class_type>::value>::type> {
+    class performer<min_class_type, typename enable_if<is_base_of<sample_operator<1, 1>, min_class_type>::value
+                                                    && !is_base_of<sample_lanes_base, min_class_type>::value
+                                                    && !is_base_of<mc_lanes_base, min_class_type>::value
+                                                    && !is_base_of<oversampled_base, min_class_type>::value>::type> {
     public:
         // The traditional Max audio "perform" callback routine
 
@@ -211,7 +524,11 @@ namespace c74::min {
             auto in_samps  = in_chans[0];
             auto out_samps = out_chans[0];
 
+            self->m_min_object.advance_smoothers(sampleframes);
+
             for (auto i = 0; i < sampleframes; ++i) {
+                self->m_min_object.smoother_frame(i);
+
                 auto in      = in_samps[i];
                 auto out     = self->m_min_object(in);
                 out_samps[i] = out;
@@ -224,14 +541,21 @@ namespace c74::min {
     // This specialization is for a single input with no outputs
 
     template<class min_class_type>
-    class performer<min_class_type, typename enable_if<is_base_of<sample_operator<1, 0>, min_class_type>::value>::type> {
+    class performer<min_class_type, typename enable_if<is_base_of<sample_operator<1, 0>, min_class_type>::value
+                                                    && !is_base_of<sample_lanes_base, min_class_type>::value
+                                                    && !is_base_of<mc_lanes_base, min_class_type>::value
+                                                    && !is_base_of<oversampled_base, min_class_type>::value>::type> {
     public:
         // The traditional Max audio "perform" callback routine
 
         static void perform(minwrap<min_class_type>* self, max::t_object* dsp64, const double** in_chans, const long numins, double** out_chans, const long numouts, const long sampleframes, const long, const void*) {
             auto in_samps = in_chans[0];
 
+            self->m_min_object.advance_smoothers(sampleframes);
+
             for (auto i = 0; i < sampleframes; ++i) {
+                self->m_min_object.smoother_frame(i);
+
                 auto in = in_samps[i];
                 self->m_min_object(in);
             }
@@ -247,19 +571,26 @@ namespace c74::min {
     class performer<min_class_type,
         typename enable_if<is_base_of<sample_operator_base, min_class_type>::value
                         && !is_base_of<sample_operator<1, 1>, min_class_type>::value
-                        && !is_base_of<sample_operator<1, 0>, min_class_type>::value>::type> {
+                        && !is_base_of<sample_operator<1, 0>, min_class_type>::value
+                        && !is_base_of<sample_lanes_base, min_class_type>::value
+                        && !is_base_of<mc_lanes_base, min_class_type>::value
+                        && !is_base_of<oversampled_base, min_class_type>::value>::type> {
     public:
         static void perform(minwrap<min_class_type>* self, max::t_object* dsp64, const double** in_chans, const long numins, double** out_chans, const long numouts, const long sampleframes, const long, const void*) {
             auto& attrs { self->m_min_object.mapped_attributes() };
             const auto input_count { self->m_min_object.input_count() };
 
-            if (attrs.empty()) {
+            self->m_min_object.advance_smoothers(sampleframes);
+
+            if (!attrs.per_sample()) {
 
                 // the typical case:
 
                 for (auto i = 0; i < sampleframes; ++i) {
                     callable_samples<min_class_type, min_class_type::input_count()> ins(self);
 
+                    self->m_min_object.smoother_frame(i);
+
                     for (auto chan = 0; chan < input_count; ++chan)
                         ins.set(chan, in_chans[chan][i]);
 
@@ -276,14 +607,9 @@ namespace c74::min {
                 for (auto i = 0; i < sampleframes; ++i) {
                     callable_samples<min_class_type, min_class_type::input_count()> ins(self);
 
-                    for (auto& inletnum_and_attr : attrs) {
-                        int 			inletnum { inletnum_and_attr.first };
-                        attribute_base*	attr { inletnum_and_attr.second };
-                        auto			value { in_chans[inletnum][i] };
-                        atoms			a {{value}};
+                    self->m_min_object.smoother_frame(i);
 
-                        attr->set(a, false, false);
-                    }
+                    attrs.write_sample(in_chans, i);
 
                     for (auto chan = 0; chan < input_count; ++chan)
                         ins.set(chan, in_chans[chan][i]);
@@ -297,4 +623,187 @@ namespace c74::min {
         }
     };
 
+
+    // The performer class wraps the C callback routine for a Max audio "perform" method.
+    // This is the version for a sample_operator<> with sample_lanes<>, for N inputs and N outputs,
+    // which processes batches of samples and then any samples left over one at a time.
+
+    template<class min_class_type>
+    class performer<min_class_type,
+        typename enable_if<is_base_of<sample_operator_base, min_class_type>::value
+                        && is_base_of<sample_lanes_base, min_class_type>::value
+                        && !is_base_of<mc_lanes_base, min_class_type>::value
+                        && !is_base_of<oversampled_base, min_class_type>::value>::type> {
+    public:
+        static void perform(minwrap<min_class_type>* self, max::t_object* dsp64, const double** in_chans, const long numins, double** out_chans, const long numouts, const long sampleframes, const long, const void*) {
+            constexpr auto input_count { min_class_type::input_count() };
+            constexpr auto lane_count { min_class_type::lane_count() };
+            auto&          attrs { self->m_min_object.mapped_attributes() };
+            const auto     frame_count { static_cast<size_t>(sampleframes) };
+            size_t         i { 0 };
+
+            self->m_min_object.advance_smoothers(sampleframes);
+
+            if (!attrs.per_sample()) {
+                for (; i + lane_count <= frame_count; i += lane_count) {
+                    callable_batches<min_class_type, input_count, lane_count> ins(self);
+
+                    self->m_min_object.smoother_frame(i);
+
+                    for (auto chan = 0u; chan < input_count; ++chan)
+                        ins.load(chan, in_chans[chan] + i);
+
+                    perform_call<min_class_type>::call(self, ins, i, out_chans);
+                }
+            }
+
+            // the samples left over, or all of them when audio inlets are mapped to attributes written from every sample
+
+            for (; i < frame_count; ++i) {
+                callable_samples<min_class_type, input_count> ins(self);
+
+                self->m_min_object.smoother_frame(i);
+
+                attrs.write_sample(in_chans, i);
+
+                for (auto chan = 0u; chan < input_count; ++chan)
+                    ins.set(chan, in_chans[chan][i]);
+
+                perform_call<min_class_type>::call(self, ins, i, out_chans);
+            }
+        }
+    };
+
+
+    // Make the call to a sample_operator<> with mc_lanes<> and keep its output, of which there may be none.
+
+    template<class min_class_type, size_t output_count = min_class_type::output_count()>
+    struct perform_lanes_call {
+        template<class callable_type, size_t lane_count>
+        static void call(callable_type& ins, sample_batches<output_count, lane_count>& outs) {
+            assign(outs, ins.call());
+        }
+
+        template<size_t lane_count>
+        static void assign(sample_batches<output_count, lane_count>& outs, const sample_batch<lane_count>& val) {
+            outs[0] = val;
+        }
+
+        template<size_t lane_count>
+        static void assign(sample_batches<output_count, lane_count>& outs, const sample_batches<output_count, lane_count>& vals) {
+            outs = vals;
+        }
+    };
+
+    template<class min_class_type>
+    struct perform_lanes_call<min_class_type, 0> {
+        template<class callable_type, size_t lane_count>
+        static void call(callable_type& ins, sample_batches<0, lane_count>& outs) {
+            ins.call();
+        }
+    };
+
+
+    // The performer class wraps the C callback routine for a Max audio "perform" method.
+    // This is the version for a sample_operator<> with mc_lanes<>, which processes the channels of multichannel connections
+    // in groups of lane_count, with one channel in each lane.
+    //
+    // Max passes the channels of the first inlet, followed by those of the second and so on, and likewise for the outlets.
+
+    template<class min_class_type>
+    class performer<min_class_type,
+        typename enable_if<is_base_of<sample_operator_base, min_class_type>::value
+                        && is_base_of<mc_lanes_base, min_class_type>::value
+                        && !is_base_of<oversampled_base, min_class_type>::value>::type> {
+    public:
+        static void perform(minwrap<min_class_type>* self, max::t_object* dsp64, const double** in_chans, const long numins, double** out_chans, const long numouts, const long sampleframes, const long, const void*) {
+            constexpr auto input_count { min_class_type::input_count() };
+            constexpr auto output_count { min_class_type::output_count() };
+            constexpr auto lane_count { min_class_type::lane_count() };
+            auto&          instance { self->m_min_object };
+            auto&          attrs { instance.mapped_attributes() };
+            const auto     frame_count { static_cast<size_t>(sampleframes) };
+            const auto     outlet_channels { output_count ? static_cast<size_t>(numouts) / std::max<size_t>(output_count, 1) : 0 };
+            const auto     channel_count { output_count ? std::min(instance.channel_count(), outlet_channels) : instance.channel_count() };
+
+            // Find the channels of each inlet, ignoring counts that do not match the channels Max has passed.
+
+            size_t        input_offsets[input_count + 1] {};
+            size_t        input_channels[input_count + 1] {};
+            const double* first_inputs[input_count + 1] {};
+
+            for (auto inlet = 0u; inlet < input_count; ++inlet) {
+                input_offsets[inlet + 1] = input_offsets[inlet] + instance.input_channel_count(inlet);
+                input_channels[inlet]    = instance.input_channel_count(inlet);
+            }
+            if (input_offsets[input_count] != static_cast<size_t>(numins)) {
+                for (auto inlet = 0u; inlet < input_count; ++inlet) {
+                    input_channels[inlet] = numins / input_count;
+                    input_offsets[inlet]  = inlet * input_channels[inlet];
+                }
+            }
+            // An inlet without channels has no first input, so the attributes mapped to it are left alone.
+            for (auto inlet = 0u; inlet < input_count; ++inlet)
+                first_inputs[inlet] = input_channels[inlet] ? in_chans[input_offsets[inlet]] : nullptr;
+
+            instance.smoother_lanes_are_channels(true);
+            instance.advance_smoothers(sampleframes);
+
+            // Each group of channels is processed in blocks of frames, which are copied into batches and out of them
+            // a channel at a time, so that the copies read and write consecutive samples.
+
+            for (auto first_channel = 0u; first_channel < channel_count; first_channel += lane_count) {
+                const auto    live_lanes { std::min(lane_count, channel_count - first_channel) };
+                const double* lane_inputs[input_count + 1][lane_count] {};
+                double*       lane_outputs[output_count + 1][lane_count] {};
+
+                for (auto inlet = 0u; inlet < input_count; ++inlet) {
+                    for (auto lane = 0u; lane < live_lanes && input_channels[inlet]; ++lane)
+                        lane_inputs[inlet][lane] = in_chans[input_offsets[inlet] + (first_channel + lane) % input_channels[inlet]];
+                }
+                for (auto outlet = 0u; outlet < output_count; ++outlet) {
+                    for (auto lane = 0u; lane < live_lanes; ++lane)
+                        lane_outputs[outlet][lane] = out_chans[outlet * outlet_channels + first_channel + lane];
+                }
+
+                instance.group(first_channel / lane_count);
+
+                for (auto block_start = 0u; block_start < frame_count; block_start += k_block_frame_count) {
+                    const auto                               block_frame_count { std::min(k_block_frame_count, frame_count - block_start) };
+                    sample_batches<input_count, lane_count>  block_inputs[k_block_frame_count] {};
+                    sample_batches<output_count, lane_count> block_outputs[k_block_frame_count] {};
+
+                    for (auto inlet = 0u; inlet < input_count; ++inlet) {
+                        for (auto lane = 0u; lane < live_lanes && input_channels[inlet]; ++lane) {
+                            const auto source { lane_inputs[inlet][lane] + block_start };
+                            for (auto i = 0u; i < block_frame_count; ++i)
+                                block_inputs[i][inlet][lane] = source[i];
+                        }
+                    }
+
+                    for (auto i = 0u; i < block_frame_count; ++i) {
+                        callable_batches<min_class_type, input_count, lane_count> ins(self);
+
+                        instance.smoother_frame(block_start + i);
+                        attrs.write_sample(first_inputs, block_start + i);
+
+                        ins.data = block_inputs[i];
+                        perform_lanes_call<min_class_type>::call(ins, block_outputs[i]);
+                    }
+
+                    for (auto outlet = 0u; outlet < output_count; ++outlet) {
+                        for (auto lane = 0u; lane < live_lanes; ++lane) {
+                            const auto destination { lane_outputs[outlet][lane] + block_start };
+                            for (auto i = 0u; i < block_frame_count; ++i)
+                                destination[i] = block_outputs[i][outlet][lane];
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        static constexpr size_t k_block_frame_count { 16 };
+    };
+
 }    // namespace c74::min
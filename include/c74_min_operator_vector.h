@@ -8,6 +8,146 @@
 namespace c74::min {
 
 
+    /// A view of the samples of one channel of an audio_bundle, or of any other array of samples.
+    /// It plays the part of a std::span<sample>, which is not available in C++17,
+    /// and adds operations that run the vectorized audio_kernels().
+    /// The destination of an operation must not overlap a source, unless it is the same array.
+
+    class audio_channel {
+    public:
+        /// Create a view of an array of samples.
+        /// @param	samples		The first sample.
+        /// @param	size		The number of samples.
+
+        audio_channel(sample* samples, const size_t size)
+        : m_samples { samples }
+        , m_size { size }
+        {}
+
+
+        /// The first sample.
+
+        sample* data() const {
+            return m_samples;
+        }
+
+
+        /// The number of samples.
+
+        size_t size() const {
+            return m_size;
+        }
+
+
+        sample& operator[](const size_t index) const {
+            return m_samples[index];
+        }
+
+        sample* begin() const {
+            return m_samples;
+        }
+
+        sample* end() const {
+            return m_samples + m_size;
+        }
+
+
+        /// Set every sample to zero.
+
+        void clear() {
+            audio_kernels().fill(m_samples, 0.0, m_size);
+        }
+
+
+        /// Copy the samples of another channel of at least the same size.
+
+        void copy(const audio_channel& source) {
+            assert(source.m_size >= m_size);
+            audio_kernels().copy(m_samples, source.m_samples, m_size);
+        }
+
+
+        /// Add the samples of another channel to these.
+
+        void add(const audio_channel& source) {
+            assert(source.m_size >= m_size);
+            audio_kernels().add(m_samples, m_samples, source.m_samples, m_size);
+        }
+
+
+        /// Set these samples to the sum of two channels.
+
+        void add(const audio_channel& a, const audio_channel& b) {
+            assert(a.m_size >= m_size && b.m_size >= m_size);
+            audio_kernels().add(m_samples, a.m_samples, b.m_samples, m_size);
+        }
+
+
+        /// Add the samples of another channel multiplied by a gain to these.
+
+        void add(const audio_channel& source, const sample gain) {
+            assert(source.m_size >= m_size);
+            audio_kernels().add_scaled(m_samples, source.m_samples, gain, m_size);
+        }
+
+
+        /// Multiply these samples by those of another channel.
+
+        void multiply(const audio_channel& source) {
+            assert(source.m_size >= m_size);
+            audio_kernels().multiply(m_samples, m_samples, source.m_samples, m_size);
+        }
+
+
+        /// Set these samples to the product of two channels.
+
+        void multiply(const audio_channel& a, const audio_channel& b) {
+            assert(a.m_size >= m_size && b.m_size >= m_size);
+            audio_kernels().multiply(m_samples, a.m_samples, b.m_samples, m_size);
+        }
+
+
+        /// Add the product of two channels to these samples.
+
+        void multiply_add(const audio_channel& a, const audio_channel& b) {
+            assert(a.m_size >= m_size && b.m_size >= m_size);
+            audio_kernels().multiply_add(m_samples, a.m_samples, b.m_samples, m_size);
+        }
+
+
+        /// Multiply the samples by a gain.
+
+        void gain(const sample gain) {
+            audio_kernels().scale(m_samples, m_samples, gain, 0.0, m_size);
+        }
+
+
+        /// Multiply the samples by a gain that ramps linearly from one value, at the first sample, towards another, reached after the last.
+
+        void gain(const sample from, const sample to) {
+            audio_kernels().scale(m_samples, m_samples, from, m_size ? (to - from) / m_size : 0.0, m_size);
+        }
+
+
+        /// The largest absolute value of the samples.
+
+        sample peak() const {
+            return audio_kernels().peak(m_samples, m_size);
+        }
+
+
+        /// The root mean square of the samples.
+
+        sample rms() const {
+            return m_size ? std::sqrt(audio_kernels().sum_of_squares(m_samples, m_size) / m_size) : 0.0;
+        }
+
+    private:
+        sample* m_samples;
+        size_t  m_size;
+    };
+
+
     /// An audio bundle is a container for N channels of M-sized vectors of audio sample values.
 
     struct audio_bundle {
@@ -45,6 +185,16 @@ namespace c74::min {
         }
 
 
+        /// Get a view of the samples for a specific channel.
+        /// @param	channel		The channel to view.
+        ///						NOTE: No bounds checking is performed!
+        /// @return				The view of the channel's samples.
+
+        audio_channel channel(const size_t channel) const {
+            return { m_samples[channel], static_cast<size_t>(m_frame_count) };
+        }
+
+
         /// Determine the number of channels in an audio bundle.
         /// @return		The number of channels in the audio bundle.
 
@@ -67,10 +217,8 @@ namespace c74::min {
         /// Zero-out the data in the entire audio bundle.
 
         void clear() {
-            for (auto channel = 0; channel < m_channel_count; ++channel) {
-                for (auto i = 0; i < m_frame_count; ++i)
-                    m_samples[channel][i] = 0.0;
-            }
+            for (auto channel = 0; channel < m_channel_count; ++channel)
+                this->channel(channel).clear();
         }
 
 
@@ -91,13 +239,102 @@ namespace c74::min {
             assert(m_channel_count <= other.m_channel_count);
             assert(m_frame_count == other.m_frame_count);
 
-            for (auto channel = 0; channel < m_channel_count; ++channel) {
-                for (auto i = 0; i < m_frame_count; ++i)
-                    m_samples[channel][i] = other.m_samples[channel][i];
-            }
+            for (auto channel = 0; channel < m_channel_count; ++channel)
+                this->channel(channel).copy(other.channel(channel));
             return *this;
         }
 
+
+        /// Add the channels of another audio_bundle, of at least as many channels, to these.
+        /// @param 	other	The audio_bundle to add.
+
+        void add(const audio_bundle& other) {
+            assert(m_channel_count <= other.m_channel_count);
+            assert(m_frame_count == other.m_frame_count);
+
+            for (auto channel = 0; channel < m_channel_count; ++channel)
+                this->channel(channel).add(other.channel(channel));
+        }
+
+
+        /// Multiply the channels by those of another audio_bundle, of at least as many channels.
+        /// @param 	other	The audio_bundle by which to multiply.
+
+        void multiply(const audio_bundle& other) {
+            assert(m_channel_count <= other.m_channel_count);
+            assert(m_frame_count == other.m_frame_count);
+
+            for (auto channel = 0; channel < m_channel_count; ++channel)
+                this->channel(channel).multiply(other.channel(channel));
+        }
+
+
+        /// Add the products of the channels of two audio_bundles to these channels.
+        /// @param 	a	The first audio_bundle to multiply.
+        /// @param 	b	The second audio_bundle to multiply.
+
+        void multiply_add(const audio_bundle& a, const audio_bundle& b) {
+            assert(m_channel_count <= a.m_channel_count && m_channel_count <= b.m_channel_count);
+            assert(m_frame_count == a.m_frame_count && m_frame_count == b.m_frame_count);
+
+            for (auto channel = 0; channel < m_channel_count; ++channel)
+                this->channel(channel).multiply_add(a.channel(channel), b.channel(channel));
+        }
+
+
+        /// Multiply all channels by a gain.
+
+        void gain(const sample gain) {
+            for (auto channel = 0; channel < m_channel_count; ++channel)
+                this->channel(channel).gain(gain);
+        }
+
+
+        /// Multiply all channels by a gain that ramps linearly from one value, at the first sample, towards another, reached after the last.
+
+        void gain(const sample from, const sample to) {
+            for (auto channel = 0; channel < m_channel_count; ++channel)
+                this->channel(channel).gain(from, to);
+        }
+
+
+        /// Mix all channels down to a single channel.
+        /// @param	destination		The channel to write, of at least frame_count() samples, which must not be one of the bundle's channels.
+        /// @param	gain			The gain applied to every channel, e.g. 1.0 / channel_count() to average them.
+
+        void mix_down(audio_channel destination, const sample gain = 1.0) const {
+            if (m_channel_count == 0) {
+                destination.clear();
+                return;
+            }
+            audio_kernels().scale(destination.data(), m_samples[0], gain, 0.0, static_cast<size_t>(m_frame_count));
+            for (auto channel = 1; channel < m_channel_count; ++channel)
+                audio_kernels().add_scaled(destination.data(), m_samples[channel], gain, static_cast<size_t>(m_frame_count));
+        }
+
+
+        /// The largest absolute value of the samples of all channels.
+
+        sample peak() const {
+            sample peak {};
+            for (auto channel = 0; channel < m_channel_count; ++channel)
+                peak = std::max(peak, this->channel(channel).peak());
+            return peak;
+        }
+
+
+        /// The root mean square of the samples of all channels.
+
+        sample rms() const {
+            if (m_channel_count == 0 || m_frame_count == 0)
+                return 0.0;
+
+            sample sum {};
+            for (auto channel = 0; channel < m_channel_count; ++channel)
+                sum += audio_kernels().sum_of_squares(m_samples[channel], static_cast<size_t>(m_frame_count));
+            return std::sqrt(sum / (static_cast<double>(m_channel_count) * m_frame_count));
+        }
+
     private:
         double** m_samples { nullptr };
         long     m_channel_count {};
@@ -105,6 +342,20 @@ namespace c74::min {
     };
 
 
+    // An mc_lanes class makes room for the channel counts of its inlets when it is created,
+    // so that Max reporting a new count never resizes storage that the audio thread is reading.
+
+    template<class min_class_type>
+    typename enable_if<is_base_of<mc_lanes_base, min_class_type>::value>::type
+    min_setup_mc_lanes(min_class_type& instance) {
+        instance.input_channel_counts(min_class_type::input_count());
+    }
+
+    template<class min_class_type>
+    typename enable_if<!is_base_of<mc_lanes_base, min_class_type>::value>::type
+    min_setup_mc_lanes(min_class_type& instance) {}
+
+
     // A specialization of "minwrap" (the container of the Max t_object together with the Min class)
     // for audio objects (both vector_operator and sample_operator)
     //
@@ -115,22 +366,30 @@ namespace c74::min {
         maxobject_header m_max_header;
         min_class_type   m_min_object;
 
+#ifdef C74_MIN_WITH_PROFILING
+        dsp_load         m_dsp_load;
+#endif
+
 
         // Setup is called at instantiation.
 
         void setup() {
+#ifdef C74_MIN_WITH_PROFILING
+            new (&m_dsp_load) dsp_load;    // placement new, as for the Min object
+#endif
             max::dsp_setup(m_max_header, (long)m_min_object.inlets().size());
+            min_setup_mc_lanes(m_min_object);
 
             if (m_min_object.is_ui_class()) {
                 max::t_pxjbox* x = m_max_header;
                 x->z_misc |= Z_NO_INPLACE;
-                if (is_base_of<mc_operator_base, min_class_type>::value)
+                if (is_base_of<mc_operator_base, min_class_type>::value || is_base_of<mc_lanes_base, min_class_type>::value)
                     x->z_misc |= Z_MC_INLETS;
             }
             else {
                 max::t_pxobject* x = m_max_header;
                 x->z_misc |= Z_NO_INPLACE;
-                if (is_base_of<mc_operator_base, min_class_type>::value)
+                if (is_base_of<mc_operator_base, min_class_type>::value || is_base_of<mc_lanes_base, min_class_type>::value)
                     x->z_misc |= Z_MC_INLETS;
             }
 
@@ -163,7 +422,7 @@ namespace c74::min {
     // Some of the operator types don't actually require the templates at this time but all operators are implemented this way
     // both for consistency and to allow template parameters to be added in the future without breaking existing code.
 
-    class vector_operator_base {};
+    class vector_operator_base : public smoother_host {};
 
 
     /// Inherit from vector_operator to extend your class for processing vectors of audio samples.
@@ -254,6 +513,7 @@ namespace c74::min {
         static void perform(minwrap<min_class_type>* self, max::t_object* dsp64, double** in_chans, const long numins, double** out_chans, const long numouts, const long sampleframes, const long, const void*) {
             audio_bundle input {in_chans, numins, sampleframes};
             audio_bundle output {out_chans, numouts, sampleframes};
+            self->m_min_object.advance_smoothers(sampleframes);
             self->m_min_object(input, output);
         }
     };
@@ -303,6 +563,8 @@ namespace c74::min {
     // The main "dsp64" method is min_dsp64(), which needs to obey basic C rules because it is called by Max.
     // This in-turn then calls min_dsp64_sel() which is a templated C++ function that is specialized based on the properties of the Min
     // class. Each of those specializations needs to perform some common/shared functions which are then factored out as well.
+    // Finally min_dsp64_add_perform() adds the perform routine to the signal chain.
+    // Calling min_dsp64_sel() and then the routine returned by min_perform_routine() processes audio as Max would, e.g. offline.
 
     // The min_dsp64_io function handles updating the inlet and outlet connection state any time the dsp64 message is called.
 
@@ -323,11 +585,109 @@ namespace c74::min {
     }
 
 
+    // The min_dsp64_outlets function lets outlets prepare for the dsp chain, e.g. outlets that queue values sent from the audio thread.
+
+    template<class min_class_type>
+    void min_dsp64_outlets(minwrap<min_class_type>* self, const double samplerate, const long maxvectorsize) {
+        for (auto an_outlet : self->m_min_object.outlets())
+            an_outlet->dspsetup(samplerate, maxvectorsize);
+    }
+
+
     template<class min_class_type, enable_if_vector_operator<min_class_type> = 0>
     void min_dsp64_attrmap(minwrap<min_class_type>* self, const short* count)
     {}
 
 
+    // Oversampled classes allocate their buffers when the dsp chain is compiled. See c74_min_oversampling.h
+
+    template<class min_class_type>
+    typename enable_if<!is_base_of<oversampled_base, min_class_type>::value>::type
+    min_dsp64_oversampling(minwrap<min_class_type>* self, const long maxvectorsize)
+    {}
+
+
+    // The performers of sample operators take their inputs as const.
+    // Performers that wrap another performer pass the inputs on with the type that the wrapped performer expects.
+
+    template<class min_class_type, class input_type>
+    using perform_routine = void (*)(minwrap<min_class_type>*, max::t_object*, input_type**, long, double**, long, long, long, const void*);
+
+    template<class min_class_type, class input_type>
+    void call_performer(const perform_routine<min_class_type, input_type> routine, minwrap<min_class_type>* self, max::t_object* dsp64, double** in_chans, const long numins, double** out_chans, const long numouts, const long sampleframes, const long flags, const void* userparam) {
+        routine(self, dsp64, const_cast<input_type**>(in_chans), numins, out_chans, numouts, sampleframes, flags, userparam);
+    }
+
+
+    // Every performer is called within an audio_thread_scope, so that code it calls, such as outlets with the timed thread_action,
+    // can tell that it is running on the audio thread without asking Max.
+
+    template<class min_class_type, class performer_type>
+    class audio_thread_performer {
+    public:
+        static void perform(minwrap<min_class_type>* self, max::t_object* dsp64, double** in_chans, const long numins, double** out_chans, const long numouts, const long sampleframes, const long flags, const void* userparam) {
+            audio_thread_scope audio_thread;
+            call_performer(performer_type::perform, self, dsp64, in_chans, numins, out_chans, numouts, sampleframes, flags, userparam);
+        }
+    };
+
+
+    // Classes declaring MIN_DENORMAL_FLAGS { denormal_flags::flush } have their performer called within a denormal_guard.
+
+    template<class min_class_type>
+    class denormal_flushing_performer {
+    public:
+        static void perform(minwrap<min_class_type>* self, max::t_object* dsp64, double** in_chans, const long numins, double** out_chans, const long numouts, const long sampleframes, const long flags, const void* userparam) {
+            denormal_guard guard;
+            call_performer(performer<min_class_type>::perform, self, dsp64, in_chans, numins, out_chans, numouts, sampleframes, flags, userparam);
+        }
+    };
+
+
+#ifdef C74_MIN_WITH_PROFILING
+
+    // With profiling compiled in, every audio object measures the time taken by its performer. See the dsp_load class.
+
+    template<class min_class_type, class performer_type>
+    class timed_performer {
+    public:
+        static void perform(minwrap<min_class_type>* self, max::t_object* dsp64, double** in_chans, const long numins, double** out_chans, const long numouts, const long sampleframes, const long flags, const void* userparam) {
+            dsp_load_scope timing { self->m_dsp_load, sampleframes };
+            call_performer(performer_type::perform, self, dsp64, in_chans, numins, out_chans, numouts, sampleframes, flags, userparam);
+        }
+    };
+
+#endif    // C74_MIN_WITH_PROFILING
+
+
+    // The min_perform_routine function returns the routine that is added to the signal chain for a class:
+    // its performer, within a denormal_guard if the class asks for one, within an audio_thread_scope, and timed if profiling is compiled in.
+
+    template<class min_class_type>
+    max::t_perfroutine64 min_perform_routine() {
+        using flushing_performer = typename std::conditional<class_get_denormal_flags<min_class_type>() == denormal_flags::flush,
+            denormal_flushing_performer<min_class_type>, performer<min_class_type>>::type;
+        using scoped_performer = audio_thread_performer<min_class_type, flushing_performer>;
+
+#ifdef C74_MIN_WITH_PROFILING
+        return reinterpret_cast<max::t_perfroutine64>(timed_performer<min_class_type, scoped_performer>::perform);
+#else
+        return reinterpret_cast<max::t_perfroutine64>(scoped_performer::perform);
+#endif
+    }
+
+
+    // The min_dsp64_load function sets the samplerate against which the time taken by the performer is measured.
+    // Without C74_MIN_WITH_PROFILING this does nothing.
+
+    template<class min_class_type>
+    void min_dsp64_load(minwrap<min_class_type>* self, const double samplerate) {
+#ifdef C74_MIN_WITH_PROFILING
+        self->m_dsp_load.dspsetup(samplerate);
+#endif
+    }
+
+
     // The min_dsp64_add_perform function handles adding the perform method to the signal chain (see performer class above)
 
     template<class min_class_type>
@@ -335,7 +695,7 @@ namespace c74::min {
         // find the perform method and add it
         using namespace c74::max;
         object_method_direct(void, (void*, max::t_object*, const max::t_perfroutine64, const long, const void*), dsp64, symbol("dsp_add64"),
-            self->maxobj(), reinterpret_cast<max::t_perfroutine64>(performer<min_class_type>::perform), 0, NULL);
+            self->maxobj(), min_perform_routine<min_class_type>(), 0, NULL);
     }
 
 
@@ -345,18 +705,20 @@ namespace c74::min {
     template<class min_class_type>
     typename enable_if<has_dspsetup<min_class_type>::value
     || has_m_dspsetup<min_class_type>::value>::type
-    min_dsp64_sel(minwrap<min_class_type>* self, max::t_object* dsp64, const short* count, const double samplerate, const long maxvectorsize, const long flags) {
+    min_dsp64_sel(minwrap<min_class_type>* self, const short* count, const double samplerate, const long maxvectorsize) {
         self->m_min_object.samplerate(samplerate);
         self->m_min_object.vector_size(maxvectorsize);
         min_dsp64_io(self, count);
+        min_dsp64_outlets(self, samplerate, maxvectorsize);
+        self->m_min_object.dspsetup_smoothers(samplerate, maxvectorsize);
         min_dsp64_attrmap(self, count);
+        min_dsp64_oversampling(self, maxvectorsize);
+        min_dsp64_load(self, samplerate);
 
         atoms args;
         args.push_back(atom(samplerate));
         args.push_back(atom(max::t_atom_long(maxvectorsize)));
         self->m_min_object.dspsetup(args);
-
-        min_dsp64_add_perform(self, dsp64);
     }
 
 
@@ -366,12 +728,15 @@ namespace c74::min {
     template<class min_class_type>
     typename enable_if<!has_dspsetup<min_class_type>::value
     && !has_m_dspsetup<min_class_type>::value>::type
-    min_dsp64_sel(minwrap<min_class_type>* self, max::t_object* dsp64, const short* count, const double samplerate, const long maxvectorsize, const long flags) {
+    min_dsp64_sel(minwrap<min_class_type>* self, const short* count, const double samplerate, const long maxvectorsize) {
         self->m_min_object.samplerate(samplerate);
         self->m_min_object.vector_size(maxvectorsize);
         min_dsp64_io(self, count);
+        min_dsp64_outlets(self, samplerate, maxvectorsize);
+        self->m_min_object.dspsetup_smoothers(samplerate, maxvectorsize);
         min_dsp64_attrmap(self, count);
-        min_dsp64_add_perform(self, dsp64);
+        min_dsp64_oversampling(self, maxvectorsize);
+        min_dsp64_load(self, samplerate);
     }
 
 
@@ -380,9 +745,53 @@ namespace c74::min {
     template<class min_class_type>
     type_enable_if_audio_class<min_class_type>
     min_dsp64(minwrap<min_class_type>* self, max::t_object* dsp64, const short* count, const double samplerate, const long maxvectorsize, const long flags) {
-        min_dsp64_sel<min_class_type>(self, dsp64, count, samplerate, maxvectorsize, flags);
+        min_dsp64_sel<min_class_type>(self, count, samplerate, maxvectorsize);
+        min_dsp64_add_perform(self, dsp64);
+    }
+
+
+    // Max calls inputchanged when the number of channels connected to an inlet of an mc_lanes class changes,
+    // and then multichanneloutputs for the number of channels of each outlet.
+
+    template<class min_class_type>
+    long min_inputchanged(minwrap<min_class_type>* self, const long index, const long count) {
+        return self->m_min_object.input_channel_count(index, count);
+    }
+
+    template<class min_class_type>
+    long min_multichanneloutputs(minwrap<min_class_type>* self, const long index) {
+        return static_cast<long>(self->m_min_object.channel_count());
+    }
+
+    template<class min_class_type>
+    typename enable_if<is_base_of<mc_lanes_base, min_class_type>::value>::type
+    wrap_as_max_external_mc(max::t_class* c) {
+        max::class_addmethod(c, reinterpret_cast<max::method>(min_inputchanged<min_class_type>), "inputchanged", max::A_CANT, 0);
+        max::class_addmethod(c, reinterpret_cast<max::method>(min_multichanneloutputs<min_class_type>), "multichanneloutputs", max::A_CANT, 0);
     }
 
+    template<class min_class_type>
+    typename enable_if<!is_base_of<mc_lanes_base, min_class_type>::value>::type
+    wrap_as_max_external_mc(max::t_class* c) {}
+
+
+    // Oversampled classes report the latency of their filters, in samples, to Max in answer to getlatency.
+
+    template<class min_class_type>
+    max::t_atom_long min_getlatency(minwrap<min_class_type>* self) {
+        return static_cast<max::t_atom_long>(min_class_type::latency());
+    }
+
+    template<class min_class_type>
+    typename enable_if<is_base_of<oversampled_base, min_class_type>::value>::type
+    wrap_as_max_external_latency(max::t_class* c) {
+        max::class_addmethod(c, reinterpret_cast<max::method>(min_getlatency<min_class_type>), "getlatency", max::A_CANT, 0);
+    }
+
+    template<class min_class_type>
+    typename enable_if<!is_base_of<oversampled_base, min_class_type>::value>::type
+    wrap_as_max_external_latency(max::t_class* c) {}
+
 
     // Add audio support to a Max external when the max::t_class is being setup.
     // A call to wrap_as_max_external_audio() will be called for all externals when wrapping the Min class.
@@ -392,6 +801,8 @@ namespace c74::min {
     template<class min_class_type, enable_if_audio_class<min_class_type> = 0>
     void wrap_as_max_external_audio(max::t_class* c) {
         max::class_addmethod(c, reinterpret_cast<max::method>(min_dsp64<min_class_type>), "dsp64", max::A_CANT, 0);
+        wrap_as_max_external_mc<min_class_type>(c);
+        wrap_as_max_external_latency<min_class_type>(c);
         if (is_base_of<ui_operator_base, min_class_type>::value)
             max::class_dspinitjbox(c);
         else
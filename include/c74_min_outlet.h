@@ -25,18 +25,22 @@ namespace c74::min {
     // Regardless of how the threading is handled, when it comes time to actually send the data to the outlet the
     // outlet_do_send() helper function is called.
 
-    template<typename outlet_type>
-    inline void outlet_do_send(const t_max_outlet maxoutlet, const outlet_type& value) {
-        if (value[0].a_type == max::A_LONG || value[0].a_type == max::A_FLOAT)
-            max::outlet_list(maxoutlet, nullptr, static_cast<short>(value.size()), (max::t_atom*)&value[0]);
+    inline void outlet_do_send(const t_max_outlet maxoutlet, const max::t_atom* values, const size_t count) {
+        if (values[0].a_type == max::A_LONG || values[0].a_type == max::A_FLOAT)
+            max::outlet_list(maxoutlet, nullptr, static_cast<short>(count), const_cast<max::t_atom*>(values));
         else {
-            if (value.size() > 1)
-                max::outlet_anything(maxoutlet, value[0], static_cast<short>(value.size() - 1), (max::t_atom*)&value[1]);
+            if (count > 1)
+                max::outlet_anything(maxoutlet, max::atom_getsym(values), static_cast<short>(count - 1), const_cast<max::t_atom*>(values + 1));
             else
-                max::outlet_anything(maxoutlet, value[0], 0, nullptr);
+                max::outlet_anything(maxoutlet, max::atom_getsym(values), 0, nullptr);
         }
     }
 
+    template<typename outlet_type>
+    inline void outlet_do_send(const t_max_outlet maxoutlet, const outlet_type& value) {
+        outlet_do_send(maxoutlet, &value[0], value.size());
+    }
+
     template<>
     inline void outlet_do_send<max::t_atom_long>(const t_max_outlet maxoutlet, const max::t_atom_long& value) {
         max::outlet_int(maxoutlet, value);
@@ -48,6 +52,86 @@ namespace c74::min {
     }
 
 
+    // Arrays of numbers sent out of an outlet are converted into a buffer of atoms kept by the outlet.
+    // The buffer grows to the longest list sent and is then reused, so steady-state sends don't allocate.
+    //
+    // Max delivers a list before outlet_list() returns, so a send may still be using the buffer when another begins:
+    // on another thread, or on the same thread when an object downstream sends through this outlet again (e.g. in a feedback loop).
+    // A send that finds the buffer in use converts into a buffer of its own instead, on the stack for short lists.
+
+    class outlet_scratch {
+    public:
+        outlet_scratch() = default;
+        outlet_scratch(const outlet_scratch&) = delete;
+        outlet_scratch& operator=(const outlet_scratch&) = delete;
+
+
+        // The atoms used by one send, for as long as the lease exists.
+
+        class lease {
+        public:
+            lease(outlet_scratch& a_scratch, const size_t count) {
+                if (!a_scratch.m_busy.exchange(true, std::memory_order_acquire)) {
+                    m_scratch = &a_scratch;
+                    if (a_scratch.m_atoms.size() < count)
+                        a_scratch.m_atoms.resize(count);
+                    m_atoms = a_scratch.m_atoms.data();
+                }
+                else if (count <= k_local_count)
+                    m_atoms = m_local;
+                else {
+                    m_heap.resize(count);
+                    m_atoms = m_heap.data();
+                }
+            }
+
+            ~lease() {
+                if (m_scratch)
+                    m_scratch->m_busy.store(false, std::memory_order_release);
+            }
+
+            lease(const lease&) = delete;
+            lease& operator=(const lease&) = delete;
+
+            max::t_atom* data() const {
+                return m_atoms;
+            }
+
+        private:
+            static constexpr size_t k_local_count { 32 };
+
+            outlet_scratch*          m_scratch {};    // set if this lease holds the outlet's buffer
+            max::t_atom*             m_atoms {};
+            max::t_atom              m_local[k_local_count];
+            std::vector<max::t_atom> m_heap;
+        };
+
+    private:
+        std::vector<max::t_atom> m_atoms;
+        std::atomic<bool>        m_busy {};
+    };
+
+
+    // Convert an array of numbers into atoms.
+    // The atoms are written directly rather than with atom_setfloat() or atom_setlong() so that the loop can be vectorized.
+
+    template<class value_type, typename enable_if<std::is_floating_point<value_type>::value, int>::type = 0>
+    inline void outlet_convert(max::t_atom* atoms, const value_type* values, const size_t count) {
+        for (auto i = 0u; i < count; ++i) {
+            atoms[i].a_type      = max::A_FLOAT;
+            atoms[i].a_w.w_float = static_cast<max::t_atom_float>(values[i]);
+        }
+    }
+
+    template<class value_type, typename enable_if<std::is_integral<value_type>::value, int>::type = 0>
+    inline void outlet_convert(max::t_atom* atoms, const value_type* values, const size_t count) {
+        for (auto i = 0u; i < count; ++i) {
+            atoms[i].a_type     = max::A_LONG;
+            atoms[i].a_w.w_long = static_cast<max::t_atom_long>(values[i]);
+        }
+    }
+
+
 #ifdef MAC_VERSION
 #pragma mark -
 #endif
@@ -68,6 +152,10 @@ namespace c74::min {
     //				if multiple sends are received before the call is serviced then only send the last one.
     // * fifo:		Schedule or defer the call to the appropriate thread,
     //				if multiple sends are received before the call is serviced they are put in a fifo and all are delivered.
+    // * coalesce:	Schedule or defer the call to the appropriate thread,
+    //				if multiple sends are received before the call is serviced they are merged into one by a reducer.
+    // * timed:		Queue the call from the audio thread with the time it was made,
+    //				and deliver it from the scheduler thread at that time.
     //
     // The outlet_queue inherits from thread_trigger.
     // The thread_trigger manages the internal t_qelem or t_clock used to trigger the callback.
@@ -78,41 +166,208 @@ namespace c74::min {
     template<thread_check check, thread_action action>
     class outlet_queue : public thread_trigger<t_max_outlet, check> {
     public:
-        explicit outlet_queue(const t_max_outlet a_maxoutlet)
+        explicit outlet_queue(const t_max_outlet a_maxoutlet, const size_t an_atom_count = 0)
         : thread_trigger<t_max_outlet, check>(a_maxoutlet)
         {}
 
         void callback() {}
 
         void push(const message_type, const atoms&) {}
+
+        void push(const message_type, const max::t_atom*, const size_t) {}
     };
 
 
+    /// Holds at most one pending value (an int, a float, or a list of atoms) that is handed from any number of threads
+    /// to a single receiving thread, e.g. from the audio thread to the main thread.
+    /// Storage for the atoms is allocated up front, so storing and taking values neither locks nor allocates.
+    ///
+    /// Each value is written into a slot of its own and then published by atomically exchanging the index of the pending slot.
+    /// The receiver thus never sees a value that is only partially written, and senders never wait for each other or for the receiver.
+    /// There are enough slots for two senders to write at the same time while one value is pending and another is being received.
+    /// A value is dropped (and counted) if there is no free slot, or if it is longer than the capacity.
+
+    class atom_mailbox {
+    public:
+        /// The number of slots for values.
+
+        static constexpr size_t slot_count { 4 };
+
+
+        /// Create a mailbox.
+        /// @param	a_capacity	The greatest number of atoms in a value.
+
+        explicit atom_mailbox(const size_t a_capacity)
+        : m_capacity { std::max<size_t>(a_capacity, 1) }
+        , m_atoms { std::make_unique<atom[]>(slot_count * m_capacity) }
+        {}
+
+        atom_mailbox(const atom_mailbox&) = delete;
+        atom_mailbox& operator=(const atom_mailbox&) = delete;
+
+
+        /// Store a value, replacing any value that is still pending. Threadsafe.
+        /// @param	a_type	The type of the value: message_type::int_argument, message_type::float_argument, or message_type::gimme for a list.
+        /// @param	values	The atoms of the value.
+        /// @param	count	The number of atoms in the value.
+        /// @return			True if no value was pending, in which case the receiver must be told to take the value.
+
+        bool replace(const message_type a_type, const max::t_atom* values, const size_t count) {
+            const auto slot = write(a_type, values, count);
+            if (slot == k_none)
+                return false;
+
+            const auto previous = m_pending.exchange(slot, std::memory_order_acq_rel);
+            if (previous == k_none)
+                return true;
+            release(previous);
+            return false;
+        }
+
+
+        /// Store a value unless a value is already pending. Threadsafe.
+        /// @param	a_type	The type of the value: message_type::int_argument, message_type::float_argument, or message_type::gimme for a list.
+        /// @param	values	The atoms of the value.
+        /// @param	count	The number of atoms in the value.
+        /// @return			True if the value was stored, in which case the receiver must be told to take the value.
+
+        bool offer(const message_type a_type, const max::t_atom* values, const size_t count) {
+            if (m_pending.load(std::memory_order_acquire) != k_none)
+                return false;
+
+            const auto slot = write(a_type, values, count);
+            if (slot == k_none)
+                return false;
+
+            auto expected = k_none;
+            if (m_pending.compare_exchange_strong(expected, slot, std::memory_order_acq_rel))
+                return true;
+            release(slot);    // another thread stored its value first
+            return false;
+        }
+
+
+        /// Take the pending value, if any.
+        /// Only one thread may take values from a mailbox.
+        /// @param	a_function	Called with the type of the value and the atoms of the value, which are valid only during the call.
+        /// @return				True if there was a value. Otherwise false.
+
+        template<class function_type>
+        bool take(const function_type& a_function) {
+            const auto slot = m_pending.exchange(k_none, std::memory_order_acq_rel);
+            if (slot == k_none)
+                return false;
+
+            a_function(m_slots[slot].type, atom_reference(static_cast<long>(m_slots[slot].count), &m_atoms[slot * m_capacity]));
+            release(slot);
+            return true;
+        }
+
+
+        /// The greatest number of atoms in a value.
+
+        size_t capacity() const {
+            return m_capacity;
+        }
+
+
+        /// The number of values dropped because they were too long or because there was no free slot.
+        /// Values that were replaced or not offered because another value was pending are not counted.
+
+        size_t dropped() const {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr size_t k_none { slot_count };
+
+        struct slot {
+            std::atomic<bool> busy { false };
+            message_type      type { message_type::gimme };
+            size_t            count {};
+        };
+
+        size_t                    m_capacity;
+        std::unique_ptr<atom[]>   m_atoms;
+        slot                      m_slots[slot_count];
+        std::atomic<size_t>       m_pending { k_none };
+        std::atomic<size_t>       m_dropped {};
+
+
+        // Claim a free slot and write the value into it. Returns k_none if the value was dropped.
+
+        size_t write(const message_type a_type, const max::t_atom* values, const size_t count) {
+            if (count <= m_capacity) {
+                for (auto i = 0u; i < slot_count; ++i) {
+                    auto busy = false;
+                    if (m_slots[i].busy.compare_exchange_strong(busy, true, std::memory_order_acquire)) {
+                        std::copy(values, values + count, &m_atoms[i * m_capacity]);
+                        m_slots[i].type  = a_type;
+                        m_slots[i].count = count;
+                        return i;
+                    }
+                }
+            }
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return k_none;
+        }
+
+
+        void release(const size_t a_slot) {
+            m_slots[a_slot].busy.store(false, std::memory_order_release);
+        }
+    };
+
+
+    /// The number of atoms an outlet with the first, last, or coalesce thread_action can queue,
+    /// unless the outlet is created with a greater atom count.
+
+    static constexpr size_t k_outlet_queue_atom_count { 16 };
+
+
+    // Send a value taken from an atom_mailbox or another outlet queue.
+
+    inline void outlet_do_send(const t_max_outlet maxoutlet, const message_type a_type, const atom_reference& values) {
+        if (a_type == message_type::int_argument)
+            max::outlet_int(maxoutlet, max::atom_getlong(values.begin()));
+        else if (a_type == message_type::float_argument)
+            max::outlet_float(maxoutlet, max::atom_getfloat(values.begin()));
+        else
+            outlet_do_send(maxoutlet, values.begin(), static_cast<size_t>(values.size()));
+    }
+
+
     // FIRST: store only the first value and discard additional values (opposite of usurp)
 
     template<thread_check check>
     class outlet_queue<check, thread_action::first> : public thread_trigger<t_max_outlet, check> {
     public:
-        explicit outlet_queue(const t_max_outlet a_maxoutlet)
+        explicit outlet_queue(const t_max_outlet a_maxoutlet, const size_t an_atom_count = k_outlet_queue_atom_count)
         : thread_trigger<t_max_outlet, check>(a_maxoutlet)
+        , m_value { std::max(an_atom_count, k_outlet_queue_atom_count) }
         {}
 
         void callback() {
-            outlet_do_send(this->m_baton, m_value);
-            m_set = false;
+            m_value.take([this](const message_type a_type, const atom_reference& values) {
+                outlet_do_send(this->m_baton, a_type, values);
+            });
         }
 
         void push(const message_type a_type, const atoms& as) {
-            if (!m_set) {
-                m_value = as;
-                m_set   = true;
+            push(a_type, as.data(), as.size());
+        }
+
+        void push(const message_type a_type, const max::t_atom* values, const size_t count) {
+            if (m_value.offer(a_type, values, count))
                 thread_trigger<t_max_outlet, check>::set();
-            }
+        }
+
+        const atom_mailbox& storage() const {
+            return m_value;
         }
 
     private:
-        atoms m_value;
-        bool  m_set { false };
+        atom_mailbox m_value;
     };
 
 
@@ -121,60 +376,1020 @@ namespace c74::min {
     template<thread_check check>
     class outlet_queue<check, thread_action::last> : public thread_trigger<t_max_outlet, check> {
     public:
-        explicit outlet_queue(const t_max_outlet a_maxoutlet)
+        explicit outlet_queue(const t_max_outlet a_maxoutlet, const size_t an_atom_count = k_outlet_queue_atom_count)
         : thread_trigger<t_max_outlet, check>(a_maxoutlet)
+        , m_value { std::max(an_atom_count, k_outlet_queue_atom_count) }
         {}
 
         void callback() {
-            outlet_do_send(this->m_maxoutlet, m_value);
+            m_value.take([this](const message_type a_type, const atom_reference& values) {
+                outlet_do_send(this->m_baton, a_type, values);
+            });
         }
 
         void push(const message_type a_type, const atoms& as) {
-            m_value = as;
-            thread_trigger<t_max_outlet, check>::set();
+            push(a_type, as.data(), as.size());
+        }
+
+        void push(const message_type a_type, const max::t_atom* values, const size_t count) {
+            if (m_value.replace(a_type, values, count))
+                thread_trigger<t_max_outlet, check>::set();
+        }
+
+        const atom_mailbox& storage() const {
+            return m_value;
+        }
+
+    private:
+        atom_mailbox m_value;
+    };
+
+
+    /// A bounded queue of values (ints, floats, or lists of atoms) which any number of threads may push to and one thread pops from.
+    /// Each slot of the ring holds a value of up to a fixed number of atoms, and all of the slots are allocated up front,
+    /// so pushing and popping neither lock nor allocate.
+    /// Values pushed from one thread are popped in the order they were pushed.
+    /// What happens when the ring is full is up to the caller: see the outlet_queue for thread_action::fifo.
+
+    class atom_ring {
+    public:
+        /// The clock used to time how long values wait in the ring.
+
+        using clock = std::chrono::steady_clock;
+
+
+        /// Create a ring.
+        /// @param	a_capacity		The number of values the ring holds. Rounded up to a power of two.
+        /// @param	an_atom_count	The greatest number of atoms in a value.
+
+        atom_ring(const size_t a_capacity, const size_t an_atom_count) {
+            configure(a_capacity, an_atom_count);
+        }
+
+        atom_ring(const atom_ring&) = delete;
+        atom_ring& operator=(const atom_ring&) = delete;
+
+
+        /// Change the capacity of the ring.
+        /// Any values in the ring are discarded.
+        /// This is not threadsafe: call it only when no other thread is using the ring.
+        /// @param	a_capacity		The number of values the ring holds. Rounded up to a power of two.
+        /// @param	an_atom_count	The greatest number of atoms in a value.
+
+        void configure(const size_t a_capacity, const size_t an_atom_count) {
+            size_t capacity { 2 };
+            while (capacity < a_capacity)
+                capacity <<= 1;
+
+            m_atom_count = std::max<size_t>(an_atom_count, 1);
+            m_cells      = std::make_unique<cell[]>(capacity);
+            m_atoms      = std::make_unique<atom[]>(capacity * m_atom_count);
+            for (auto i = 0u; i < capacity; ++i)
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+
+            m_mask = capacity - 1;
+            m_enqueue_position.store(0, std::memory_order_relaxed);
+            m_dequeue_position.store(0, std::memory_order_relaxed);
+        }
+
+
+        /// Push a value onto the ring. Threadsafe.
+        /// @param	a_type	The type of the value: message_type::int_argument, message_type::float_argument, or message_type::gimme for a list.
+        /// @param	values	The atoms of the value.
+        /// @param	count	The number of atoms in the value, which must not be greater than atom_count().
+        /// @return			False if the ring is full. Otherwise true.
+
+        bool try_push(const message_type a_type, const max::t_atom* values, const size_t count) {
+            auto  position = m_enqueue_position.load(std::memory_order_relaxed);
+            cell* c;
+
+            while (true) {
+                c                   = &m_cells[position & m_mask];
+                const auto sequence = c->sequence.load(std::memory_order_acquire);
+                const auto distance = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+                if (distance == 0) {
+                    if (m_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (distance < 0)
+                    return false;    // full
+                else
+                    position = m_enqueue_position.load(std::memory_order_relaxed);
+            }
+
+            std::copy(values, values + count, &m_atoms[(position & m_mask) * m_atom_count]);
+            c->type   = a_type;
+            c->count  = count;
+            c->queued = clock::now();
+            c->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+
+        /// Pop the oldest value from the ring.
+        /// Only one thread may pop values, though any thread may discard them with try_discard().
+        /// @param	a_function	Called with the type of the value, the atoms of the value, which are valid only during the call,
+        ///						and the time at which the value was pushed.
+        /// @return				False if the ring was empty. Otherwise true.
+
+        template<class function_type>
+        bool try_pop(const function_type& a_function) {
+            size_t position;
+            auto   c = claim_oldest(position);
+
+            if (!c)
+                return false;
+            a_function(c->type, atom_reference(static_cast<long>(c->count), &m_atoms[(position & m_mask) * m_atom_count]), c->queued);
+            c->sequence.store(position + m_mask + 1, std::memory_order_release);
+            return true;
+        }
+
+
+        /// Discard the oldest value in the ring to make room for a new value. Threadsafe.
+        /// @return	False if the ring was empty. Otherwise true.
+
+        bool try_discard() {
+            size_t position;
+            auto   c = claim_oldest(position);
+
+            if (!c)
+                return false;
+            c->sequence.store(position + m_mask + 1, std::memory_order_release);
+            return true;
+        }
+
+
+        /// The approximate number of values in the ring.
+        /// The count is exact if no other thread is using the ring.
+
+        size_t size_approx() const {
+            auto enqueued = m_enqueue_position.load(std::memory_order_relaxed);
+            auto dequeued = m_dequeue_position.load(std::memory_order_relaxed);
+            return enqueued > dequeued ? enqueued - dequeued : 0;
+        }
+
+
+        /// The number of values the ring holds.
+
+        size_t capacity() const {
+            return m_mask + 1;
+        }
+
+
+        /// The greatest number of atoms in a value.
+
+        size_t atom_count() const {
+            return m_atom_count;
         }
 
     private:
-        atoms m_value;
+        // A cell is ready to be pushed to when its sequence equals the enqueue position,
+        // and ready to be popped when its sequence is one past the dequeue position.
+        // The atoms of the value in a cell are stored apart from the cell, at the same index.
+
+        struct cell {
+            std::atomic<size_t> sequence;
+            message_type        type { message_type::gimme };
+            size_t              count {};
+            clock::time_point   queued {};
+        };
+
+        static constexpr size_t k_cache_line { 64 };
+
+        std::unique_ptr<cell[]> m_cells;
+        std::unique_ptr<atom[]> m_atoms;
+        size_t                  m_atom_count {};
+        size_t                  m_mask {};
+        std::atomic<size_t>     m_enqueue_position {};
+        char                    m_enqueue_padding[k_cache_line];
+        std::atomic<size_t>     m_dequeue_position {};
+        char                    m_dequeue_padding[k_cache_line];
+
+
+        // Senders discard values too when they overwrite, so claiming the oldest value uses a compare-and-swap.
+
+        cell* claim_oldest(size_t& position) {
+            position = m_dequeue_position.load(std::memory_order_relaxed);
+
+            while (true) {
+                auto       c        = &m_cells[position & m_mask];
+                const auto sequence = c->sequence.load(std::memory_order_acquire);
+                const auto distance = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+                if (distance == 0) {
+                    if (m_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        return c;
+                }
+                else if (distance < 0)
+                    return nullptr;    // empty
+                else
+                    position = m_dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+    };
+
+
+    /// The number of values an outlet with the fifo thread_action queues before its overflow policy applies.
+    /// @see outlet_queue<check, thread_action::fifo>::configure()
+
+    static constexpr size_t k_outlet_fifo_capacity { 32 };
+
+
+    /// Statistics of the queue of an outlet with the fifo thread_action.
+    /// @see outlet<>::queue()
+
+    struct outlet_queue_stats {
+        size_t                   capacity;           ///< The number of values the queue holds before its overflow policy applies.
+        size_t                   high_water;         ///< The greatest number of values that have been waiting at once.
+        size_t                   dropped;            ///< The number of values discarded by the overflow policy or because they were too long.
+        size_t                   overflowed;         ///< The number of values kept beyond the capacity, which allocates memory.
+        size_t                   sent;               ///< The number of values sent out of the outlet from the queue.
+        std::chrono::nanoseconds mean_latency;       ///< The mean time from a value being queued to it being sent.
+        std::chrono::nanoseconds longest_latency;    ///< The longest time from a value being queued to it being sent.
     };
 
 
     // FIFO: defer all values
+    //
+    // Values are queued in a preallocated atom_ring. When the ring is full the overflow policy applies:
+    //
+    // * drop:		Discard the new value.
+    // * overwrite:	Discard the oldest value to make room for the new value.
+    // * grow:		Keep a value sent from the main thread in an overflow list, which allocates memory.
+    //				Values sent from other threads are discarded, as with drop, so that they never allocate or wait.
 
     template<thread_check check>
     class outlet_queue<check, thread_action::fifo> : public thread_trigger<t_max_outlet, check> {
 
         struct tagged_atoms {
-            message_type m_type;
-            atoms        m_as;
+            message_type                 m_type;
+            atoms                        m_as;
+            atom_ring::clock::time_point m_queued;
         };
 
     public:
-        explicit outlet_queue(const t_max_outlet a_maxoutlet)
+        explicit outlet_queue(const t_max_outlet a_maxoutlet, const size_t an_atom_count = k_outlet_queue_atom_count)
         : thread_trigger<t_max_outlet, check>(a_maxoutlet)
+        , m_ring { k_outlet_fifo_capacity, std::max(an_atom_count, k_outlet_queue_atom_count) }
         {}
 
+
+        /// Change the capacity and overflow policy of the queue.
+        /// This is not threadsafe: call it only when no other thread is using the outlet, e.g. from the owning object's constructor.
+        /// @param	a_capacity	The number of values the queue holds before the overflow policy applies. Rounded up to a power of two.
+        /// @param	a_policy	What to do when a value is sent while the queue is full.
+
+        void configure(const size_t a_capacity, const queue_overflow a_policy) {
+            m_ring.configure(a_capacity, m_ring.atom_count());
+            m_policy = a_policy;
+        }
+
+
+        /// The statistics of the queue since the outlet was created.
+        /// Threadsafe, though the figures may be slightly out of step with each other while values are being sent.
+
+        outlet_queue_stats stats() const {
+            const auto sent = m_sent.load(std::memory_order_relaxed);
+
+            return {
+                m_ring.capacity(),
+                m_high_water.load(std::memory_order_relaxed),
+                m_dropped.load(std::memory_order_relaxed),
+                m_overflowed.load(std::memory_order_relaxed),
+                sent,
+                std::chrono::nanoseconds(sent ? m_total_latency.load(std::memory_order_relaxed) / sent : 0),
+                std::chrono::nanoseconds(m_longest_latency.load(std::memory_order_relaxed))
+            };
+        }
+
+
         void callback() {
-            tagged_atoms tas;
-            while (m_values.try_dequeue(tas)) {
-                if (tas.m_type == message_type::int_argument)
-                    outlet_do_send<max::t_atom_long>(this->m_baton, tas.m_as[0]);
-                else if (tas.m_type == message_type::float_argument)
-                    outlet_do_send<double>(this->m_baton, tas.m_as[0]);
-                else
-                    outlet_do_send(this->m_baton, tas.m_as);
+            update_high_water(m_ring.size_approx() + m_overflow_count.load(std::memory_order_acquire));
+
+            // values queued while we are sending wait for the next callback, so that a busy sender can't keep us here
+            auto count = m_ring.size_approx();
+            auto send  = [this](const message_type a_type, const atom_reference& values, const atom_ring::clock::time_point queued) {
+                outlet_do_send(this->m_baton, a_type, values);
+                add_latency(atom_ring::clock::now() - queued);
+            };
+
+            while (count-- && m_ring.try_pop(send))
+                ;
+
+            // values in the overflow list were sent after any in the ring from the same (main) thread
+            if (m_ring.size_approx() == 0) {
+                tagged_atoms tas;
+                while (m_overflow.try_dequeue(tas)) {
+                    m_overflow_count.fetch_sub(1, std::memory_order_release);
+                    send(tas.m_type, atom_reference(static_cast<long>(tas.m_as.size()), tas.m_as.data()), tas.m_queued);
+                }
+            }
+
+            if (m_ring.size_approx() || m_overflow_count.load(std::memory_order_acquire))
+                thread_trigger<t_max_outlet, check>::set();
+        }
+
+
+        void push(const message_type a_type, const atoms& as) {
+            push(a_type, as.data(), as.size());
+        }
+
+        void push(const message_type a_type, const max::t_atom* values, const size_t count) {
+            if (try_push(a_type, values, count))
+                thread_trigger<t_max_outlet, check>::set();
+            else
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    private:
+        atom_ring             m_ring;
+        queue_overflow        m_policy { queue_overflow::grow };
+        fifo<tagged_atoms>    m_overflow;    // written only by the main thread
+        std::atomic<size_t>   m_overflow_count {};
+        std::atomic<size_t>   m_high_water {};
+        std::atomic<size_t>   m_dropped {};
+        std::atomic<size_t>   m_overflowed {};
+        std::atomic<size_t>   m_sent {};
+        std::atomic<uint64_t> m_total_latency {};
+        std::atomic<uint64_t> m_longest_latency {};
+
+
+        bool try_push(const message_type a_type, const max::t_atom* values, const size_t count) {
+            if (m_policy == queue_overflow::grow && is_main_thread()) {
+                // once anything is in the overflow list new values go there too, so that they stay in order
+                if (!m_overflow_count.load(std::memory_order_acquire) && count <= m_ring.atom_count() && m_ring.try_push(a_type, values, count))
+                    return true;
+
+                m_overflow.enqueue({ a_type, atoms(values, values + count), atom_ring::clock::now() });
+                m_overflow_count.fetch_add(1, std::memory_order_release);
+                m_overflowed.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            if (count > m_ring.atom_count())
+                return false;
+
+            while (!m_ring.try_push(a_type, values, count)) {
+                if (m_policy != queue_overflow::overwrite)
+                    return false;
+                if (m_ring.try_discard())
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            return true;
+        }
+
+
+        void update_high_water(const size_t a_count) {
+            if (a_count > m_high_water.load(std::memory_order_relaxed))
+                m_high_water.store(a_count, std::memory_order_relaxed);    // only the callback writes the high-water mark
+        }
+
+
+        void add_latency(const atom_ring::clock::duration a_latency) {
+            const auto nanoseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(a_latency).count());
+
+            m_sent.fetch_add(1, std::memory_order_relaxed);
+            m_total_latency.fetch_add(nanoseconds, std::memory_order_relaxed);
+            if (nanoseconds > m_longest_latency.load(std::memory_order_relaxed))
+                m_longest_latency.store(nanoseconds, std::memory_order_relaxed);
+        }
+    };
+
+    /// The value into which an outlet with the coalesce thread_action merges the values sent to it,
+    /// as passed to an #outlet_reducer.
+    /// Its storage is allocated when the outlet is created, so a reducer may change the atoms and the size of the value,
+    /// up to its capacity, without allocating.
+
+    class coalesced_value {
+    public:
+        explicit coalesced_value(const size_t a_capacity)
+        : m_capacity { std::max<size_t>(a_capacity, 1) }
+        , m_atoms { std::make_unique<atom[]>(m_capacity) }
+        {}
+
+        coalesced_value(const coalesced_value&) = delete;
+        coalesced_value& operator=(const coalesced_value&) = delete;
+
+
+        /// The type of the value: message_type::int_argument, message_type::float_argument, or message_type::gimme for a list.
+
+        message_type type() const {
+            return m_type;
+        }
+
+
+        /// Change the type of the value, e.g. from int to float when adding a float to an int.
+
+        void set_type(const message_type a_type) {
+            m_type = a_type;
+        }
+
+
+        /// The number of atoms in the value.
+
+        size_t size() const {
+            return m_size;
+        }
+
+
+        /// The greatest number of atoms in the value.
+
+        size_t capacity() const {
+            return m_capacity;
+        }
+
+
+        /// Change the number of atoms in the value. New atoms are zero.
+        /// @param	a_size	The new number of atoms, which is limited to the capacity.
+
+        void resize(const size_t a_size) {
+            const auto size = std::min(a_size, m_capacity);
+            for (auto i = m_size; i < size; ++i)
+                m_atoms[i] = 0;
+            m_size = size;
+        }
+
+
+        /// Access an atom of the value.
+
+        atom& operator[](const size_t index) {
+            return m_atoms[index];
+        }
+
+        const atom& operator[](const size_t index) const {
+            return m_atoms[index];
+        }
+
+
+        /// The atoms of the value.
+
+        atom_reference values() const {
+            return { static_cast<long>(m_size), m_atoms.get() };
+        }
+
+
+        /// Replace the value. Called with the first value sent after the previous combined value was sent.
+
+        void assign(const message_type a_type, const max::t_atom* values, const size_t count) {
+            std::copy(values, values + count, m_atoms.get());
+            m_type = a_type;
+            m_size = count;
+        }
+
+    private:
+        size_t                  m_capacity;
+        std::unique_ptr<atom[]> m_atoms;
+        message_type            m_type { message_type::gimme };
+        size_t                  m_size {};
+    };
+
+
+    /// A function that merges a value sent to an outlet with the coalesce thread_action into the combined value.
+    /// It is called on the sending thread, so it must neither lock nor allocate if values are sent from the audio thread.
+    /// Parameters are the combined value, the type of the value sent, and the atoms of the value sent.
+    /// @see reduce_sum(), reduce_max()
+
+    using outlet_reducer = inline_function<void(coalesced_value&, message_type, const atom_reference&)>;
+
+
+    // Merge two values element by element. The result is as long as the longer of the two
+    // and is a float if either is a float, or a list if either is a list.
+    // Non-numeric atoms of the combined value are left alone.
+
+    template<class operation_type>
+    inline void reduce_elementwise(coalesced_value& accumulated, const message_type a_type, const atom_reference& values, const operation_type& operation) {
+        if (a_type == message_type::gimme || accumulated.type() == message_type::gimme)
+            accumulated.set_type(message_type::gimme);
+        else if (a_type == message_type::float_argument)
+            accumulated.set_type(message_type::float_argument);
+
+        const auto size = std::min(static_cast<size_t>(values.size()), accumulated.capacity());
+        if (size > accumulated.size())
+            accumulated.resize(size);
+
+        for (auto i = 0u; i < size; ++i) {
+            auto&       a = accumulated[i];
+            const auto& b = *(values.begin() + i);
+
+            if (b.a_type == max::A_LONG && a.a_type == max::A_LONG)
+                a = operation(max::atom_getlong(&a), max::atom_getlong(&b));
+            else if ((b.a_type == max::A_LONG || b.a_type == max::A_FLOAT) && (a.a_type == max::A_LONG || a.a_type == max::A_FLOAT))
+                a = operation(max::atom_getfloat(&a), max::atom_getfloat(&b));
+        }
+    }
+
+
+    /// An #outlet_reducer that adds values, or lists element by element.
+
+    inline void reduce_sum(coalesced_value& accumulated, const message_type a_type, const atom_reference& values) {
+        reduce_elementwise(accumulated, a_type, values, [](const auto a, const auto b) { return a + b; });
+    }
+
+
+    /// An #outlet_reducer that keeps the greatest value, or the greatest value of each element of lists.
+
+    inline void reduce_max(coalesced_value& accumulated, const message_type a_type, const atom_reference& values) {
+        reduce_elementwise(accumulated, a_type, values, [](const auto a, const auto b) { return std::max(a, b); });
+    }
+
+
+    /// Merges values sent from any number of threads into a combined value that is taken by a single receiving thread,
+    /// e.g. from the audio thread or worker threads to the main thread.
+    /// Storage is allocated up front, so merging and taking values never allocates.
+    ///
+    /// The first value sent after the combined value was taken replaces it, and later values are merged into it by a reducer.
+    /// There are two combined values: senders merge into one while the receiver takes the other.
+    /// Senders take turns with a spinlock held only for the duration of the reducer,
+    /// and the receiver never holds it for longer than it takes to swap the two values.
+    /// A value is dropped (and counted) if it is longer than the capacity.
+
+    class atom_accumulator {
+    public:
+        /// Create an accumulator.
+        /// @param	a_capacity	The greatest number of atoms in a value.
+
+        explicit atom_accumulator(const size_t a_capacity)
+        : m_banks { bank { a_capacity }, bank { a_capacity } }
+        {}
+
+        atom_accumulator(const atom_accumulator&) = delete;
+        atom_accumulator& operator=(const atom_accumulator&) = delete;
+
+
+        /// Set the reducer used to merge values.
+        /// Without a reducer each value replaces the last, as with the last thread_action.
+        /// This is not threadsafe: call it only when no other thread is using the accumulator, e.g. from the owning object's constructor.
+
+        void reduce_with(const outlet_reducer& a_reducer) {
+            m_reducer = a_reducer;
+        }
+
+
+        /// Merge a value into the combined value. Threadsafe.
+        /// @param	a_type	The type of the value: message_type::int_argument, message_type::float_argument, or message_type::gimme for a list.
+        /// @param	values	The atoms of the value.
+        /// @param	count	The number of atoms in the value.
+        /// @return			True if this is the first value since the combined value was taken,
+        ///					in which case the receiver must be told to take the value.
+
+        bool merge(const message_type a_type, const max::t_atom* values, const size_t count) {
+            if (count > m_banks[0].value.capacity()) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            auto& b     = lock_active();
+            auto  first = !b.pending;
+
+            if (first || !m_reducer)
+                b.value.assign(a_type, values, count);
+            else
+                m_reducer(b.value, a_type, atom_reference(static_cast<long>(count), values));
+            b.pending = true;
+            b.busy.store(false, std::memory_order_release);
+
+            if (!first)
+                m_merged.fetch_add(1, std::memory_order_relaxed);
+            return first;
+        }
+
+
+        /// Take the combined value, if any.
+        /// Only one thread may take values from an accumulator.
+        /// @param	a_function	Called with the type of the value and the atoms of the value, which are valid only during the call.
+        /// @return				True if there was a value. Otherwise false.
+
+        template<class function_type>
+        bool take(const function_type& a_function) {
+            const auto index = m_active.load(std::memory_order_relaxed);
+            auto&      b     = m_banks[index];
+
+            // Swap the banks, then wait for a sender that may still be merging into the old one.
+            // A sender that locks the old bank after this sees that it is no longer active and moves on.
+            m_active.store(1 - index, std::memory_order_seq_cst);
+            lock(b);
+            b.busy.store(false, std::memory_order_release);
+
+            if (!b.pending)
+                return false;
+            a_function(b.value.type(), b.value.values());
+            b.pending = false;
+            return true;
+        }
+
+
+        /// The greatest number of atoms in a value.
+
+        size_t capacity() const {
+            return m_banks[0].value.capacity();
+        }
+
+
+        /// The number of values that were merged into a combined value rather than starting a new one.
+
+        size_t merged() const {
+            return m_merged.load(std::memory_order_relaxed);
+        }
+
+
+        /// The number of values dropped because they were too long.
+
+        size_t dropped() const {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct bank {
+            explicit bank(const size_t a_capacity)
+            : value { a_capacity }
+            {}
+
+            std::atomic<bool> busy { false };
+            bool              pending { false };
+            coalesced_value   value;
+        };
+
+        bank                m_banks[2];
+        std::atomic<size_t> m_active {};
+        outlet_reducer      m_reducer;
+        std::atomic<size_t> m_merged {};
+        std::atomic<size_t> m_dropped {};
+
+
+        static void lock(bank& b) {
+            auto busy = false;
+            while (!b.busy.compare_exchange_weak(busy, true, std::memory_order_acquire))
+                busy = false;
+        }
+
+
+        bank& lock_active() {
+            while (true) {
+                const auto index = m_active.load(std::memory_order_seq_cst);
+                auto&      b     = m_banks[index];
+
+                lock(b);
+                if (m_active.load(std::memory_order_seq_cst) == index)
+                    return b;
+                b.busy.store(false, std::memory_order_release);
             }
         }
+    };
+
+
+    // COALESCE: merge the values received into one with a reducer
+
+    template<thread_check check>
+    class outlet_queue<check, thread_action::coalesce> : public thread_trigger<t_max_outlet, check> {
+    public:
+        explicit outlet_queue(const t_max_outlet a_maxoutlet, const size_t an_atom_count = k_outlet_queue_atom_count)
+        : thread_trigger<t_max_outlet, check>(a_maxoutlet)
+        , m_value { std::max(an_atom_count, k_outlet_queue_atom_count) }
+        {}
+
+
+        /// Set the reducer that merges values sent from other threads between sends of the combined value.
+        /// Call it only from the owning object's constructor.
+        /// @see atom_accumulator::reduce_with()
+
+        void reduce_with(const outlet_reducer& a_reducer) {
+            m_value.reduce_with(a_reducer);
+        }
+
+        void callback() {
+            m_value.take([this](const message_type a_type, const atom_reference& values) {
+                if (!values.empty())
+                    outlet_do_send(this->m_baton, a_type, values);
+            });
+        }
 
         void push(const message_type a_type, const atoms& as) {
-            tagged_atoms tas{a_type, as};
-            m_values.enqueue(tas);
+            push(a_type, as.data(), as.size());
+        }
+
+        void push(const message_type a_type, const max::t_atom* values, const size_t count) {
+            if (m_value.merge(a_type, values, count))
+                thread_trigger<t_max_outlet, check>::set();
+        }
+
+        const atom_accumulator& storage() const {
+            return m_value;
+        }
+
+    private:
+        atom_accumulator m_value;
+    };
+
+    /// A wait-free queue of timestamped values (ints, floats, or lists of atoms) that one thread pushes to and another pops from,
+    /// e.g. from the audio thread to the scheduler thread.
+    /// All of the storage is allocated up front, so pushing and popping neither lock nor allocate.
+
+    class event_ring {
+    public:
+        /// The clock used to time events.
+
+        using clock = std::chrono::steady_clock;
+
+
+        /// Create a ring.
+        /// @param	a_capacity		The number of events the ring holds. Rounded up to a power of two.
+        /// @param	an_atom_count	The greatest number of atoms in an event.
+
+        event_ring(const size_t a_capacity, const size_t an_atom_count) {
+            size_t capacity { 2 };
+            while (capacity < a_capacity)
+                capacity <<= 1;
+
+            m_mask       = capacity - 1;
+            m_atom_count = std::max<size_t>(an_atom_count, 1);
+            m_events     = std::make_unique<event[]>(capacity);
+            m_atoms      = std::make_unique<atom[]>(capacity * m_atom_count);
+        }
+
+        event_ring(const event_ring&) = delete;
+        event_ring& operator=(const event_ring&) = delete;
+
+
+        /// Push an event onto the ring. Call this only from the producing thread.
+        /// @param	a_type	The type of the value: message_type::int_argument, message_type::float_argument, or message_type::gimme for a list.
+        /// @param	values	The atoms of the value.
+        /// @param	count	The number of atoms in the value, which must not be greater than atom_count().
+        /// @param	a_time	The time at which the value is to be sent.
+        /// @return			False if the ring is full. Otherwise true.
+
+        bool try_push(const message_type a_type, const max::t_atom* values, const size_t count, const clock::time_point a_time) {
+            const auto tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) > m_mask)
+                return false;    // full
+
+            auto& e = m_events[tail & m_mask];
+            std::copy(values, values + count, &m_atoms[(tail & m_mask) * m_atom_count]);
+            e.type  = a_type;
+            e.count = count;
+            e.time  = a_time;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+
+        /// Pop the oldest event if it is due. Call this only from the consuming thread.
+        /// @param	a_now		The current time.
+        /// @param	a_function	Called with the type of the value and the atoms of the value, which are valid only during the call.
+        /// @param	a_next		Receives the time of the oldest event if it is not yet due.
+        /// @return				True if an event was popped. False if the ring was empty or the oldest event is not yet due.
+
+        template<class function_type>
+        bool try_pop_due(const clock::time_point a_now, const function_type& a_function, clock::time_point& a_next) {
+            const auto head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire))
+                return false;    // empty
+
+            const auto& e = m_events[head & m_mask];
+            if (e.time > a_now) {
+                a_next = e.time;
+                return false;
+            }
+
+            a_function(e.type, atom_reference(static_cast<long>(e.count), &m_atoms[(head & m_mask) * m_atom_count]));
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+
+        /// The approximate number of events in the ring.
+
+        size_t size_approx() const {
+            return m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_relaxed);
+        }
+
+
+        /// The number of events the ring holds.
+
+        size_t capacity() const {
+            return m_mask + 1;
+        }
+
+
+        /// The greatest number of atoms in an event.
+
+        size_t atom_count() const {
+            return m_atom_count;
+        }
+
+    private:
+        struct event {
+            message_type      type { message_type::gimme };
+            size_t            count {};
+            clock::time_point time {};
+        };
+
+        static constexpr size_t k_cache_line { 64 };
+
+        std::unique_ptr<event[]> m_events;
+        std::unique_ptr<atom[]>  m_atoms;
+        size_t                   m_mask {};
+        size_t                   m_atom_count {};
+        std::atomic<size_t>      m_head {};
+        char                     m_head_padding[k_cache_line];
+        std::atomic<size_t>      m_tail {};
+        char                     m_tail_padding[k_cache_line];
+    };
+
+
+    /// The number of events per signal vector that an outlet with the timed thread_action can hold
+    /// for each vector of audio processed ahead of the scheduler.
+    /// @see outlet_queue<thread_check::scheduler, thread_action::timed>::configure()
+
+    static constexpr size_t k_outlet_timed_events_per_vector { 4 };
+
+
+    /// The time, in milliseconds, for which the queue of an outlet with the timed thread_action holds events
+    /// while the scheduler is unable to keep up with the audio thread.
+
+    static constexpr double k_outlet_timed_window { 100.0 };
+
+
+    // TIMED: queue timestamped values from the audio thread and send them from the scheduler when they are due
+    //
+    // Values are written into an event_ring that is allocated when the dsp chain is compiled.
+    // The outlet recognizes the audio thread from a flag set by the perform routine, without asking Max,
+    // and sending from it only writes into the ring: there are no locks and no allocation.
+    // A scheduler clock polls the ring once every signal vector (or every millisecond if the vector is shorter),
+    // sends the values that are due, and wakes up early for the next value if it is due sooner.
+    // The clock stops once every value has been sent, e.g. when dsp is turned off, and the next value pushed restarts it:
+    // that is the one call into Max made by the audio thread, and only for the first value after the outlet falls idle.
+    //
+    // The ring has a single producer, so only one thread other than the scheduler may send to the outlet.
+    //
+    // A ring allocated for a new dsp chain is handed to the scheduler, which then sends the values left in the previous ring
+    // alongside those in the new ring. The previous ring is freed when the dsp chain is compiled again,
+    // by which time the audio thread is long done with it.
+
+    template<thread_check check>
+    class outlet_queue<check, thread_action::timed> : public thread_trigger<t_max_outlet, check> {
+        static_assert(check == thread_check::scheduler, "The timed thread_action sends values from the scheduler: use it with thread_check::scheduler.");
+
+        struct events {
+            events(const size_t a_capacity, const size_t an_atom_count, const double a_samplerate, const double a_period)
+            : ring { a_capacity, an_atom_count }
+            , samplerate { a_samplerate }
+            , period { a_period }
+            {}
+
+            event_ring ring;
+            double     samplerate;    // to convert sample offsets to time
+            double     period;        // the time between polls of the ring, in milliseconds
+        };
+
+    public:
+        explicit outlet_queue(const t_max_outlet a_maxoutlet, const size_t an_atom_count = k_outlet_queue_atom_count)
+        : thread_trigger<t_max_outlet, check>(a_maxoutlet)
+        , m_atom_count { std::max(an_atom_count, k_outlet_queue_atom_count) }
+        {}
+
+        ~outlet_queue() {
+            delete m_pending.exchange(nullptr);
+        }
+
+
+        /// Change the number of events per signal vector the queue is sized for when the dsp chain is next compiled.
+        /// Call it only from the owning object's constructor.
+
+        void configure(const size_t an_events_per_vector) {
+            m_events_per_vector = std::max<size_t>(an_events_per_vector, 1);
+        }
+
+
+        /// Size the queue for the dsp chain and start the scheduler clock that sends events.
+        /// This is called on the main thread when the dsp chain is compiled.
+
+        void dspsetup(const double a_samplerate, const long a_vector_size) {
+            const auto vector_duration = a_vector_size / a_samplerate * 1000.0;
+            const auto vector_count    = static_cast<size_t>(std::ceil(k_outlet_timed_window / vector_duration));
+            const auto capacity        = std::max<size_t>(vector_count * m_events_per_vector, 64);
+
+            delete m_pending.exchange(new events { capacity, m_atom_count, a_samplerate, std::max(vector_duration, 1.0) }, std::memory_order_acq_rel);
+            m_clock_running.store(true, std::memory_order_seq_cst);
             thread_trigger<t_max_outlet, check>::set();
         }
 
 
+        /// Set the offset from now, in samples, at which the next value sent from the audio thread is to be sent out of the outlet,
+        /// e.g. the index of the sample in the vector being processed.
+        /// Call it only from the thread that sends to the outlet.
+
+        void offset(const size_t a_sample_offset) {
+            m_offset = a_sample_offset;
+        }
+
+        void callback() {
+            const auto now  = event_ring::clock::now();
+            auto       next = event_ring::clock::time_point::max();
+            auto       send = [this](const message_type a_type, const atom_reference& values) {
+                outlet_do_send(this->m_baton, a_type, values);
+            };
+
+            if (m_previous) {
+                while (m_previous->ring.try_pop_due(now, send, next))
+                    ;
+            }
+
+            // start using a ring allocated for a new dsp chain once the values in the ring before last are sent
+            if (m_pending.load(std::memory_order_acquire) && (!m_previous || m_previous->ring.size_approx() == 0))
+                adopt_pending();
+
+            if (m_current) {
+                while (m_current->ring.try_pop_due(now, send, next))
+                    ;
+            }
+
+            // stop the clock when there is nothing left to send, unless a value was pushed while it was stopping
+            if (idle()) {
+                m_clock_running.store(false, std::memory_order_seq_cst);
+                if (idle() || m_clock_running.exchange(true, std::memory_order_seq_cst))
+                    return;
+            }
+
+            const auto period = m_current ? m_current->period : 1.0;
+            const auto delay  = std::chrono::duration<double, std::milli>(next - now).count();
+            thread_trigger<t_max_outlet, check>::delay(std::min(std::max(delay, 0.0), period));
+        }
+
+        void push(const message_type a_type, const atoms& as) {
+            push(a_type, as.data(), as.size());
+        }
+
+        void push(const message_type a_type, const max::t_atom* values, const size_t count) {
+            const auto current = m_ring.load(std::memory_order_acquire);
+
+            if (current && count <= current->ring.atom_count()) {
+                const auto offset = std::chrono::duration<double>(m_offset / current->samplerate);
+                const auto time   = event_ring::clock::now() + std::chrono::duration_cast<event_ring::clock::duration>(offset);
+
+                m_offset = 0;
+                if (current->ring.try_push(a_type, values, count, time)) {
+                    // restart the clock if it has stopped; the fence orders the push before the check, as in callback()
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (!m_clock_running.load(std::memory_order_relaxed) && !m_clock_running.exchange(true, std::memory_order_seq_cst))
+                        thread_trigger<t_max_outlet, check>::set();
+                    return;
+                }
+            }
+            m_offset = 0;
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+
+        /// The ring of events waiting to be sent, or nullptr if the scheduler has not yet started using a ring.
+
+        const event_ring* storage() const {
+            const auto current = m_ring.load(std::memory_order_acquire);
+            return current ? &current->ring : nullptr;
+        }
+
+
+        /// Is the scheduler clock that sends the queued values running?
+        /// It stops when there is nothing left to send and starts again with the next value.
+
+        bool running() const {
+            return m_clock_running.load(std::memory_order_acquire);
+        }
+
+
+        /// The number of values dropped because the dsp chain had not been compiled, the queue was full, or they were too long.
+
+        size_t dropped() const {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
     private:
-        fifo<tagged_atoms> m_values;
+        size_t                  m_atom_count;
+        size_t                  m_events_per_vector { k_outlet_timed_events_per_vector };
+        size_t                  m_offset {};                 // written only by the sending thread
+        std::atomic<events*>    m_pending { nullptr };       // allocated by the main thread, adopted by the scheduler
+        std::atomic<events*>    m_ring { nullptr };          // the events the sending thread writes to
+        std::unique_ptr<events> m_current;                   // owned by the scheduler
+        std::unique_ptr<events> m_previous;                  // ...
+        std::atomic<size_t>     m_dropped {};
+        std::atomic<bool>       m_clock_running {};          // cleared by the scheduler when it stops the clock
+
+
+        // Is there nothing left for the scheduler to send, nor a ring waiting to be adopted?
+
+        bool idle() const {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return !m_pending.load(std::memory_order_acquire)
+                && (!m_current || m_current->ring.size_approx() == 0)
+                && (!m_previous || m_previous->ring.size_approx() == 0);
+        }
+
+
+        void adopt_pending() {
+            m_previous.reset(m_current.release());
+            m_current.reset(m_pending.exchange(nullptr, std::memory_order_acq_rel));
+            m_ring.store(m_current.get(), std::memory_order_release);
+        }
     };
 
 
@@ -190,6 +1405,34 @@ namespace c74::min {
     bool outlet_call_is_safe();
 
 
+    // Specializations of outlet_call_is_safe() used by the outlet<> implementation.
+    // Checking for the main thread reads a cached answer, so it costs about as little as not checking.
+    // Max is asked about the scheduler on every call, because the thread servicing it can change.
+
+    template<>
+    inline bool outlet_call_is_safe<thread_check::main>() {
+        return is_main_thread();
+    }
+
+
+    template<>
+    inline bool outlet_call_is_safe<thread_check::scheduler>() {
+        return is_scheduler_thread();
+    }
+
+
+    template<>
+    inline bool outlet_call_is_safe<thread_check::any>() {
+        return is_main_thread() || is_scheduler_thread();
+    }
+
+
+    template<>
+    inline bool outlet_call_is_safe<thread_check::none>() {
+        return true;
+    }
+
+
     // Forward declarations of the outlet.
     // Default parameters:
     //
@@ -206,17 +1449,34 @@ namespace c74::min {
 
 
     // FIRST / LAST / FIFO: queue up the data if the outlet call is not thread-safe
+    // Ints and floats are queued as a single atom, which atoms store without allocating.
 
     template<thread_check check_type, thread_action action_type, typename outlet_type>
     class handle_unsafe_outlet_send {
     public:
-        handle_unsafe_outlet_send(outlet<check_type, thread_action::fifo>* an_outlet, const outlet_type& a_value) {
-            if (typeid(outlet_type) == typeid(max::t_atom_long))
-                an_outlet->queue_storage().push(message_type::int_argument, a_value);
-            else if (typeid(outlet_type) == typeid(double))
-                an_outlet->queue_storage().push(message_type::float_argument, a_value);
-            else    // atoms
-                an_outlet->queue_storage().push(message_type::gimme, a_value);
+        handle_unsafe_outlet_send(outlet<check_type, action_type>* an_outlet, const outlet_type& a_value) {
+            push(an_outlet->queue_storage(), a_value);
+        }
+
+    private:
+        template<class queue_type>
+        static void push(queue_type& a_queue, const max::t_atom_long a_value) {
+            a_queue.push(message_type::int_argument, atoms { atom(a_value) });
+        }
+
+        template<class queue_type>
+        static void push(queue_type& a_queue, const double a_value) {
+            a_queue.push(message_type::float_argument, atoms { atom(a_value) });
+        }
+
+        template<class queue_type>
+        static void push(queue_type& a_queue, const atoms& a_value) {
+            a_queue.push(message_type::gimme, a_value);
+        }
+
+        template<class queue_type>
+        static void push(queue_type& a_queue, const atom_reference& a_value) {
+            a_queue.push(message_type::gimme, a_value.begin(), static_cast<size_t>(a_value.size()));
         }
     };
 
@@ -253,6 +1513,13 @@ namespace c74::min {
     private:
         virtual void create() = 0;
 
+        // called by min_dsp64_outlets() when the dsp chain is compiled
+
+        template<class min_class_type>
+        friend void min_dsp64_outlets(minwrap<min_class_type>* self, const double samplerate, const long maxvectorsize);
+
+        virtual void dspsetup(const double a_samplerate, const long a_vector_size) {}
+
     protected:
         t_max_outlet m_instance { nullptr };
     };
@@ -298,9 +1565,11 @@ namespace c74::min {
         /// @param a_type			Optional string defining the Max message type of the outlet for checking patch-cord connections.
         /// @param an_atom_count	Optional number of atoms that will be passed out as a list from this outlet.
         ///							When greater than 1, defining this allows memory to be pre-allocated to improve performance.
+        ///							Outlets with the first, last, or coalesce thread_action also use it to size the storage for values sent from other threads.
 
         outlet(object_base* an_owner, const string& a_description, const string& a_type = "", const size_t an_atom_count = 1)
-        : outlet_base(an_owner, a_description, a_type) {
+        : outlet_base(an_owner, a_description, a_type)
+        , m_queue_storage { this->m_instance, an_atom_count } {
             m_owner->outlets().push_back(this);
             m_accumulated_output.reserve(an_atom_count);
         }
@@ -322,7 +1591,7 @@ namespace c74::min {
         /// @param value The value to send.
 
         void send(const bool value) {
-            if (outlet_call_is_safe<check>())
+            if (call_is_safe())
                 outlet_do_send(m_instance, (max::t_atom_long)value);
             else
                 handle_unsafe_outlet_send<check, action, max::t_atom_long>(this, value);
@@ -333,7 +1602,7 @@ namespace c74::min {
         /// @param value The value to send.
 
         void send(const int value) {
-            if (outlet_call_is_safe<check>())
+            if (call_is_safe())
                 outlet_do_send(m_instance, (max::t_atom_long)value);
             else
                 handle_unsafe_outlet_send<check, action, max::t_atom_long>(this, value);
@@ -344,7 +1613,7 @@ namespace c74::min {
         /// @param value The value to send.
 
         void send(const long value) {
-            if (outlet_call_is_safe<check>())
+            if (call_is_safe())
                 outlet_do_send(m_instance, (max::t_atom_long)value);
             else
                 handle_unsafe_outlet_send<check, action, max::t_atom_long>(this, value);
@@ -355,7 +1624,7 @@ namespace c74::min {
         /// @param value The value to send.
 
         void send(const size_t value) {
-            if (outlet_call_is_safe<check>())
+            if (call_is_safe())
                 outlet_do_send(m_instance, (max::t_atom_long)value);
             else
                 handle_unsafe_outlet_send<check, action, max::t_atom_long>(this, value);
@@ -366,7 +1635,7 @@ namespace c74::min {
         /// @param value The value to send.
 
         void send(const float value) {
-            if (outlet_call_is_safe<check>())
+            if (call_is_safe())
                 outlet_do_send(m_instance, (double)value);
             else
                 handle_unsafe_outlet_send<check, action, double>(this, value);
@@ -377,7 +1646,7 @@ namespace c74::min {
         /// @param value The value to send.
 
         void send(const double value) {
-            if (outlet_call_is_safe<check>())
+            if (call_is_safe())
                 outlet_do_send(m_instance, (double)value);
             else
                 handle_unsafe_outlet_send<check, action, double>(this, value);
@@ -391,13 +1660,53 @@ namespace c74::min {
             if (value.empty())
                 return;
 
-            if (outlet_call_is_safe<check>())
+            if (call_is_safe())
                 outlet_do_send(m_instance, value);
             else
                 handle_unsafe_outlet_send<check, action, atoms>(this, value);
         }
 
 
+        /// Send an array of numbers out an outlet as a list, without first building atoms.
+        /// The numbers are converted into a buffer of atoms kept by the outlet,
+        /// so once the buffer has grown to the length of the list sending does not allocate.
+        /// @param values	The numbers to send, e.g. doubles or longs.
+        /// @param count	The number of numbers.
+
+        template<class value_type, class count_type, class number_type = typename std::remove_const<value_type>::type, typename enable_if<
+            std::is_arithmetic<number_type>::value && !is_same<number_type, bool>::value && !is_same<number_type, char>::value
+            && std::is_integral<count_type>::value, int>::type = 0>
+        void send(value_type* values, const count_type count) {
+            if (count <= 0)
+                return;
+
+            const auto                  size { static_cast<size_t>(count) };
+            const outlet_scratch::lease scratch { m_scratch, size };
+
+            outlet_convert(scratch.data(), values, size);
+            if (call_is_safe())
+                outlet_do_send(m_instance, scratch.data(), size);
+            else
+                handle_unsafe_outlet_send<check, action, atom_reference>(this, atom_reference(static_cast<long>(size), scratch.data()));
+        }
+
+
+        /// Send numbers out an outlet as a list, without first building atoms.
+        /// @param values The numbers to send.
+
+        void send(const numbers& values) {
+            send(values.data(), values.size());
+        }
+
+
+        /// Send ints out an outlet as a list, without first building atoms.
+        /// @param values The ints to send.
+
+        void send(const ints& values) {
+            send(values.data(), values.size());
+        }
+
+
         /// Send values out an outlet
         /// @param args The values to send.
 
@@ -417,9 +1726,53 @@ namespace c74::min {
             send(args...);
         }
 
+
+        /// Send values out an outlet with the timed thread_action at a given sample of the vector being processed.
+        /// When called from the audio thread the values are sent from the scheduler thread that many samples after now.
+        /// @param a_sample_offset	The offset in samples, e.g. the index of the sample in the vector.
+        /// @param args				The values to send.
+
+        template<thread_action action_type = action, typename enable_if<action_type == thread_action::timed, int>::type = 0, typename... ARGS>
+        void send_at(const size_t a_sample_offset, ARGS... args) {
+            m_queue_storage.offset(a_sample_offset);
+            send(args...);
+            m_queue_storage.offset(0);    // when sent directly the offset is not used, and must not apply to the next value
+        }
+
+
+        /// The queue that holds values sent from threads other than those allowed by the outlet's thread_check
+        /// until they can be sent from the right thread.
+        /// For an outlet with the fifo thread_action this may be used to configure() the queue or to get its stats(),
+        /// for an outlet with the coalesce thread_action to set the reducer with reduce_with(),
+        /// and for an outlet with the timed thread_action to configure() the number of events per vector.
+
+        outlet_queue<check, action>& queue() {
+            return m_queue_storage;
+        }
+
+        const outlet_queue<check, action>& queue() const {
+            return m_queue_storage;
+        }
+
     private:
         atoms                       m_accumulated_output;
-        outlet_queue<check, action> m_queue_storage { this->m_instance };
+        outlet_queue<check, action> m_queue_storage;
+        outlet_scratch              m_scratch;
+
+
+        // Can values be sent out of the outlet directly from the calling thread?
+        // Values sent to an outlet with the timed thread_action from the audio thread are always queued,
+        // and the audio thread is recognized without asking Max, so sending from the perform routine makes no calls into Max.
+
+        template<thread_action action_type = action, typename enable_if<action_type == thread_action::timed, int>::type = 0>
+        bool call_is_safe() const {
+            return !is_audio_thread() && outlet_call_is_safe<check>();
+        }
+
+        template<thread_action action_type = action, typename enable_if<action_type != thread_action::timed, int>::type = 0>
+        bool call_is_safe() const {
+            return outlet_call_is_safe<check>();
+        }
 
 
         // called by object_base::create_outlets() when the owning object is constructed
@@ -433,6 +1786,21 @@ namespace c74::min {
         }
 
 
+        // called by min_dsp64_outlets() when the dsp chain is compiled
+
+        void dspsetup(const double a_samplerate, const long a_vector_size) override {
+            queue_dspsetup(a_samplerate, a_vector_size);
+        }
+
+        template<thread_action action_type = action, typename enable_if<action_type == thread_action::timed, int>::type = 0>
+        void queue_dspsetup(const double a_samplerate, const long a_vector_size) {
+            m_queue_storage.dspsetup(a_samplerate, a_vector_size);
+        }
+
+        template<thread_action action_type = action, typename enable_if<action_type != thread_action::timed, int>::type = 0>
+        void queue_dspsetup(const double a_samplerate, const long a_vector_size) {}
+
+
         // outlet_queue is drained by handle_unsafe_outlet_send()
 
         template<thread_check check_type, thread_action action_type, typename outlet_type>
@@ -0,0 +1,433 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#pragma once
+
+namespace c74::min {
+
+
+    namespace detail {
+
+        // The number of coefficients in each half-band filter that are neither zero nor the center coefficient of 0.5.
+        // The filter is 2 * k_halfband_tap_count - 1 samples long and delays its input by k_halfband_tap_count - 1 samples.
+
+        static constexpr size_t k_halfband_tap_count { 16 };
+
+
+        // The Bessel function used to make a Kaiser window.
+
+        inline double bessel_i0(const double x) {
+            double sum { 1.0 };
+            double term { 1.0 };
+            for (auto k = 1; k < 32; ++k) {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum += term;
+            }
+            return sum;
+        }
+
+
+        // The coefficients of a half-band lowpass filter: a sinc with its cutoff at a quarter of the samplerate, and a Kaiser window.
+        // Every other coefficient of such a filter is zero, and the center coefficient is 0.5, so only the others are kept.
+        // They are symmetric, and sum to 0.5 for unity gain.
+
+        inline const std::array<sample, k_halfband_tap_count>& halfband_taps() {
+            static const auto taps = [] {
+                constexpr double beta { 8.0 };
+                constexpr double center { (k_halfband_tap_count - 1) / 2.0 };    // in units of two samples
+
+                std::array<sample, k_halfband_tap_count> coefficients {};
+                double                                   sum {};
+
+                for (auto j = 0u; j < k_halfband_tap_count; ++j) {
+                    const auto offset { 2.0 * (j - center) };    // an odd number of samples from the center
+                    const auto ratio { offset / k_halfband_tap_count };
+                    const auto window { bessel_i0(beta * std::sqrt(1.0 - ratio * ratio)) / bessel_i0(beta) };
+                    const auto phase { M_PI * offset / 2.0 };
+
+                    coefficients[j] = 0.5 * std::sin(phase) / phase * window;
+                    sum += coefficients[j];
+                }
+                for (auto& coefficient : coefficients)
+                    coefficient *= 0.5 / sum;
+                return coefficients;
+            }();
+            return taps;
+        }
+
+
+        // The most recent k_halfband_tap_count samples of a signal, written twice so that they can always be read in order
+        // from one place without wrapping around.
+
+        class halfband_history {
+        public:
+            void clear() {
+                m_samples.fill(0.0);
+                m_position = 0;
+            }
+
+            // Add a sample and return the history, oldest first.
+
+            const sample* push(const sample value) {
+                m_samples[m_position]                         = value;
+                m_samples[m_position + k_halfband_tap_count] = value;
+                m_position = (m_position + 1) % k_halfband_tap_count;
+                return &m_samples[m_position];
+            }
+
+        private:
+            std::array<sample, 2 * k_halfband_tap_count> m_samples {};
+            size_t                                       m_position {};
+        };
+
+
+        // The sum of the products of the coefficients and a history.
+        // The coefficients are symmetric, so this convolves the history with them.
+        // The products are summed in four lanes, and the lanes at the end, so that the compiler can use SIMD instructions
+        // without reordering the additions itself, which it would only do with options such as -ffast-math.
+
+        inline sample halfband_convolve(const std::array<sample, k_halfband_tap_count>& taps, const sample* history) {
+            sample sums[4] {};
+            for (auto j = 0u; j < k_halfband_tap_count; j += 4) {
+                for (auto lane = 0u; lane < 4; ++lane)
+                    sums[lane] += taps[j + lane] * history[j + lane];
+            }
+            return (sums[0] + sums[2]) + (sums[1] + sums[3]);
+        }
+
+    }    // namespace detail
+
+
+    /// Doubles the samplerate of a signal with a polyphase half-band filter.
+    /// Each input sample gives one output sample from the filter's nonzero coefficients and one delayed copy of the input,
+    /// which is all that the center coefficient contributes.
+
+    class halfband_upsampler {
+    public:
+
+        /// The delay of the output, in samples at the higher samplerate.
+
+        static constexpr size_t latency() {
+            return detail::k_halfband_tap_count - 1;
+        }
+
+
+        /// Clear the state of the filter.
+
+        void clear() {
+            m_history.clear();
+        }
+
+
+        /// Upsample a vector.
+        /// @param	source		The samples to upsample.
+        /// @param	destination	Where to write twice as many samples. It must not overlap the source.
+        /// @param	count		The number of samples to upsample.
+
+        void process(const sample* source, sample* destination, const size_t count) {
+            const auto& taps { detail::halfband_taps() };
+
+            for (auto i = 0u; i < count; ++i) {
+                const auto history { m_history.push(source[i]) };
+
+                destination[2 * i]     = 2.0 * detail::halfband_convolve(taps, history);
+                destination[2 * i + 1] = history[detail::k_halfband_tap_count / 2];
+            }
+        }
+
+    private:
+        detail::halfband_history m_history;
+    };
+
+
+    /// Halves the samplerate of a signal with a polyphase half-band filter.
+    /// Each pair of input samples gives one output sample, from the filter's nonzero coefficients applied to the even samples
+    /// and the center coefficient applied to the odd samples.
+
+    class halfband_decimator {
+    public:
+
+        /// The delay of the output, in samples at the higher samplerate.
+
+        static constexpr size_t latency() {
+            return detail::k_halfband_tap_count - 1;
+        }
+
+
+        /// Clear the state of the filter.
+
+        void clear() {
+            m_even.clear();
+            m_odd.clear();
+        }
+
+
+        /// Decimate a vector.
+        /// @param	source		The samples to decimate.
+        /// @param	destination	Where to write half as many samples. It may be the same as the source.
+        /// @param	count		The number of samples to write.
+
+        void process(const sample* source, sample* destination, const size_t count) {
+            const auto& taps { detail::halfband_taps() };
+
+            for (auto i = 0u; i < count; ++i) {
+                const auto even { m_even.push(source[2 * i]) };
+                const auto odd { m_odd.push(source[2 * i + 1]) };
+
+                destination[i] = detail::halfband_convolve(taps, even) + 0.5 * odd[detail::k_halfband_tap_count / 2 - 1];
+            }
+        }
+
+    private:
+        detail::halfband_history m_even;
+        detail::halfband_history m_odd;
+    };
+
+
+    /// The base class for all template specializations of oversampled.
+
+    class oversampled_base {};
+
+
+    /// Inherit from oversampled, in place of sample_operator, to have your call operator called at a multiple of the samplerate.
+    /// The inputs are upsampled, and the outputs decimated, by a chain of half-band filters that each double or halve the samplerate.
+    /// This reduces the aliasing of nonlinear operators such as saturators and waveshapers:
+    /// @code
+    /// class saturate : public object<saturate>, public oversampled<4, sample_operator<1, 1>> {
+    /// public:
+    ///     sample operator()(sample input) {
+    ///         return std::tanh(input * drive);
+    ///     }
+    /// };
+    /// @endcode
+    ///
+    /// The call operator is the same as that of the sample_operator, and samplerate() is the oversampled samplerate.
+    /// Smoothed values and audio inlets mapped to attributes change once for each sample at the original samplerate.
+    /// The filters delay the output by latency() samples, which the object reports to Max in answer to "getlatency".
+    ///
+    /// @tparam factor					The multiple of the samplerate: 2, 4 or 8.
+    /// @tparam sample_operator_type	The sample_operator that your class would otherwise inherit from.
+
+    template<size_t factor, class sample_operator_type>
+    class oversampled : public sample_operator_type, public oversampled_base {
+        static_assert(factor == 2 || factor == 4 || factor == 8, "the oversampling factor must be 2, 4 or 8");
+
+    public:
+        static constexpr auto k_input_count { sample_operator_type::input_count() };
+        static constexpr auto k_output_count { sample_operator_type::output_count() };
+
+
+        /// Return the multiple of the samplerate.
+        /// @return The oversampling factor.
+
+        static constexpr size_t oversampling_factor() {
+            return factor;
+        }
+
+
+        /// Return the number of filters that each double the samplerate.
+        /// @return The number of stages.
+
+        static constexpr size_t stage_count() {
+            return factor == 2 ? 1 : factor == 4 ? 2 : 3;
+        }
+
+
+        /// Return the delay of the output, in samples at the original samplerate.
+        /// The delay of the filters is made up to a whole number of samples.
+        /// @return The latency in samples.
+
+        static constexpr size_t latency() {
+            return (filter_latency() + compensation()) / factor;
+        }
+
+
+        ///	Set a new samplerate, which is multiplied by the oversampling factor.
+        /// You will not typically have any need to call this.
+        /// It is called internally any time the dsp chain containing your object is compiled.
+        /// @param	a_samplerate	The samplerate of the signal chain.
+
+        void samplerate(const double a_samplerate) {
+            sample_operator_type::samplerate(a_samplerate * factor);
+        }
+
+        using sample_operator_type::samplerate;
+
+
+        /// Allocate the buffers and clear the filters for a new vector size.
+        /// You will not typically have any need to call this.
+        /// It is called internally any time the dsp chain containing your object is compiled.
+        /// @param	a_vector_size	The largest number of samples in a vector at the original samplerate.
+
+        void dspsetup_oversampling(const size_t a_vector_size) {
+            m_vector_size = a_vector_size;
+            m_buffer.assign((k_input_count + k_output_count + 2) * a_vector_size * factor, 0.0);
+
+            for (auto& filters : m_upsamplers) {
+                for (auto& filter : filters)
+                    filter.clear();
+            }
+            for (auto& filters : m_decimators) {
+                for (auto& filter : filters)
+                    filter.clear();
+            }
+            for (auto& delay : m_delays)
+                delay.fill(0.0);
+            m_delay_position = 0;
+        }
+
+
+        /// Upsample the inputs of a vector.
+        /// You will not typically have any need to call this. It is called internally by the performer.
+        /// @param	in_chans	The inputs.
+        /// @param	frame_count	The number of samples in each input.
+        /// @return				The upsampled inputs, frame_count * factor samples each.
+
+        std::array<sample*, k_input_count + 1> upsample(const double** in_chans, const size_t frame_count) {
+            std::array<sample*, k_input_count + 1> inputs {};
+
+            for (auto inlet = 0u; inlet < k_input_count; ++inlet) {
+                const sample* source { in_chans[inlet] };
+                size_t        count { frame_count };
+
+                inputs[inlet] = buffer(inlet);
+                for (auto stage = 0u; stage < stage_count(); ++stage) {
+                    const auto last { stage + 1 == stage_count() };
+                    const auto destination { last ? inputs[inlet] : buffer(k_input_count + k_output_count + stage % 2) };
+
+                    m_upsamplers[inlet][stage].process(source, destination, count);
+                    source = destination;
+                    count *= 2;
+                }
+            }
+            return inputs;
+        }
+
+
+        /// The buffers for the oversampled outputs of a vector.
+        /// @return The buffers, frame_count * factor samples each.
+
+        std::array<sample*, k_output_count + 1> outputs() {
+            std::array<sample*, k_output_count + 1> outputs {};
+            for (auto outlet = 0u; outlet < k_output_count; ++outlet)
+                outputs[outlet] = buffer(k_input_count + outlet);
+            return outputs;
+        }
+
+
+        /// Decimate the outputs of a vector.
+        /// You will not typically have any need to call this. It is called internally by the performer.
+        /// @param	out_chans	Where to write the outputs.
+        /// @param	frame_count	The number of samples to write to each output.
+
+        void decimate(double** out_chans, const size_t frame_count) {
+            const auto outputs { this->outputs() };
+            auto       delay_position { m_delay_position };
+
+            for (auto outlet = 0u; outlet < k_output_count; ++outlet) {
+                auto source { outputs[outlet] };
+
+                delay_position = m_delay_position;
+                if (compensation() > 0) {
+                    auto& delay { m_delays[outlet] };
+                    for (auto i = 0u; i < frame_count * factor; ++i) {
+                        std::swap(source[i], delay[delay_position]);
+                        delay_position = (delay_position + 1) % std::max<size_t>(compensation(), 1);
+                    }
+                }
+
+                auto count { frame_count * factor / 2 };
+                for (auto stage = stage_count(); stage > 0; --stage) {
+                    const auto destination { stage == 1 ? out_chans[outlet] : source };
+
+                    m_decimators[outlet][stage - 1].process(source, destination, count);
+                    count /= 2;
+                }
+            }
+            m_delay_position = delay_position;
+        }
+
+    private:
+        using upsamplers = std::array<halfband_upsampler, stage_count()>;
+        using decimators = std::array<halfband_decimator, stage_count()>;
+
+        std::array<upsamplers, k_input_count>                                        m_upsamplers;
+        std::array<decimators, k_output_count>                                       m_decimators;
+        std::array<std::array<sample, std::max<size_t>(factor, 1)>, k_output_count>  m_delays {};
+        size_t                                                                       m_delay_position {};
+        size_t                                                                       m_vector_size {};
+        vector<sample>                                                               m_buffer;
+
+
+        // The delay of the filters, in samples at the oversampled samplerate.
+        // Each stage delays by the upsampler's and decimator's latency at its samplerate.
+
+        static constexpr size_t filter_latency() {
+            size_t latency {};
+            for (auto stage = 1u; stage <= stage_count(); ++stage)
+                latency += (halfband_upsampler::latency() + halfband_decimator::latency()) * (factor >> stage);
+            return latency;
+        }
+
+
+        // The delay added at the oversampled samplerate to make the latency a whole number of samples.
+
+        static constexpr size_t compensation() {
+            return (factor - filter_latency() % factor) % factor;
+        }
+
+
+        sample* buffer(const size_t index) {
+            return m_buffer.data() + index * m_vector_size * factor;
+        }
+    };
+
+
+    template<class min_class_type>
+    typename enable_if<is_base_of<oversampled_base, min_class_type>::value>::type
+    min_dsp64_oversampling(minwrap<min_class_type>* self, const long maxvectorsize) {
+        self->m_min_object.dspsetup_oversampling(maxvectorsize);
+    }
+
+
+    // The performer class wraps the C callback routine for a Max audio "perform" method.
+    // This is the version for an oversampled<> sample_operator<>, which upsamples each input for the vector,
+    // calls the call operator for each oversampled sample, and then decimates each output.
+
+    template<class min_class_type>
+    class performer<min_class_type, typename enable_if<is_base_of<oversampled_base, min_class_type>::value>::type> {
+    public:
+        static void perform(minwrap<min_class_type>* self, max::t_object* dsp64, const double** in_chans, const long numins, double** out_chans, const long numouts, const long sampleframes, const long, const void*) {
+            constexpr auto input_count { min_class_type::input_count() };
+            constexpr auto factor { min_class_type::oversampling_factor() };
+            auto&          instance { self->m_min_object };
+            auto&          attrs { instance.mapped_attributes() };
+            const auto     frame_count { static_cast<size_t>(sampleframes) };
+
+            instance.advance_smoothers(sampleframes);
+
+            const auto inputs { instance.upsample(in_chans, frame_count) };
+            auto       outputs { instance.outputs() };
+
+            for (auto frame = 0u; frame < frame_count; ++frame) {
+                instance.smoother_frame(frame);
+                attrs.write_sample(in_chans, frame);
+
+                for (auto i = frame * factor; i < (frame + 1) * factor; ++i) {
+                    callable_samples<min_class_type, input_count> ins(self);
+
+                    for (auto inlet = 0u; inlet < input_count; ++inlet)
+                        ins.set(inlet, inputs[inlet][i]);
+
+                    perform_call<min_class_type>::call(self, ins, i, outputs.data());
+                }
+            }
+
+            instance.decimate(out_chans, frame_count);
+        }
+    };
+
+
+}    // namespace c74::min
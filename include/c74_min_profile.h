@@ -0,0 +1,334 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#pragma once
+
+namespace c74::min {
+
+
+#ifdef C74_MIN_WITH_PROFILING
+
+    /// The clock used to time message calls when profiling is compiled in.
+
+    using profile_clock = std::chrono::steady_clock;
+
+
+    /// The threads on which calls are counted separately.
+
+    enum class profile_thread {
+        main,         ///< The main (low-priority) thread.
+        scheduler,    ///< The scheduler (timer) thread.
+        other         ///< Any other thread, e.g. the audio thread or a thread created by the object.
+    };
+
+
+    /// The number of #profile_thread values.
+
+    static constexpr size_t k_profile_thread_count { 3 };
+
+
+    /// The number of buckets in a #profile_counters histogram.
+    /// Bucket 0 counts durations of less than a microsecond, bucket n durations of less than 2^n microseconds,
+    /// and the last bucket everything longer.
+
+    static constexpr size_t k_profile_histogram_size { 16 };
+
+
+    /// Return the #profile_thread of the calling thread.
+
+    inline profile_thread profile_current_thread() {
+        switch (current_thread_role()) {
+            case thread_role::main:
+                return profile_thread::main;
+            case thread_role::scheduler:
+                return profile_thread::scheduler;
+            default:
+                return profile_thread::other;
+        }
+    }
+
+
+    /// Counts and times of a series of events, e.g. the calls of a message on one thread.
+    /// Adding to the counters neither locks nor allocates.
+    /// They are meant to be written mostly by a single thread, but are safe to write from several.
+
+    class profile_counters {
+    public:
+        /// Count an event.
+        /// @param	nanoseconds	The duration of the event.
+
+        void add(const uint64_t nanoseconds) {
+            m_count.fetch_add(1, std::memory_order_relaxed);
+            m_total.fetch_add(nanoseconds, std::memory_order_relaxed);
+            m_histogram[bucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+
+            auto longest = m_longest.load(std::memory_order_relaxed);
+            while (nanoseconds > longest && !m_longest.compare_exchange_weak(longest, nanoseconds, std::memory_order_relaxed))
+                ;
+        }
+
+
+        /// The number of events counted.
+
+        uint64_t count() const {
+            return m_count.load(std::memory_order_relaxed);
+        }
+
+
+        /// The sum of the durations of the events, in nanoseconds.
+
+        uint64_t total() const {
+            return m_total.load(std::memory_order_relaxed);
+        }
+
+
+        /// The duration of the longest event, in nanoseconds.
+
+        uint64_t longest() const {
+            return m_longest.load(std::memory_order_relaxed);
+        }
+
+
+        /// The number of events in a bucket of the histogram.
+        /// @param	a_bucket	The zero-based index of the bucket, less than #k_profile_histogram_size.
+
+        uint64_t histogram(const size_t a_bucket) const {
+            return m_histogram[a_bucket].load(std::memory_order_relaxed);
+        }
+
+
+        /// Return the bucket of the histogram in which an event of this duration is counted.
+
+        static size_t bucket(const uint64_t nanoseconds) {
+            auto   microseconds = nanoseconds / 1000;
+            size_t index        = 0;
+
+            while (microseconds && index < k_profile_histogram_size - 1) {
+                microseconds >>= 1;
+                ++index;
+            }
+            return index;
+        }
+
+    private:
+        std::atomic<uint64_t> m_count {};
+        std::atomic<uint64_t> m_total {};
+        std::atomic<uint64_t> m_longest {};
+        std::atomic<uint64_t> m_histogram[k_profile_histogram_size] {};
+    };
+
+
+    /// The profile of one message of a class, shared by all instances of the class.
+
+    class message_profile {
+    public:
+        /// Count a call of the message's action on the calling thread.
+        /// @param	a_duration	The time the action took.
+
+        void add_call(const profile_clock::duration a_duration) {
+            m_calls[static_cast<size_t>(profile_current_thread())].add(nanoseconds(a_duration));
+        }
+
+
+        /// Count a call that was deferred to the main thread.
+        /// @param	a_delay		The time from the call being queued to it being run.
+
+        void add_deferral(const profile_clock::duration a_delay) {
+            m_deferrals.add(nanoseconds(a_delay));
+        }
+
+
+        /// The calls of the message's action on one thread.
+
+        const profile_counters& calls(const profile_thread a_thread) const {
+            return m_calls[static_cast<size_t>(a_thread)];
+        }
+
+
+        /// The time calls spent queued before being run on the main thread.
+
+        const profile_counters& deferrals() const {
+            return m_deferrals;
+        }
+
+    private:
+        profile_counters m_calls[k_profile_thread_count];
+        profile_counters m_deferrals;
+
+        static uint64_t nanoseconds(const profile_clock::duration a_duration) {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(a_duration).count());
+        }
+    };
+
+
+    /// The profiles of the messages of a class, by slot.
+    /// Profiles are only ever added, and never move once added, so a message may keep a pointer to its own.
+
+    class class_profile {
+    public:
+        /// Return the profile of the message registered at a slot, adding it if necessary.
+        /// Call this only from the main thread, e.g. when an instance is created.
+
+        message_profile& message(const size_t a_slot) {
+            while (m_messages.size() <= a_slot)
+                m_messages.emplace_back();
+            return m_messages[a_slot];
+        }
+
+
+        /// The number of message profiles.
+
+        size_t size() const {
+            return m_messages.size();
+        }
+
+
+        /// The profile of the message registered at a slot.
+
+        const message_profile& operator[](const size_t a_slot) const {
+            return m_messages[a_slot];
+        }
+
+    private:
+        std::deque<message_profile> m_messages;
+    };
+
+
+    /// Times a call of a message's action for as long as the scope is alive.
+
+    class profile_scope {
+    public:
+        explicit profile_scope(message_profile* a_profile)
+        : m_profile { a_profile }
+        , m_start { profile_clock::now() }
+        {}
+
+        profile_scope(const profile_scope&) = delete;
+        profile_scope& operator=(const profile_scope&) = delete;
+
+        ~profile_scope() {
+            if (m_profile)
+                m_profile->add_call(profile_clock::now() - m_start);
+        }
+
+    private:
+        message_profile*          m_profile;
+        profile_clock::time_point m_start;
+    };
+
+
+    /// The time taken by the perform routine of one audio object, measured once for each vector.
+    /// Only the audio thread adds measurements, so adding them neither locks nor allocates.
+
+    class dsp_load {
+    public:
+        /// Set the samplerate, against which the duration of each vector is measured.
+        /// Called when the dsp chain is compiled.
+
+        void dspsetup(const double a_samplerate) {
+            m_samplerate.store(a_samplerate, std::memory_order_relaxed);
+        }
+
+
+        /// Count a call of the perform routine.
+        /// A call with no frames, or made before there is a samplerate, has no duration to measure the load against and is not counted.
+        /// @param	a_duration		The time the call took.
+        /// @param	a_frame_count	The number of frames it processed.
+
+        void add(const profile_clock::duration a_duration, const long a_frame_count) {
+            const auto samplerate { m_samplerate.load(std::memory_order_relaxed) };
+
+            if (a_frame_count <= 0 || !(samplerate > 0.0))
+                return;
+
+            const auto nanoseconds { static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(a_duration).count()) };
+            const auto vector_duration { a_frame_count * 1.0e9 / samplerate };
+            const auto load { nanoseconds / vector_duration };
+            const auto recent { m_recent.load(std::memory_order_relaxed) };
+
+            m_vectors.add(nanoseconds);
+            m_frames.fetch_add(static_cast<uint64_t>(a_frame_count), std::memory_order_relaxed);
+            m_recent.store(recent + (load - recent) * k_recent_coefficient, std::memory_order_relaxed);
+            if (load > m_peak.load(std::memory_order_relaxed))
+                m_peak.store(load, std::memory_order_relaxed);
+        }
+
+
+        /// The calls of the perform routine: one for each vector.
+
+        const profile_counters& vectors() const {
+            return m_vectors;
+        }
+
+
+        /// The number of frames processed by all of the calls.
+
+        uint64_t frames() const {
+            return m_frames.load(std::memory_order_relaxed);
+        }
+
+
+        /// The time taken by recent calls, as a fraction of the duration of the vectors they processed.
+        /// This is an average that gives half of its weight to about the last 64 vectors.
+
+        double recent() const {
+            return m_recent.load(std::memory_order_relaxed);
+        }
+
+
+        /// The largest fraction of the duration of a vector taken by any call.
+
+        double peak() const {
+            return m_peak.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr double k_recent_coefficient { 0.0108 };    // 1 - 0.5^(1/64)
+
+        profile_counters      m_vectors;
+        std::atomic<uint64_t> m_frames {};
+        std::atomic<double>   m_samplerate { 44100.0 };
+        std::atomic<double>   m_recent {};
+        std::atomic<double>   m_peak {};
+    };
+
+
+    /// Times a call of a perform routine for as long as the scope is alive.
+
+    class dsp_load_scope {
+    public:
+        dsp_load_scope(dsp_load& a_load, const long a_frame_count)
+        : m_load { a_load }
+        , m_frame_count { a_frame_count }
+        , m_start { profile_clock::now() }
+        {}
+
+        dsp_load_scope(const dsp_load_scope&) = delete;
+        dsp_load_scope& operator=(const dsp_load_scope&) = delete;
+
+        ~dsp_load_scope() {
+            m_load.add(profile_clock::now() - m_start, m_frame_count);
+        }
+
+    private:
+        dsp_load&                 m_load;
+        const long                m_frame_count;
+        profile_clock::time_point m_start;
+    };
+
+#else
+
+    // Without profiling, timing a call compiles to nothing.
+
+    class profile_scope {
+    public:
+        profile_scope() {}
+        ~profile_scope() {}
+    };
+
+#endif    // C74_MIN_WITH_PROFILING
+
+
+}    // namespace c74::min
@@ -0,0 +1,476 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#pragma once
+
+#include "c74_min_api.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <new>
+#include <random>
+
+
+namespace c74::min {
+
+
+    /// The result of rendering audio through an instance of an audio class.
+    /// @see audio_render
+
+    struct render_report {
+        double                samplerate {};          ///< The samplerate of the dsp chain, in hz.
+        long                  vector_size {};         ///< The number of frames in each call of the perform routine.
+        size_t                frame_count {};         ///< The number of frames rendered.
+        double                elapsed {};             ///< The time spent in the perform routine, in seconds.
+        double                longest_vector {};      ///< The time taken by the slowest call of the perform routine, in seconds.
+        std::optional<size_t> allocations;            ///< The allocations made by the perform routine, if they were counted.
+
+
+        /// The average time taken to process one frame, in nanoseconds, or 0 if no frames were rendered.
+
+        double ns_per_sample() const {
+            return frame_count ? elapsed * 1.0e9 / frame_count : 0.0;
+        }
+
+
+        /// How many times faster than realtime the audio was rendered, or 0 if no time was measured.
+
+        double realtime_multiple() const {
+            return elapsed > 0.0 && samplerate > 0.0 ? frame_count / samplerate / elapsed : 0.0;
+        }
+
+
+        /// The time taken by the slowest call of the perform routine, as a fraction of the duration of a vector.
+        /// Above 1.0 that call would have missed its deadline in a realtime audio thread.
+        /// 0 if the vector size is 0.
+
+        double longest_vector_load() const {
+            return vector_size ? longest_vector * samplerate / vector_size : 0.0;
+        }
+    };
+
+
+    /// Print a report in a form meant for reading.
+
+    inline std::ostream& operator<<(std::ostream& stream, const render_report& report) {
+        stream << report.frame_count << " frames at " << report.samplerate << " hz in vectors of " << report.vector_size << std::endl;
+        stream << std::fixed << std::setprecision(2);
+        stream << "  " << report.ns_per_sample() << " ns per sample" << std::endl;
+        stream << "  " << report.realtime_multiple() << " times realtime" << std::endl;
+        stream << "  " << report.longest_vector_load() * 100.0 << "% of a vector's duration for the slowest vector" << std::endl;
+        if (report.allocations)
+            stream << "  " << *report.allocations << " allocations in the perform routine" << std::endl;
+        else
+            stream << "  allocations not counted" << std::endl;
+        return stream;
+    }
+
+
+    /// Read an uncompressed WAV file: 16, 24 or 32-bit integer, or 32 or 64-bit floating-point samples.
+    /// @param	path		The path of the file.
+    /// @param	samplerate	If not null, set to the samplerate of the file.
+    /// @return				The samples of each channel of the file.
+    /// @throw	std::runtime_error if the file cannot be read or is not in one of these formats.
+
+    inline std::vector<numbers> read_wave_file(const std::string& path, double* samplerate = nullptr) {
+        std::ifstream file { path, std::ios::binary };
+        if (!file)
+            throw std::runtime_error("cannot open " + path);
+
+        const std::vector<unsigned char> bytes { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+        auto little_endian = [&](const size_t offset, const size_t size) {
+            uint64_t value {};
+            for (auto i = 0u; i < size; ++i)
+                value |= uint64_t(bytes[offset + i]) << (8 * i);
+            return value;
+        };
+
+        if (bytes.size() < 12 || std::string(bytes.begin(), bytes.begin() + 4) != "RIFF" || std::string(bytes.begin() + 8, bytes.begin() + 12) != "WAVE")
+            throw std::runtime_error(path + " is not a WAV file");
+
+        size_t format {};
+        size_t channel_count {};
+        size_t bits {};
+        size_t data_offset {};
+        size_t data_size {};
+
+        for (size_t offset = 12; offset + 8 <= bytes.size();) {
+            const std::string id(bytes.begin() + offset, bytes.begin() + offset + 4);
+            const auto        size { static_cast<size_t>(little_endian(offset + 4, 4)) };
+
+            if (id == "fmt " && size >= 16 && offset + 8 + size <= bytes.size()) {
+                format        = little_endian(offset + 8, 2);
+                channel_count = little_endian(offset + 10, 2);
+                bits          = little_endian(offset + 22, 2);
+                if (samplerate)
+                    *samplerate = static_cast<double>(little_endian(offset + 12, 4));
+                if (format == 0xFFFE && size >= 26)    // WAVE_FORMAT_EXTENSIBLE, whose sub-format begins with the format code
+                    format = little_endian(offset + 32, 2);
+            }
+            else if (id == "data") {
+                data_offset = offset + 8;
+                data_size   = std::min(size, bytes.size() - data_offset);
+            }
+            offset += 8 + size + (size & 1);
+        }
+
+        const auto integer { format == 1 && (bits == 16 || bits == 24 || bits == 32) };
+        const auto floating_point { format == 3 && (bits == 32 || bits == 64) };
+
+        if (!channel_count || !data_offset || !(integer || floating_point))
+            throw std::runtime_error(path + " is not an uncompressed WAV file");
+
+        const auto           sample_size { bits / 8 };
+        const auto           frame_count { data_size / (sample_size * channel_count) };
+        std::vector<numbers> channels(channel_count, numbers(frame_count));
+
+        for (auto frame = 0u; frame < frame_count; ++frame) {
+            for (auto channel = 0u; channel < channel_count; ++channel) {
+                const auto value { little_endian(data_offset + (frame * channel_count + channel) * sample_size, sample_size) };
+                auto&      sample { channels[channel][frame] };
+
+                if (integer)    // sign-extend, then scale to [-1, 1)
+                    sample = static_cast<int64_t>(value << (64 - bits)) / std::pow(2.0, 63);
+                else if (bits == 32) {
+                    float f;
+                    auto  v { static_cast<uint32_t>(value) };
+                    std::memcpy(&f, &v, sizeof f);
+                    sample = f;
+                }
+                else
+                    std::memcpy(&sample, &value, sizeof sample);
+            }
+        }
+        return channels;
+    }
+
+
+    // Used internally by audio_render to count allocations with a counter type, or not at all.
+
+    template<class allocation_counter_type>
+    class render_allocations {
+    public:
+        std::optional<size_t> count() const {
+            return m_counter.count();
+        }
+
+    private:
+        allocation_counter_type m_counter;
+    };
+
+    template<>
+    class render_allocations<void> {
+    public:
+        std::optional<size_t> count() const {
+            return {};
+        }
+    };
+
+
+    /// Render audio offline through an instance of an audio class, along the path that Max uses:
+    /// the dsp chain is set up as by the "dsp64" message and the same perform routine is called for each vector.
+    /// Each inlet and outlet has one channel.
+    ///
+    /// The class must be registered first, e.g. by calling the ext_main() defined by #MIN_EXTERNAL,
+    /// or by calling wrap_as_max_external().
+    /// @tparam	min_class_type	The audio class to render, which extends min::object<>.
+
+    template<class min_class_type>
+    class audio_render {
+    public:
+        /// Create an instance of the class and set up its dsp chain.
+        /// @param	a_samplerate	The samplerate in hz.
+        /// @param	a_vector_size	The number of frames processed by each call of the perform routine.
+        /// @param	args			The arguments with which the instance is created.
+
+        explicit audio_render(const double a_samplerate = 44100.0, const long a_vector_size = 64, const atoms& args = {})
+        : m_samplerate { a_samplerate }
+        , m_vector_size { a_vector_size }
+        {
+            m_self = wrapper_new<min_class_type>(symbol("render"), static_cast<long>(args.size()), args.data());
+
+            const auto& instance { m_self->m_min_object };
+            const auto  output_count { std::count_if(instance.outlets().begin(), instance.outlets().end(), [](const outlet_base* an_outlet) {
+                return an_outlet->type() == "signal" || an_outlet->type() == "multichannelsignal";
+            }) };
+
+            m_inputs.resize(instance.inlets().size());
+            m_input_vectors.assign(m_inputs.size(), numbers(m_vector_size));
+            m_outputs.resize(output_count);
+            m_output_vectors.assign(m_outputs.size(), numbers(m_vector_size));
+
+            for (auto& channel : m_input_vectors)
+                m_input_pointers.push_back(channel.data());
+            for (auto& channel : m_output_vectors)
+                m_output_pointers.push_back(channel.data());
+
+            std::vector<short> connected(instance.inlets().size() + instance.outlets().size(), 1);
+            min_dsp64_sel<min_class_type>(m_self, connected.data(), m_samplerate, m_vector_size);
+            m_perform = min_perform_routine<min_class_type>();
+        }
+
+        audio_render(const audio_render&) = delete;
+        audio_render& operator=(const audio_render&) = delete;
+
+
+        /// Free the instance.
+
+        ~audio_render() {
+            max::object_free(m_self);
+        }
+
+
+        /// The instance being rendered.
+
+        min_class_type& instance() {
+            return m_self->m_min_object;
+        }
+
+
+        /// The number of signal inlets.
+
+        size_t input_count() const {
+            return m_inputs.size();
+        }
+
+
+        /// The number of signal outlets.
+
+        size_t output_count() const {
+            return m_outputs.size();
+        }
+
+
+        /// Set the audio fed to an inlet. It is repeated for as long as is rendered, and inlets without audio are silent.
+        /// @param	inlet		The zero-based index of the inlet.
+        /// @param	samples		The samples fed to the inlet.
+
+        void input(const size_t inlet, numbers samples) {
+            m_inputs[inlet] = std::move(samples);
+        }
+
+
+        /// Generate the audio fed to an inlet.
+        /// @param	inlet		The zero-based index of the inlet.
+        /// @param	frame_count	The number of frames to generate before repeating.
+        /// @param	generator	A callable taking the index of a frame and returning its sample.
+
+        template<class generator_type>
+        void generate(const size_t inlet, const size_t frame_count, generator_type generator) {
+            numbers samples(frame_count);
+            for (auto i = 0u; i < frame_count; ++i)
+                samples[i] = generator(i);
+            input(inlet, std::move(samples));
+        }
+
+
+        /// The audio of an outlet from the last call of render().
+        /// @param	outlet	The zero-based index of the signal outlet.
+
+        const numbers& output(const size_t outlet) const {
+            return m_outputs[outlet];
+        }
+
+
+        /// Render audio and measure the time taken by the perform routine.
+        /// Only the calls of the perform routine are timed, and not the copying of audio to and from them.
+        /// @tparam	allocation_counter_type	A type that counts the allocations made by the calling thread from its creation,
+        ///									as returned by a count() method, or void not to count allocations.
+        /// @param	seconds					The duration to render, rounded up to a whole number of vectors.
+        /// @param	keep_output				Keep all of the rendered audio for output(), rather than discarding it.
+        /// @return							The measurements.
+
+        template<class allocation_counter_type = void>
+        render_report render(const double seconds, const bool keep_output = true) {
+            const auto vector_count { static_cast<size_t>(std::ceil(seconds * m_samplerate / m_vector_size)) };
+            const auto frame_count { vector_count * m_vector_size };
+
+            for (auto& samples : m_outputs)
+                samples.assign(keep_output ? frame_count : 0, 0.0);
+
+            render_report report { m_samplerate, m_vector_size, frame_count, 0.0, 0.0, std::nullopt };
+            const auto    self { reinterpret_cast<max::t_object*>(m_self) };
+            auto          elapsed { std::chrono::steady_clock::duration::zero() };
+            auto          longest { std::chrono::steady_clock::duration::zero() };
+
+            render_allocations<allocation_counter_type> allocations;
+
+            for (auto vector = 0u; vector < vector_count; ++vector) {
+                const auto start_frame { vector * m_vector_size };
+
+                for (auto inlet = 0u; inlet < m_inputs.size(); ++inlet)
+                    fill(m_input_vectors[inlet], m_inputs[inlet], start_frame);
+
+                const auto start { std::chrono::steady_clock::now() };
+                m_perform(self, nullptr, m_input_pointers.data(), static_cast<long>(m_input_pointers.size()), m_output_pointers.data(),
+                    static_cast<long>(m_output_pointers.size()), m_vector_size, 0, nullptr);
+                const auto duration { std::chrono::steady_clock::now() - start };
+
+                elapsed += duration;
+                longest = std::max(longest, duration);
+
+                if (keep_output) {
+                    for (auto outlet = 0u; outlet < m_outputs.size(); ++outlet)
+                        std::copy(m_output_vectors[outlet].begin(), m_output_vectors[outlet].end(), m_outputs[outlet].begin() + start_frame);
+                }
+            }
+
+            report.allocations    = allocations.count();
+            report.elapsed        = std::chrono::duration<double>(elapsed).count();
+            report.longest_vector = std::chrono::duration<double>(longest).count();
+            return report;
+        }
+
+    private:
+        minwrap<min_class_type>* m_self {};
+        double                   m_samplerate;
+        long                     m_vector_size;
+        max::t_perfroutine64     m_perform {};
+        std::vector<numbers>     m_inputs;
+        std::vector<numbers>     m_input_vectors;
+        std::vector<numbers>     m_outputs;
+        std::vector<numbers>     m_output_vectors;
+        std::vector<double*>     m_input_pointers;
+        std::vector<double*>     m_output_pointers;
+
+
+        // Copy one vector of a repeating source, or silence if the source is empty.
+
+        static void fill(numbers& vector, const numbers& source, const size_t start_frame) {
+            if (source.empty()) {
+                std::fill(vector.begin(), vector.end(), 0.0);
+                return;
+            }
+            for (auto i = 0u; i < vector.size(); ++i)
+                vector[i] = source[(start_frame + i) % source.size()];
+        }
+    };
+
+
+    /// Render audio through an audio class as directed by command-line arguments, and print the report.
+    /// This is the main() of the programs built by min-object-render.cmake, by way of #MIN_RENDER_MAIN.
+    ///
+    /// Arguments:
+    /// --seconds <duration>		The duration to render. Default is 10.
+    /// --samplerate <hz>			Default is 44100, or that of the input file.
+    /// --vectorsize <frames>		Default is 64.
+    /// --signal <name>			The signal fed to every inlet: noise, sine, impulse or silence. Default is noise.
+    /// --input <file.wav>			Feed each channel of a WAV file to an inlet, in place of the signal.
+    /// --help, -h					Print the usage and exit.
+    ///
+    /// @tparam	min_class_type			The audio class to render.
+    /// @tparam	allocation_counter_type	See audio_render::render().
+    /// @return							The exit code of the program.
+
+    template<class min_class_type, class allocation_counter_type = void>
+    int render_main(const int argc, const char* const argv[]) {
+        double      seconds { 10.0 };
+        double      samplerate { 44100.0 };
+        long        vector_size { 64 };
+        std::string signal { "noise" };
+        std::string input_path;
+
+        for (auto i = 1; i < argc; ++i) {
+            const std::string option { argv[i] };
+            const auto        has_value { i + 1 < argc };
+
+            if (option == "--seconds" && has_value)
+                seconds = std::atof(argv[++i]);
+            else if (option == "--samplerate" && has_value)
+                samplerate = std::atof(argv[++i]);
+            else if (option == "--vectorsize" && has_value)
+                vector_size = std::atol(argv[++i]);
+            else if (option == "--signal" && has_value)
+                signal = argv[++i];
+            else if (option == "--input" && has_value)
+                input_path = argv[++i];
+            else {
+                const auto help { option == "--help" || option == "-h" };
+
+                (help ? std::cout : std::cerr) << "usage: " << argv[0]
+                          << " [--seconds <duration>] [--samplerate <hz>] [--vectorsize <frames>] [--signal noise|sine|impulse|silence] [--input <file.wav>] [--help]"
+                          << std::endl;
+                return help ? EXIT_SUCCESS : EXIT_FAILURE;
+            }
+        }
+
+        try {
+            std::vector<numbers> file_channels;
+            if (!input_path.empty())
+                file_channels = read_wave_file(input_path, &samplerate);
+
+            if (seconds <= 0.0 || samplerate <= 0.0 || vector_size <= 0)
+                throw std::runtime_error("the duration, samplerate and vector size must be positive");
+
+            audio_render<min_class_type> renderer { samplerate, vector_size };
+            std::minstd_rand             random;
+
+            for (auto inlet = 0u; inlet < renderer.input_count(); ++inlet) {
+                if (!file_channels.empty())
+                    renderer.input(inlet, file_channels[inlet % file_channels.size()]);
+                else if (signal == "noise")
+                    renderer.generate(inlet, static_cast<size_t>(samplerate), [&](size_t) { return random() * 2.0 / random.max() - 1.0; });
+                else if (signal == "sine")
+                    renderer.generate(inlet, static_cast<size_t>(samplerate), [&](size_t i) { return std::sin(2.0 * M_PI * 440.0 * i / samplerate); });
+                else if (signal == "impulse")
+                    renderer.generate(inlet, static_cast<size_t>(samplerate), [](size_t i) { return i == 0 ? 1.0 : 0.0; });
+                else if (signal != "silence")
+                    throw std::runtime_error("unknown signal " + signal);
+            }
+
+            std::cout << renderer.template render<allocation_counter_type>(seconds, false);
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+
+}    // namespace c74::min
+
+
+/// Define the main() of a program that renders audio through an audio class, with the allocations of its perform routine counted.
+/// Use this once, in a file that includes the source of your external, e.g. the one generated by min-object-render.cmake.
+/// Global operator new is replaced to count allocations.
+/// @param	cpp_classname	The name of your class, as passed to #MIN_EXTERNAL.
+
+#define MIN_RENDER_MAIN(cpp_classname)                                                                                                      \
+    namespace {                                                                                                                             \
+        thread_local size_t render_allocation_total {};                                                                                     \
+                                                                                                                                            \
+        class render_allocation_counter {                                                                                                   \
+        public:                                                                                                                             \
+            size_t count() const {                                                                                                          \
+                return render_allocation_total - m_start;                                                                                   \
+            }                                                                                                                               \
+                                                                                                                                            \
+        private:                                                                                                                            \
+            size_t m_start { render_allocation_total };                                                                                     \
+        };                                                                                                                                  \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    void* operator new(size_t size) {                                                                                                       \
+        ++render_allocation_total;                                                                                                          \
+        if (auto p = std::malloc(size ? size : 1))                                                                                          \
+            return p;                                                                                                                       \
+        throw std::bad_alloc();                                                                                                             \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    void operator delete(void* p) noexcept {                                                                                                \
+        std::free(p);                                                                                                                       \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    void operator delete(void* p, size_t) noexcept {                                                                                        \
+        std::free(p);                                                                                                                       \
+    }                                                                                                                                       \
+                                                                                                                                            \
+    int main(int argc, char* argv[]) {                                                                                                      \
+        ext_main(nullptr);                                                                                                                  \
+        return c74::min::render_main<cpp_classname, render_allocation_counter>(argc, argv);                                                 \
+    }
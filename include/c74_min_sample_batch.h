@@ -0,0 +1,221 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#pragma once
+
+namespace c74::min {
+
+
+    /// A fixed number of consecutive samples that are processed together, one per SIMD lane.
+    /// Arithmetic on a batch applies to each lane, in loops of fixed length with no dependencies between lanes,
+    /// which compilers turn into SIMD instructions for the target platform.
+    /// This keeps the code portable to every compiler Min supports, which std::experimental::simd does not.
+    ///
+    /// A call operator written as a template on its sample type can thus be used for both single samples and batches:
+    /// @code
+    /// template<class T>
+    /// T operator()(T input) {
+    ///     return input * gain;
+    /// }
+    /// @endcode
+    ///
+    /// @tparam lane_count	The number of samples in the batch, typically 4 or 8.
+
+    template<size_t lane_count>
+    struct sample_batch {
+
+        /// The number of samples in the batch.
+
+        static constexpr size_t size() {
+            return lane_count;
+        }
+
+
+        /// Create a batch of zeroes.
+
+        sample_batch() = default;
+
+
+        /// Create a batch with the same value in every lane.
+
+        sample_batch(const sample value) {
+            for (auto i = 0u; i < lane_count; ++i)
+                lanes[i] = value;
+        }
+
+
+        /// Create a batch from consecutive samples in memory.
+        /// @param	a_source	A pointer to at least lane_count samples.
+
+        static sample_batch load(const sample* a_source) {
+            sample_batch batch;
+            for (auto i = 0u; i < lane_count; ++i)
+                batch.lanes[i] = a_source[i];
+            return batch;
+        }
+
+
+        /// Write the batch to consecutive samples in memory.
+        /// @param	a_destination	A pointer to at least lane_count samples.
+
+        void store(sample* a_destination) const {
+            for (auto i = 0u; i < lane_count; ++i)
+                a_destination[i] = lanes[i];
+        }
+
+
+        /// Access the sample in a lane.
+
+        sample& operator[](const size_t index) {
+            return lanes[index];
+        }
+
+        sample operator[](const size_t index) const {
+            return lanes[index];
+        }
+
+
+        sample_batch& operator+=(const sample_batch& other) {
+            for (auto i = 0u; i < lane_count; ++i)
+                lanes[i] += other.lanes[i];
+            return *this;
+        }
+
+        sample_batch& operator-=(const sample_batch& other) {
+            for (auto i = 0u; i < lane_count; ++i)
+                lanes[i] -= other.lanes[i];
+            return *this;
+        }
+
+        sample_batch& operator*=(const sample_batch& other) {
+            for (auto i = 0u; i < lane_count; ++i)
+                lanes[i] *= other.lanes[i];
+            return *this;
+        }
+
+        sample_batch& operator/=(const sample_batch& other) {
+            for (auto i = 0u; i < lane_count; ++i)
+                lanes[i] /= other.lanes[i];
+            return *this;
+        }
+
+        sample_batch operator-() const {
+            sample_batch result;
+            for (auto i = 0u; i < lane_count; ++i)
+                result.lanes[i] = -lanes[i];
+            return result;
+        }
+
+
+        sample lanes[lane_count] {};
+    };
+
+
+    // Arithmetic on batches, and on a batch and a sample, which applies to every lane.
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> operator+(sample_batch<lane_count> a, const sample_batch<lane_count>& b) {
+        return a += b;
+    }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> operator-(sample_batch<lane_count> a, const sample_batch<lane_count>& b) {
+        return a -= b;
+    }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> operator*(sample_batch<lane_count> a, const sample_batch<lane_count>& b) {
+        return a *= b;
+    }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> operator/(sample_batch<lane_count> a, const sample_batch<lane_count>& b) {
+        return a /= b;
+    }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> operator+(const sample_batch<lane_count>& a, const sample b) {
+        return a + sample_batch<lane_count>(b);
+    }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> operator+(const sample a, const sample_batch<lane_count>& b) {
+        return sample_batch<lane_count>(a) + b;
+    }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> operator-(const sample_batch<lane_count>& a, const sample b) {
+        return a - sample_batch<lane_count>(b);
+    }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> operator-(const sample a, const sample_batch<lane_count>& b) {
+        return sample_batch<lane_count>(a) - b;
+    }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> operator*(const sample_batch<lane_count>& a, const sample b) {
+        return a * sample_batch<lane_count>(b);
+    }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> operator*(const sample a, const sample_batch<lane_count>& b) {
+        return sample_batch<lane_count>(a) * b;
+    }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> operator/(const sample_batch<lane_count>& a, const sample b) {
+        return a / sample_batch<lane_count>(b);
+    }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> operator/(const sample a, const sample_batch<lane_count>& b) {
+        return sample_batch<lane_count>(a) / b;
+    }
+
+
+    // Functions of batches that apply to every lane.
+    // They are found by argument-dependent lookup, so a templated call operator can use them alongside those of the standard library:
+    //
+    // template<class T>
+    // T operator()(T input) {
+    //     using std::sqrt;
+    //     return sqrt(input);    // std::sqrt for a sample, c74::min::sqrt for a batch
+    // }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> min(const sample_batch<lane_count>& a, const sample_batch<lane_count>& b) {
+        sample_batch<lane_count> result;
+        for (auto i = 0u; i < lane_count; ++i)
+            result.lanes[i] = a.lanes[i] < b.lanes[i] ? a.lanes[i] : b.lanes[i];
+        return result;
+    }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> max(const sample_batch<lane_count>& a, const sample_batch<lane_count>& b) {
+        sample_batch<lane_count> result;
+        for (auto i = 0u; i < lane_count; ++i)
+            result.lanes[i] = a.lanes[i] > b.lanes[i] ? a.lanes[i] : b.lanes[i];
+        return result;
+    }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> abs(const sample_batch<lane_count>& a) {
+        sample_batch<lane_count> result;
+        for (auto i = 0u; i < lane_count; ++i)
+            result.lanes[i] = std::fabs(a.lanes[i]);
+        return result;
+    }
+
+    template<size_t lane_count>
+    inline sample_batch<lane_count> sqrt(const sample_batch<lane_count>& a) {
+        sample_batch<lane_count> result;
+        for (auto i = 0u; i < lane_count; ++i)
+            result.lanes[i] = std::sqrt(a.lanes[i]);
+        return result;
+    }
+
+
+}    // namespace c74::min
@@ -0,0 +1,429 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#pragma once
+
+namespace c74::min {
+
+    namespace dataspace {
+        class time;
+    }
+
+
+    /// The default time taken by a smoother to ramp to a new target, in milliseconds.
+
+    static constexpr number k_smoothing_ramp_time { 20.0 };
+
+
+    /// The shape of the ramp of a smoother.
+
+    enum class ramp_shape {
+        linear,         ///< Move by the same amount every sample, reaching the target at the end of the ramp time.
+        exponential     ///< Move by the same fraction of the remaining distance every sample, as a one-pole lowpass filter does,
+                        ///< coming within 60 dB of the target at the end of the ramp time and then jumping to it.
+    };
+
+
+    class smoother;
+
+
+    /// The smoothers of an audio object.
+    /// The object's performer advances them once per vector before calling the object, so that reading a smoothed value costs a load per sample.
+    /// sample_operator, vector_operator and mc_operator inherit from this class.
+
+    class smoother_host {
+    public:
+        /// The smoothers of the object, in the order they were created.
+
+        std::vector<smoother*>& smoothers() {
+            return m_smoothers;
+        }
+
+
+        /// Prepare the smoothers for the dsp chain.
+        /// Called on the main thread when the dsp chain is compiled.
+
+        void dspsetup_smoothers(const double a_samplerate, const long a_max_vector_size);
+
+
+        /// Compute the ramps of the smoothers for the next vector.
+        /// Called on the audio thread by the performer.
+
+        void advance_smoothers(const long a_frame_count);
+
+
+        /// Set the index in the vector of the sample being processed, from which the smoothers of a sample_operator are read.
+        /// Called on the audio thread by the performer.
+
+        void smoother_frame(const size_t a_frame) {
+            m_frame = a_frame;
+        }
+
+
+        /// Say whether the lanes of a sample_batch are channels at the same frame, as with mc_lanes, rather than consecutive frames.
+        /// Called on the audio thread by the performer.
+
+        void smoother_lanes_are_channels(const bool a_lanes_are_channels) {
+            m_lanes_are_channels = a_lanes_are_channels;
+        }
+
+    private:
+        std::vector<smoother*> m_smoothers;
+        size_t                 m_frame {};
+        bool                   m_lanes_are_channels {};
+
+        friend class smoother;
+    };
+
+
+    /// A value that ramps smoothly to new targets on the audio thread, rather than jumping to them.
+    /// A target may be set from any thread without locking or allocating.
+    /// The ramp is computed for a whole vector at a time, which the object then reads either
+    /// one sample at a time with value() in a sample_operator or as an array with ramp() in a vector_operator.
+    ///
+    /// @code
+    /// smoother m_gain { this, 1.0, 50.0, ramp_shape::exponential };
+    ///
+    /// sample operator()(sample input) {
+    ///     return input * m_gain.value();
+    /// }
+    /// @endcode
+    ///
+    /// @see smoothed_attribute
+
+    class smoother {
+    public:
+        /// Create a smoother.
+        /// @param	an_owner		The audio object whose performer advances the smoother. Typically you will pass `this`.
+        /// @param	a_value			The initial value, from which there is no ramp.
+        /// @param	a_ramp_time		The time taken to ramp to a new target, in milliseconds.
+        /// @param	a_shape			The shape of the ramp.
+
+        smoother(object_base* an_owner, const number a_value = 0.0, const number a_ramp_time = k_smoothing_ramp_time, const ramp_shape a_shape = ramp_shape::linear)
+        : m_ramp_time { a_ramp_time }
+        , m_shape { a_shape }
+        , m_posted_target { a_value }
+        , m_current { a_value }
+        , m_target { a_value }
+        , m_ramp(std::max<long>(1, c74::max::sys_getblksize()), a_value) {
+            auto host { dynamic_cast<smoother_host*>(an_owner) };
+
+            if (host) {
+                host->m_smoothers.push_back(this);
+                m_frame              = &host->m_frame;
+                m_lanes_are_channels = &host->m_lanes_are_channels;
+            }
+        }
+
+        smoother(const smoother& other) = delete;
+        smoother& operator=(const smoother& other) = delete;
+
+
+        /// Set a new target to ramp to, from any thread.
+        /// The ramp begins with the next vector.
+
+        void target(const number a_target) {
+            m_posted_target.store(a_target, std::memory_order_relaxed);
+            m_posted_count.fetch_add(1, std::memory_order_release);
+        }
+
+
+        /// The most recently set target.
+
+        number target() const {
+            return m_posted_target.load(std::memory_order_relaxed);
+        }
+
+
+        /// Set the time taken to ramp to a new target, from any thread.
+        /// A #time_value may be passed, as it converts to milliseconds. The time applies from the next target.
+        /// @param	a_ramp_time		The time in milliseconds. A time of zero jumps to new targets.
+
+        void ramp_time(const number a_ramp_time) {
+            m_ramp_time.store(a_ramp_time, std::memory_order_relaxed);
+        }
+
+
+        /// Set the time taken to ramp to a new target in a unit of the time dataspace, e.g. `ramp_time<dataspace::time::seconds>(0.1)`.
+        /// @tparam	unit_type	The unit of a_ramp_time.
+        /// @param	a_ramp_time	The time.
+
+        template<class unit_type, class dataspace_type = dataspace::time>
+        void ramp_time(const number a_ramp_time) {
+            ramp_time(dataspace_type::template convert<unit_type, typename dataspace_type::milliseconds>(a_ramp_time));
+        }
+
+
+        /// The time taken to ramp to a new target, in milliseconds.
+
+        number ramp_time() const {
+            return m_ramp_time.load(std::memory_order_relaxed);
+        }
+
+
+        /// Set the shape of the ramp, from any thread. The shape applies from the next target.
+
+        void shape(const ramp_shape a_shape) {
+            m_shape.store(a_shape, std::memory_order_relaxed);
+        }
+
+
+        /// The shape of the ramp.
+
+        ramp_shape shape() const {
+            return m_shape.load(std::memory_order_relaxed);
+        }
+
+
+        /// Prepare for the dsp chain, jumping to the current target.
+        /// Called on the main thread, while the audio thread is not running the object, when the dsp chain is compiled.
+
+        void dspsetup(const double a_samplerate, const long a_max_vector_size) {
+            m_samplerate = a_samplerate;
+            m_ramp.assign(std::max<long>(1, a_max_vector_size), 0.0);
+            m_seen_count = m_posted_count.load(std::memory_order_acquire);
+            m_target     = m_posted_target.load(std::memory_order_relaxed);
+            m_current    = m_target;
+            m_remaining  = 0;
+            m_filled     = 0;
+        }
+
+
+        /// Compute the ramp for the next vector, starting a new ramp first if a target has been set.
+        /// Called on the audio thread by the performer, once per vector.
+
+        void advance(const long a_frame_count) {
+            const auto count { m_posted_count.load(std::memory_order_acquire) };
+
+            if (count != m_seen_count) {
+                m_seen_count = count;
+                start(m_posted_target.load(std::memory_order_relaxed));
+            }
+
+            const auto frame_count { std::min(static_cast<size_t>(a_frame_count), m_ramp.size()) };
+            auto       ramp { m_ramp.data() };
+
+            if (!m_remaining) {
+                if (m_filled < frame_count) {    // a steady value only needs to be written once
+                    std::fill(ramp, ramp + frame_count, m_current);
+                    m_filled = frame_count;
+                }
+                return;
+            }
+
+            const auto ramp_count { std::min(m_remaining, frame_count) };
+
+            if (m_linear) {
+                const auto start { m_current };
+                const auto step { m_step };
+
+                for (auto i = 0u; i < ramp_count; ++i)
+                    ramp[i] = start + step * (i + 1);
+                m_current = start + step * ramp_count;
+            }
+            else {
+                auto distance { m_current - m_target };
+
+                for (auto i = 0u; i < ramp_count; ++i) {
+                    distance *= m_step;
+                    ramp[i] = m_target + distance;
+                }
+                m_current = m_target + distance;
+            }
+
+            m_remaining -= ramp_count;
+            if (!m_remaining)
+                m_current = m_target;
+            std::fill(ramp + ramp_count, ramp + frame_count, m_current);
+            m_filled = 0;
+        }
+
+
+        /// Is the value ramping to a target?
+
+        bool ramping() const {
+            return m_remaining != 0;
+        }
+
+
+        /// The ramp for the current vector, for reading in a vector_operator.
+        /// @return	The smoothed value for each sample of the vector.
+
+        const sample* ramp() const {
+            return m_ramp.data();
+        }
+
+
+        /// The smoothed value for a sample of the current vector.
+
+        sample operator[](const size_t a_frame) const {
+            return m_ramp[a_frame];
+        }
+
+
+        /// The smoothed value for the sample being processed by a sample_operator.
+        /// A call operator that takes batches may also read a batch of values, e.g. `m_gain.value<T>()` in a templated call operator.
+        /// With sample_lanes the batch holds consecutive frames of the ramp; with mc_lanes it holds the value of the frame in every lane.
+        /// @tparam	value_type	Either sample or a sample_batch<>.
+
+        template<class value_type = sample>
+        value_type value() const {
+            return read(*m_frame, static_cast<value_type*>(nullptr));
+        }
+
+    private:
+        std::atomic<number>     m_ramp_time;
+        std::atomic<ramp_shape> m_shape;
+        std::atomic<number>     m_posted_target;
+        std::atomic<uint32_t>   m_posted_count {};
+
+        // the rest are used only on the audio thread, or while it is not running the object
+
+        uint32_t                m_seen_count {};
+        double                  m_samplerate { c74::max::sys_getsr() };
+        number                  m_current;
+        number                  m_target;
+        number                  m_step {};        // the increment for a linear ramp, or the coefficient for an exponential ramp
+        bool                    m_linear { true };
+        size_t                  m_remaining {};   // the number of samples until the end of the ramp
+        size_t                  m_filled {};      // the number of samples of m_ramp that hold a steady value
+        std::vector<sample>     m_ramp;
+        const size_t*           m_frame { &k_no_frame };
+        const bool*             m_lanes_are_channels { &k_no_lanes_are_channels };
+
+        static constexpr size_t k_no_frame {};
+        static constexpr bool   k_no_lanes_are_channels {};
+
+
+        void start(const number a_target) {
+            const auto ramp_samples { static_cast<long>(m_ramp_time.load(std::memory_order_relaxed) * 0.001 * m_samplerate + 0.5) };
+
+            m_target = a_target;
+            if (ramp_samples <= 0 || m_current == m_target) {
+                m_current   = m_target;
+                m_remaining = 0;
+                m_filled    = 0;
+                return;
+            }
+
+            m_linear = m_shape.load(std::memory_order_relaxed) == ramp_shape::linear;
+            if (m_linear)
+                m_step = (m_target - m_current) / ramp_samples;
+            else
+                m_step = std::exp(std::log(0.001) / ramp_samples);
+            m_remaining = static_cast<size_t>(ramp_samples);
+        }
+
+        sample read(const size_t a_frame, sample*) const {
+            return m_ramp[a_frame];
+        }
+
+        template<size_t lane_count>
+        sample_batch<lane_count> read(const size_t a_frame, sample_batch<lane_count>*) const {
+            if (*m_lanes_are_channels)
+                return sample_batch<lane_count> { m_ramp[a_frame] };
+            return sample_batch<lane_count>::load(m_ramp.data() + a_frame);
+        }
+    };
+
+
+    inline void smoother_host::dspsetup_smoothers(const double a_samplerate, const long a_max_vector_size) {
+        for (auto a_smoother : m_smoothers)
+            a_smoother->dspsetup(a_samplerate, a_max_vector_size);
+    }
+
+
+    inline void smoother_host::advance_smoothers(const long a_frame_count) {
+        for (auto a_smoother : m_smoothers)
+            a_smoother->advance(a_frame_count);
+    }
+
+
+    /// A numeric attribute whose value is smoothed on the audio thread.
+    /// Setting the attribute, from any thread, sets the target of its smoother,
+    /// which the object reads with value() or ramp() rather than reading the attribute itself.
+    /// Configure the ramp with smoother(), e.g. `m_gain.smoother().ramp_time(50.0);` in your object's constructor.
+    ///
+    /// @code
+    /// smoothed_attribute<limit::clamp> m_gain { this, "gain", 1.0, range {0.0, 2.0} };
+    ///
+    /// sample operator()(sample input) {
+    ///     return input * m_gain.value();
+    /// }
+    /// @endcode
+    ///
+    /// @tparam	limit_type	The limit applied to the attribute's range, as for attribute<>.
+
+    template<template<typename> class limit_type = limit::none>
+    class smoothed_attribute : public attribute<number, threadsafe::yes, limit_type> {
+        using attribute_type = attribute<number, threadsafe::yes, limit_type>;
+
+    public:
+        /// Create a smoothed attribute.
+        /// @param	an_owner			The audio object that owns the attribute. Typically you will pass `this`.
+        /// @param	a_name				The name of the attribute.
+        /// @param	a_default_value		The initial value of the attribute, from which there is no ramp.
+        /// @param	args				Further properties of the attribute, as for attribute<>.
+
+        template<typename... ARGS>
+        smoothed_attribute(object_base* an_owner, const std::string a_name, const number a_default_value, ARGS... args)
+        : attribute_type(an_owner, a_name, a_default_value, args...)
+        , m_smoother { an_owner, a_default_value }
+        {}
+
+        using attribute_type::operator=;
+
+
+        /// Set the attribute and the target of its smoother.
+
+        void set(const atoms& args, const bool notify = true, const bool override_readonly = false) override {
+            attribute_type::set(args, notify, override_readonly);
+            m_smoother.target(this->get());
+        }
+
+
+        /// Samples from an audio inlet mapped to the attribute also set the target of its smoother.
+
+        attribute_sample_writer sample_writer() override {
+            m_writer = attribute_type::sample_writer();
+            if (!m_writer)
+                return {};
+            return { this, [](attribute_base* an_attribute, const sample a_value) {
+                auto self { static_cast<smoothed_attribute*>(an_attribute) };
+                self->m_writer(a_value);
+                self->m_smoother.target(self->get());
+            }};
+        }
+
+
+        /// The smoother of the attribute.
+
+        min::smoother& smoother() {
+            return m_smoother;
+        }
+
+
+        /// The smoothed value for the sample being processed by a sample_operator.
+        /// @see smoother::value()
+
+        template<class value_type = sample>
+        value_type value() const {
+            return m_smoother.template value<value_type>();
+        }
+
+
+        /// The smoothed values for the current vector, for reading in a vector_operator.
+
+        const sample* ramp() const {
+            return m_smoother.ramp();
+        }
+
+    private:
+        min::smoother           m_smoother;
+        attribute_sample_writer m_writer;
+    };
+
+
+}    // namespace c74::min
@@ -195,6 +195,7 @@ namespace c74::min {
     static const symbol k_sym_modified                  { "modified" };     ///< The symbol "modified".
     static const symbol k_sym_symbol                    { "symbol" };       ///< The symbol "symbol".
     static const symbol k_sym_list                      { "list" };         ///< The symbol "list".
+    static const symbol k_sym_anything                  { "anything" };     ///< The symbol "anything".
     static const symbol k_sym_bang                      { "bang" };         ///< The symbol "bang".
     static const symbol k_sym_getname                   { "getname" };      ///< The symbol "getname".
     static const symbol k_sym_max                       { "max" };          ///< The symbol "max" -- the max object.
@@ -7,6 +7,88 @@
 
 namespace c74::min {
 
+
+    /// The threads that Max tells apart.
+    /// @see current_thread_role()
+
+    enum class thread_role : unsigned char {
+        unknown,      ///< The thread has not been classified yet.
+        main,         ///< The main (low-priority) thread.
+        scheduler,    ///< The scheduler (timer) thread.
+        other         ///< Any other thread, e.g. the audio thread or a thread created by an object.
+    };
+
+
+    // Whether the calling thread is Max's main thread: thread_role::main or thread_role::other, found on first use.
+    // Constant-initialized, so reading it costs no more than a load from thread-local storage.
+
+    inline thread_local thread_role t_main_thread_role { thread_role::unknown };
+
+
+    /// Return true if the calling thread is Max's main thread.
+    /// Max is asked only the first time this is called on a thread, and the answer is cached for the life of the thread,
+    /// so after that this is a single load and compare. The main thread is the one thread whose identity never changes.
+
+    inline bool is_main_thread() {
+        if (t_main_thread_role == thread_role::unknown)
+            t_main_thread_role = max::systhread_ismainthread() ? thread_role::main : thread_role::other;
+        return t_main_thread_role == thread_role::main;
+    }
+
+
+    /// Return true if the calling thread is servicing the scheduler.
+    /// This is never cached: Max moves the scheduler between threads at runtime, e.g. when Overdrive is toggled,
+    /// and with Scheduler in Audio Interrupt the audio thread services it.
+
+    inline bool is_scheduler_thread() {
+        return max::systhread_istimerthread();
+    }
+
+
+    // Whether the calling thread is running the perform routine of an audio object. See audio_thread_scope.
+
+    inline thread_local bool t_in_perform_routine {};
+
+
+    /// Return true if the calling thread is running the perform routine of an audio object, i.e. it is the audio thread.
+    /// This is a single load from thread-local storage and never asks Max.
+
+    inline bool is_audio_thread() {
+        return t_in_perform_routine;
+    }
+
+
+    // Marks the calling thread as the audio thread for as long as it exists.
+    // Used by the perform routine of every audio object. See min_perform_routine().
+
+    class audio_thread_scope {
+    public:
+        audio_thread_scope()
+        : m_was_in_perform_routine { t_in_perform_routine } {
+            t_in_perform_routine = true;
+        }
+
+        ~audio_thread_scope() {
+            t_in_perform_routine = m_was_in_perform_routine;
+        }
+
+        audio_thread_scope(const audio_thread_scope&) = delete;
+        audio_thread_scope& operator=(const audio_thread_scope&) = delete;
+
+    private:
+        const bool m_was_in_perform_routine;
+    };
+
+
+    /// Return the role of the calling thread.
+    /// Only whether it is the main thread is cached. See is_main_thread() and is_scheduler_thread().
+
+    inline thread_role current_thread_role() {
+        if (is_main_thread())
+            return thread_role::main;
+        return is_scheduler_thread() ? thread_role::scheduler : thread_role::other;
+    }
+
     /// There are several places where Min may check the thread of execution
     /// either for error catching or for altering the execution.
     /// This is true, for example, in the case of outlets.
@@ -32,7 +114,9 @@ namespace c74::min {
         assert,    ///< Terminate execution
         fifo,      ///< Queue the operation(s) into a first-in-first-out buffer
         first,     ///< Queue the operation -- only queueing the first one if there are multiple
-        last       ///< Queue the operation -- only queueing the last one if there are multiple
+        last,      ///< Queue the operation -- only queueing the last one if there are multiple
+        coalesce,  ///< Queue the operation -- merging multiple operations into one with a reducer
+        timed      ///< Queue the operation from the audio thread with its time -- performing each at that time in the scheduler thread
     };
 
 
@@ -147,6 +231,14 @@ namespace c74::min {
         }
 
 
+        // Tell the trigger to fire after a delay
+        // @param a_delay The delay in milliseconds.
+
+        void delay(const double a_delay) {
+            max::clock_fdelay(m_clock, a_delay);
+        }
+
+
         // The thread_trigger interface requires both a
         // callback() for when the trigger fires
         // and a push() for handling new items.
@@ -0,0 +1,269 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#pragma once
+
+namespace c74::min {
+
+
+    /// A set of threads that help the audio thread run independent jobs, such as processing groups of channels.
+    ///
+    /// The thread calling run() takes jobs too, and waits only for jobs that a worker has already started.
+    /// A worker that is slow to wake up therefore never delays the audio thread by more than one job,
+    /// and run() neither locks nor allocates.
+    /// Workers spin for a short, configurable time after each run, expecting the next vector, and then sleep until woken.
+    /// Jobs run with the floating-point mode of the thread calling run(), so that they treat denormals the same way.
+
+    class worker_pool {
+    public:
+
+        /// The type of function that runs one job.
+        /// @param	context	The context passed to run().
+        /// @param	job		The index of the job, from 0 up to the number of jobs.
+
+        using job_function = void (*)(void* context, size_t job);
+
+
+        /// Create a pool and start its threads.
+        /// Call this from the main thread, e.g. in an object's constructor, or use the pool returned by shared().
+        /// @param	a_thread_count	The number of worker threads. With no threads, run() always returns false.
+        /// @param	a_spin_time		How long workers spin after each run before they sleep. See spin_time().
+
+        explicit worker_pool(const size_t a_thread_count, const std::chrono::microseconds a_spin_time = k_default_spin_time)
+        : m_spin_time { a_spin_time.count() }
+        {
+            m_threads.reserve(a_thread_count);
+            for (auto i = 0u; i < a_thread_count; ++i)
+                m_threads.emplace_back([this] { work(); });
+        }
+
+        worker_pool(const worker_pool&) = delete;
+        worker_pool& operator=(const worker_pool&) = delete;
+
+
+        /// Stop the threads and wait for them to finish.
+
+        ~worker_pool() {
+            shutdown();
+        }
+
+
+        /// Stop the threads and wait for them to finish, after any run in progress.
+        /// From then on run() returns false, leaving the jobs to the caller. Calling this again does nothing.
+
+        void shutdown() {
+            {
+                std::lock_guard<std::mutex> lock { m_mutex };
+                if (m_quit)
+                    return;
+                m_quit = true;
+            }
+
+            // Taking the running flag for good waits for a run in progress, and refuses any later one.
+            while (m_running.exchange(true, std::memory_order_acquire))
+                std::this_thread::yield();
+
+            m_wakeup.notify_all();
+            for (auto& thread : m_threads)
+                thread.join();
+        }
+
+
+        /// The default number of workers for a pool: a quarter of the processors, and at least one if there is a processor
+        /// besides the one running the audio thread.
+        /// The count is kept low because each external has a pool of its own (see shared()),
+        /// and the rest of the processors are left to those pools, to Max, and to other applications.
+        /// @return	The number of worker threads.
+
+        static size_t default_thread_count() {
+            const auto processors { std::max(std::thread::hardware_concurrency(), 1u) };
+            return std::min(std::max(processors / 4, 1u), processors - 1);
+        }
+
+
+        /// The pool shared by all objects of an external, with default_thread_count() workers.
+        /// The pool is a static of the code compiled into the external, so each external that uses it has a pool of its own,
+        /// and objects of different externals do not share threads.
+        /// Several externals processing at once thus run more workers than there are processors; if that matters,
+        /// lower the spin_time() of each pool, or create a pool of your own with fewer threads.
+        /// The pool is created the first time this is called, so call it first from the main thread.
+        /// Its threads are stopped when Max quits, and the pool itself is never destroyed,
+        /// because joining threads while statics are destroyed can deadlock, e.g. under the loader lock on Windows.
+        /// @return	The shared pool.
+
+        static worker_pool& shared() {
+            static worker_pool* pool { create_shared() };
+            return *pool;
+        }
+
+
+        /// How long workers spin after each run, waiting for the next one, before they sleep.
+        /// Spinning saves the time it takes to wake a sleeping thread, but burns a processor while it lasts.
+        /// About one vector period is enough to catch the next vector, e.g. set this from your object's dspsetup message.
+        /// With 0, workers sleep as soon as they run out of jobs.
+        /// @param	a_spin_time	The time to spin.
+
+        void spin_time(const std::chrono::microseconds a_spin_time) {
+            m_spin_time.store(a_spin_time.count(), std::memory_order_relaxed);
+        }
+
+
+        /// How long workers spin after each run before they sleep.
+        /// @return	The time to spin.
+
+        std::chrono::microseconds spin_time() const {
+            return std::chrono::microseconds(m_spin_time.load(std::memory_order_relaxed));
+        }
+
+
+        /// The number of worker threads, not counting the thread that calls run().
+        /// @return	The number of worker threads.
+
+        size_t thread_count() const {
+            return m_threads.size();
+        }
+
+
+        /// Run a number of jobs, spread across the workers and the calling thread, and return when all of them are done.
+        /// Only one thread at a time may run jobs in a pool.
+        /// If the pool has no workers, or another thread is running jobs in it, nothing is run.
+        /// @param	job_count	The number of jobs.
+        /// @param	function	The function that runs one job.
+        /// @param	context		Passed to each call of the function.
+        /// @return				True if the jobs were run, false if the caller should run them itself.
+
+        bool run(const size_t job_count, const job_function function, void* context) {
+            if (m_threads.empty() || m_running.exchange(true, std::memory_order_acquire))
+                return false;
+
+            m_function.store(function, std::memory_order_relaxed);
+            m_context.store(context, std::memory_order_relaxed);
+            m_job_count.store(job_count, std::memory_order_relaxed);
+            m_jobs_done.store(0, std::memory_order_relaxed);
+            m_mode.store(floating_point_mode::get(), std::memory_order_relaxed);
+
+            // Starting a new generation of jobs releases the writes above to the workers that claim them.
+            const auto generation { ((m_claim.load(std::memory_order_relaxed) >> 32) + 1) & 0xFFFFFFFF };
+            m_claim.store(generation << 32, std::memory_order_seq_cst);
+            if (m_sleeping.load(std::memory_order_seq_cst) > 0)
+                m_wakeup.notify_all();
+
+            const auto jobs_run { perform_jobs(generation) };
+            if (jobs_run < job_count) {
+                while (m_jobs_done.load(std::memory_order_acquire) < job_count - jobs_run)
+                    std::this_thread::yield();
+            }
+
+            m_running.store(false, std::memory_order_release);
+            return true;
+        }
+
+
+        /// Run a number of jobs, spread across the workers and the calling thread, and return when all of them are done.
+        /// @param	job_count	The number of jobs.
+        /// @param	job			A callable taking the index of the job. It is called by reference, so it is not copied.
+        /// @return				True if the jobs were run, false if the caller should run them itself.
+
+        template<class job_type>
+        bool run(const size_t job_count, job_type& job) {
+            return run(job_count, [](void* context, size_t index) { (*static_cast<job_type*>(context))(index); }, &job);
+        }
+
+
+    private:
+        static constexpr auto k_default_spin_time { std::chrono::microseconds(250) };    // a sixth of a 64-sample vector at 44.1 kHz
+        static constexpr auto k_sleep_timeout { std::chrono::milliseconds(2) };           // bounds the delay of a missed wakeup
+
+        std::vector<std::thread>    m_threads;
+        std::mutex                  m_mutex;
+        std::condition_variable     m_wakeup;
+        bool                        m_quit {};                  // guarded by m_mutex
+        std::atomic<int>            m_sleeping {};
+        std::atomic<bool>           m_running {};
+        std::atomic<uint64_t>       m_claim {};                 // the generation in the high 32 bits, the next job in the low 32 bits
+        std::atomic<job_function>   m_function {};
+        std::atomic<void*>          m_context {};
+        std::atomic<size_t>         m_job_count {};
+        std::atomic<size_t>         m_jobs_done {};             // by workers, in the current generation
+        std::atomic<uint64_t>       m_mode {};                  // the floating_point_mode of the caller
+        std::atomic<int64_t>        m_spin_time;                // in microseconds
+
+
+        // Create the shared pool, and stop its threads when Max quits.
+
+        static worker_pool* create_shared() {
+            auto pool { new worker_pool { default_thread_count() } };
+            max::quittask_install(reinterpret_cast<max::method>(shared_quittask), pool);
+            return pool;
+        }
+
+        static void shared_quittask(worker_pool* pool) {
+            pool->shutdown();
+        }
+
+
+        // Claim and run jobs of one generation until none are left.
+        // A generation ends only when all of its claimed jobs are done, so a job claimed here sees that generation's function.
+        // Returns the number of jobs run.
+
+        size_t perform_jobs(const uint64_t generation) {
+            size_t jobs_run {};
+            auto   claim { m_claim.load(std::memory_order_acquire) };
+
+            while ((claim >> 32) == generation && (claim & 0xFFFFFFFF) < m_job_count.load(std::memory_order_relaxed)) {
+                if (m_claim.compare_exchange_weak(claim, claim + 1, std::memory_order_acquire, std::memory_order_acquire)) {
+                    m_function.load(std::memory_order_relaxed)(m_context.load(std::memory_order_relaxed), claim & 0xFFFFFFFF);
+                    ++jobs_run;
+                    claim = m_claim.load(std::memory_order_acquire);
+                }
+            }
+            return jobs_run;
+        }
+
+
+        // Each worker spins for a while after running jobs, when the next vector is likely to come soon, and then sleeps.
+        // Sleeping workers also wake up at an interval, in case a generation was started between their check and their wait.
+
+        void work() {
+            uint64_t generation {};
+            auto     mode { floating_point_mode::get() };
+
+            while (true) {
+                const auto spin_end { std::chrono::steady_clock::now() + spin_time() };
+                auto       next_generation { m_claim.load(std::memory_order_acquire) >> 32 };
+
+                while (next_generation == generation && std::chrono::steady_clock::now() < spin_end) {
+                    std::this_thread::yield();
+                    next_generation = m_claim.load(std::memory_order_acquire) >> 32;
+                }
+
+                if (next_generation == generation) {
+                    std::unique_lock<std::mutex> lock { m_mutex };
+
+                    m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+                    next_generation = m_claim.load(std::memory_order_seq_cst) >> 32;
+                    while (!m_quit && next_generation == generation) {
+                        m_wakeup.wait_for(lock, k_sleep_timeout);
+                        next_generation = m_claim.load(std::memory_order_seq_cst) >> 32;
+                    }
+                    m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+                    if (m_quit)
+                        return;
+                }
+
+                generation = next_generation;
+                if (m_mode.load(std::memory_order_relaxed) != mode) {
+                    mode = m_mode.load(std::memory_order_relaxed);
+                    floating_point_mode::set(mode);
+                }
+                const auto jobs_run { perform_jobs(generation) };
+                if (jobs_run)
+                    m_jobs_done.fetch_add(jobs_run, std::memory_order_release);
+            }
+        }
+    };
+
+
+}    // namespace c74::min
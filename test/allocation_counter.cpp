@@ -0,0 +1,48 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#include "allocation_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+
+namespace {
+    thread_local size_t allocations {};
+    thread_local size_t allocated_bytes {};
+}
+
+
+void* operator new(size_t size) {
+    ++allocations;
+    allocated_bytes += size;
+    if (auto p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+
+allocation_counter::allocation_counter()
+: m_start { allocations }
+, m_start_bytes { allocated_bytes }
+{}
+
+allocation_counter::~allocation_counter() {}
+
+size_t allocation_counter::count() const {
+    return allocations - m_start;
+}
+
+size_t allocation_counter::bytes() const {
+    return allocated_bytes - m_start_bytes;
+}
@@ -0,0 +1,31 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#pragma once
+
+#include <cstddef>
+
+
+/// Count the heap allocations made by the current thread while an instance is in scope.
+/// Used to verify that the hot paths of Min do not allocate, and to measure the memory used by objects.
+/// Global operator new is replaced in allocation_counter.cpp for this purpose.
+
+class allocation_counter {
+public:
+    allocation_counter();
+    ~allocation_counter();
+
+    /// The number of allocations made by this thread since the counter was created.
+
+    size_t count() const;
+
+    /// The number of bytes requested by the allocations made by this thread since the counter was created.
+
+    size_t bytes() const;
+
+private:
+    size_t m_start;
+    size_t m_start_bytes;
+};
@@ -4,6 +4,7 @@
 ///	@license	Use of this source code is governed by the MIT License found in the License.md file.
 #include "catch.hpp"
 #include "c74_min_api.h"
+#include "allocation_counter.h"
 
 TEST_CASE( "Atom Class", "[atoms]" ) {
 
@@ -96,3 +97,59 @@ TEST_CASE( "Atom Class", "[atoms]" ) {
 	}
 
 }
+
+
+TEST_CASE( "Atoms Container", "[atoms]" ) {
+
+	SECTION("short lists are stored inline without allocating") {
+		allocation_counter allocations;
+
+		c74::min::atoms	as = { 1, 2.0, "foo" };
+		as.push_back(4);
+
+		c74::min::atoms	copied = as;
+		c74::min::atoms	moved = std::move(copied);
+		c74::min::atoms	assigned;
+		assigned = moved;
+		assigned.erase(assigned.begin());
+		assigned.insert(assigned.begin(), 0);
+		assigned.resize(2);
+
+		REQUIRE( allocations.count() == 0 );
+		REQUIRE( as.size() == 4 );
+		REQUIRE( moved == as );
+		REQUIRE( assigned.size() == 2 );
+		REQUIRE( (int)assigned[0] == 0 );
+		REQUIRE( (double)assigned[1] == 2.0 );
+	}
+
+	SECTION("long lists spill to the heap and keep their contents") {
+		c74::min::atoms	as;
+
+		for (auto i = 0; i < 10; ++i)
+			as.push_back(i);
+
+		REQUIRE( as.size() == 10 );
+		REQUIRE( as.capacity() >= 10 );
+		for (auto i = 0; i < 10; ++i)
+			REQUIRE( (int)as[i] == i );
+
+		c74::min::atoms	moved = std::move(as);
+		REQUIRE( moved.size() == 10 );
+		REQUIRE( as.empty() );
+
+		moved.erase(moved.begin() + 2, moved.end());
+		moved.shrink_to_fit();
+		REQUIRE( moved.capacity() == c74::min::atoms::inline_capacity );
+		REQUIRE( (int)moved[1] == 1 );
+	}
+
+	SECTION("atoms can be passed to the Max API as a t_atom array") {
+		c74::min::atoms	as = { 1, 2, 3 };
+		c74::max::t_atom* av = &as[0];
+
+		REQUIRE( av == as.data() );
+		REQUIRE( c74::max::atom_getlong(av + 2) == 3 );
+	}
+
+}
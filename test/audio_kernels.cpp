@@ -0,0 +1,207 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#include "catch.hpp"
+#include "c74_min_api.h"
+
+using namespace c74::min;
+
+
+static numbers test_signal(const size_t size, const double phase) {
+    numbers values(size);
+    for (auto i = 0u; i < size; ++i)
+        values[i] = std::sin(phase + i * 0.37) * (1.0 + i % 3);
+    return values;
+}
+
+
+static std::vector<simd_level> supported_simd_levels() {
+    std::vector<simd_level> levels;
+    for (auto level : { simd_level::scalar, simd_level::sse2, simd_level::neon, simd_level::avx2, simd_level::avx512 }) {
+        if (simd_level_supported(level))
+            levels.push_back(level);
+    }
+    return levels;
+}
+
+
+TEST_CASE ("Audio kernels give the same results for every instruction set", "[audio_kernels]") {
+    REQUIRE( simd_level_supported(audio_kernels().level) );
+
+    for (auto level : supported_simd_levels()) {
+        const auto& kernels { audio_kernels(level) };
+        INFO( "simd level " << static_cast<int>(level) );
+
+        for (size_t size : { 0, 1, 7, 67, 512 }) {
+            INFO( "size " << size );
+
+            const auto a { test_signal(size, 0.0) };
+            const auto b { test_signal(size, 1.0) };
+            numbers    out(size, 0.5);
+            numbers    expected(size, 0.5);
+
+            kernels.copy(out.data(), a.data(), size);
+            REQUIRE( out == a );
+
+            kernels.fill(out.data(), 0.25, size);
+            REQUIRE( out == numbers(size, 0.25) );
+
+            kernels.add(out.data(), a.data(), b.data(), size);
+            for (auto i = 0u; i < size; ++i)
+                REQUIRE( out[i] == a[i] + b[i] );
+
+            kernels.multiply(out.data(), a.data(), b.data(), size);
+            for (auto i = 0u; i < size; ++i)
+                REQUIRE( out[i] == a[i] * b[i] );
+
+            kernels.multiply_add(out.data(), a.data(), b.data(), size);
+            for (auto i = 0u; i < size; ++i)
+                REQUIRE( out[i] == Approx(2.0 * a[i] * b[i]) );
+
+            kernels.fill(out.data(), 1.0, size);
+            kernels.add_scaled(out.data(), a.data(), 0.5, size);
+            for (auto i = 0u; i < size; ++i)
+                REQUIRE( out[i] == Approx(1.0 + a[i] * 0.5) );
+
+            kernels.scale(out.data(), a.data(), 0.5, 0.25, size);
+            for (auto i = 0u; i < size; ++i)
+                REQUIRE( out[i] == Approx(a[i] * (0.5 + 0.25 * i)) );
+
+            sample peak {};
+            sample sum {};
+            for (auto value : a) {
+                peak = std::max(peak, std::fabs(value));
+                sum += value * value;
+            }
+            REQUIRE( kernels.peak(a.data(), size) == peak );
+            REQUIRE( kernels.sum_of_squares(a.data(), size) == Approx(sum) );
+        }
+    }
+}
+
+
+TEST_CASE ("Audio bundles and channels operate on all of their samples", "[audio_kernels]") {
+    auto    left { test_signal(67, 0.0) };
+    auto    right { test_signal(67, 1.0) };
+    double* channels[] { left.data(), right.data() };
+    numbers mono(67);
+
+    audio_bundle bundle { channels, 2, 67 };
+
+    SECTION ("a channel is a view of the bundle's samples") {
+        auto channel { bundle.channel(1) };
+
+        REQUIRE( channel.size() == 67 );
+        REQUIRE( channel.data() == right.data() );
+        REQUIRE( std::distance(channel.begin(), channel.end()) == 67 );
+
+        channel.gain(0.0, 1.0);
+        REQUIRE( right[0] == 0.0 );
+        REQUIRE( right[66] == Approx(test_signal(67, 1.0)[66] * 66.0 / 67.0) );
+    }
+
+    SECTION ("the channels are mixed down, and measured") {
+        bundle.mix_down({ mono.data(), mono.size() }, 0.5);
+
+        for (auto i = 0u; i < mono.size(); ++i)
+            REQUIRE( mono[i] == Approx((left[i] + right[i]) * 0.5) );
+
+        sample peak {};
+        sample sum {};
+        for (auto channel : { left, right }) {
+            for (auto value : channel) {
+                peak = std::max(peak, std::fabs(value));
+                sum += value * value;
+            }
+        }
+        REQUIRE( bundle.peak() == peak );
+        REQUIRE( bundle.rms() == Approx(std::sqrt(sum / 134.0)) );
+    }
+
+    SECTION ("a bundle is cleared") {
+        bundle.clear();
+
+        REQUIRE( bundle.peak() == 0.0 );
+        REQUIRE( bundle.rms() == 0.0 );
+    }
+
+    SECTION ("bundles are combined") {
+        const auto original_left { left };
+        auto       other_left { test_signal(67, 2.0) };
+        auto       other_right { test_signal(67, 3.0) };
+        double*    other_channels[] { other_left.data(), other_right.data() };
+        audio_bundle other { other_channels, 2, 67 };
+
+        bundle.add(other);
+        REQUIRE( left[10] == Approx(original_left[10] + other_left[10]) );
+
+        bundle = other;
+        bundle.multiply(other);
+        REQUIRE( left[10] == Approx(other_left[10] * other_left[10]) );
+
+        bundle.multiply_add(other, other);
+        REQUIRE( right[10] == Approx(2.0 * other_right[10] * other_right[10]) );
+    }
+}
+
+
+// Not run by default. Use `min-tests "[!benchmark]"` to compare the loops that audio_bundle used to run
+// with the kernels of each instruction set.
+
+TEST_CASE ("Audio kernels", "[audio_kernels][!benchmark]") {
+    constexpr size_t frame_count { 512 };
+    const auto       a { test_signal(frame_count, 0.0) };
+    const auto       b { test_signal(frame_count, 1.0) };
+    numbers          out(frame_count);
+
+    BENCHMARK ("clear with a loop") {
+        for (auto i = 0u; i < frame_count; ++i)
+            out[i] = 0.0;
+        return out[0];
+    };
+
+    BENCHMARK ("copy with a loop") {
+        for (auto i = 0u; i < frame_count; ++i)
+            out[i] = a[i];
+        return out[0];
+    };
+
+    BENCHMARK ("multiply-add with a loop") {
+        for (auto i = 0u; i < frame_count; ++i)
+            out[i] += a[i] * b[i];
+        return out[0];
+    };
+
+    BENCHMARK ("peak with a loop") {
+        sample peak {};
+        for (auto i = 0u; i < frame_count; ++i)
+            peak = std::max(peak, std::fabs(a[i]));
+        return peak;
+    };
+
+    for (auto level : supported_simd_levels()) {
+        const auto& kernels { audio_kernels(level) };
+        const auto  name { " with simd level " + std::to_string(static_cast<int>(level)) };
+
+        BENCHMARK ("clear" + name) {
+            kernels.fill(out.data(), 0.0, frame_count);
+            return out[0];
+        };
+
+        BENCHMARK ("copy" + name) {
+            kernels.copy(out.data(), a.data(), frame_count);
+            return out[0];
+        };
+
+        BENCHMARK ("multiply-add" + name) {
+            kernels.multiply_add(out.data(), a.data(), b.data(), frame_count);
+            return out[0];
+        };
+
+        BENCHMARK ("peak" + name) {
+            return kernels.peak(a.data(), frame_count);
+        };
+    }
+}
@@ -0,0 +1,161 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#include "catch.hpp"
+#include "c74_min_api.h"
+
+using namespace c74::min;
+
+
+// Halving the smallest normal number gives a denormal, unless denormals are flushed.
+// The operand is volatile so that the result is not computed by the compiler.
+
+static sample halved_smallest_normal() {
+    volatile sample smallest { std::numeric_limits<sample>::min() };
+    return smallest * 0.5;
+}
+
+
+TEST_CASE ("Denormal guards flush denormals while they exist", "[denormals]") {
+    if (!floating_point_mode::supported())
+        return;
+
+    const auto mode { floating_point_mode::get() };
+
+    REQUIRE( halved_smallest_normal() != 0.0 );
+    {
+        denormal_guard guard;
+        REQUIRE( halved_smallest_normal() == 0.0 );
+    }
+    REQUIRE( halved_smallest_normal() != 0.0 );
+    REQUIRE( (floating_point_mode::get() & floating_point_mode::k_flush_bits) == (mode & floating_point_mode::k_flush_bits) );
+}
+
+
+TEST_CASE ("Worker pools run jobs with the floating-point mode of the caller", "[denormals]") {
+    if (!floating_point_mode::supported())
+        return;
+
+    worker_pool      pool { 2 };
+    std::atomic<int> flushed {};
+    auto job = [&](const size_t) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (halved_smallest_normal() == 0.0)
+            ++flushed;
+    };
+
+    {
+        denormal_guard guard;
+        pool.run(16, job);
+    }
+    REQUIRE( flushed == 16 );
+
+    flushed = 0;
+    pool.run(16, job);
+    REQUIRE( flushed == 0 );
+}
+
+
+// A bank of one-pole lowpass filters with silent input, as in the tail of a reverb.
+// The states start as denormals, which take a long time to decay to zero unless they are flushed.
+
+template<denormal_flags flags>
+class decaying_tail_test : public object<decaying_tail_test<flags>>, public sample_operator<1, 1> {
+public:
+    MIN_DENORMAL_FLAGS { flags };
+
+    static constexpr size_t k_filter_count { 16 };
+
+    samples<k_filter_count> states;
+
+    void reset() {
+        for (auto i = 0u; i < k_filter_count; ++i)
+            states[i] = std::numeric_limits<sample>::min() * (i + 1) / 64.0;
+    }
+
+    sample operator()(sample input) {
+        sample output {};
+        for (auto& state : states) {
+            state = state * 0.9999 + input * 0.0001;
+            output += state;
+        }
+        return output;
+    }
+};
+
+
+template<class class_type>
+static minwrap<class_type>* new_decaying_tail_instance(const std::string& name) {
+    c74::min::wrap_as_max_external<class_type>(name.c_str(), name.c_str(), nullptr);
+    auto self { wrapper_new<class_type>(symbol(name), 0, nullptr) };
+    self->m_min_object.reset();
+    return self;
+}
+
+
+TEST_CASE ("Classes can flush denormals in their perform routine", "[denormals]") {
+    using flushing_type = decaying_tail_test<denormal_flags::flush>;
+    using plain_type    = decaying_tail_test<denormal_flags::none>;
+
+    REQUIRE( class_get_denormal_flags<flushing_type>() == denormal_flags::flush );
+    REQUIRE( class_get_denormal_flags<plain_type>() == denormal_flags::none );
+
+    if (!floating_point_mode::supported())
+        return;
+
+    auto       flushing { new_decaying_tail_instance<flushing_type>("decaying_tail_test_flush") };
+    auto       plain { new_decaying_tail_instance<plain_type>("decaying_tail_test_none") };
+    sample     input[4] {};
+    sample     output[4] {};
+    double*    ins[] { input };
+    double*    outs[] { output };
+    const auto mode { floating_point_mode::get() };
+
+    min_perform_routine<flushing_type>()(reinterpret_cast<c74::max::t_object*>(flushing), nullptr, ins, 1, outs, 1, 4, 0, nullptr);
+
+    REQUIRE( (floating_point_mode::get() & floating_point_mode::k_flush_bits) == (mode & floating_point_mode::k_flush_bits) );
+    REQUIRE( output[3] == 0.0 );
+    REQUIRE( flushing->m_min_object.states[0] == 0.0 );
+
+    min_perform_routine<plain_type>()(reinterpret_cast<c74::max::t_object*>(plain), nullptr, ins, 1, outs, 1, 4, 0, nullptr);
+
+    REQUIRE( output[3] != 0.0 );
+    REQUIRE( plain->m_min_object.states[0] != 0.0 );
+
+    c74::max::object_free(plain);
+    c74::max::object_free(flushing);
+}
+
+
+// Not run by default. Use `min-tests "[!benchmark]"` to compare the cost of filters decaying through denormals
+// with the cost when they are flushed.
+
+TEST_CASE ("Denormals", "[denormals][!benchmark]") {
+    using flushing_type = decaying_tail_test<denormal_flags::flush>;
+    using plain_type    = decaying_tail_test<denormal_flags::none>;
+
+    constexpr long frame_count { 64 };
+    auto           flushing { new_decaying_tail_instance<flushing_type>("decaying_tail_benchmark_flush") };
+    auto           plain { new_decaying_tail_instance<plain_type>("decaying_tail_benchmark_none") };
+    sample         input[frame_count] {};
+    sample         output[frame_count] {};
+    double*        ins[] { input };
+    double*        outs[] { output };
+
+    BENCHMARK ("64 samples of 16 decaying filters") {
+        plain->m_min_object.reset();
+        min_perform_routine<plain_type>()(reinterpret_cast<c74::max::t_object*>(plain), nullptr, ins, 1, outs, 1, frame_count, 0, nullptr);
+        return output[frame_count - 1];
+    };
+
+    BENCHMARK ("64 samples of 16 decaying filters, flushing denormals") {
+        flushing->m_min_object.reset();
+        min_perform_routine<flushing_type>()(reinterpret_cast<c74::max::t_object*>(flushing), nullptr, ins, 1, outs, 1, frame_count, 0, nullptr);
+        return output[frame_count - 1];
+    };
+
+    c74::max::object_free(plain);
+    c74::max::object_free(flushing);
+}
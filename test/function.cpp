@@ -0,0 +1,92 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#include "catch.hpp"
+#include "c74_min_api.h"
+#include "allocation_counter.h"
+
+using namespace c74::min;
+
+
+TEST_CASE ("Inline Function", "[function]") {
+
+    SECTION ("empty functions") {
+        function f;
+        function g { nullptr };
+        atoms (*p)(const atoms&, const int) { nullptr };
+        function h { p };
+
+        REQUIRE( !f );
+        REQUIRE( f == nullptr );
+        REQUIRE( g == nullptr );
+        REQUIRE( h == nullptr );
+        REQUIRE_THROWS_AS( f(atoms {}, -1), std::bad_function_call );
+    }
+
+    SECTION ("lambdas capturing several values are stored and called without allocating") {
+        double  a { 1.0 };
+        double  b { 2.0 };
+        double* c { &a };
+
+        allocation_counter allocations;
+
+        function f = [a, b, c](const atoms& args, const int inlet) -> atoms {
+            return { a + b + *c + static_cast<double>(args[0]), inlet };
+        };
+        auto result = f(atoms { 4.0 }, 1);
+
+        function copy { f };
+        function moved { std::move(copy) };
+        auto     copied_result = moved(atoms { 4.0 }, 1);
+
+        REQUIRE( allocations.count() == 0 );
+        REQUIRE( result.size() == 2 );
+        REQUIRE( double(result[0]) == Approx(8.0) );
+        REQUIRE( int(result[1]) == 1 );
+        REQUIRE( double(copied_result[0]) == Approx(8.0) );
+        REQUIRE( moved != nullptr );
+        REQUIRE( copy == nullptr );
+    }
+
+    SECTION ("std::functions are stored and called, and an empty one makes an empty function") {
+        std::function<atoms(const atoms&, const int)> wrapped = [](const atoms& args, const int inlet) -> atoms {
+            return { static_cast<double>(args[0]) * 2.0, inlet };
+        };
+        std::function<atoms(const atoms&, const int)> empty;
+
+        function f { wrapped };
+        function g { empty };
+        auto     result = f(atoms { 4.0 }, 3);
+
+        REQUIRE( f != nullptr );
+        REQUIRE( g == nullptr );
+        REQUIRE( double(result[0]) == Approx(8.0) );
+        REQUIRE( int(result[1]) == 3 );
+    }
+
+    SECTION ("captured state is copied and destroyed with the function") {
+        auto shared = std::make_shared<int>(7);
+
+        {
+            inline_function<int()> f = [shared]() { return *shared; };
+            inline_function<int()> g;
+
+            g = f;
+            REQUIRE( shared.use_count() == 3 );
+            REQUIRE( g() == 7 );
+
+            f = nullptr;
+            REQUIRE( shared.use_count() == 2 );
+        }
+        REQUIRE( shared.use_count() == 1 );
+    }
+
+    SECTION ("mutable lambdas keep their state between calls") {
+        inline_function<int()> counter = [count = 0]() mutable { return ++count; };
+
+        counter();
+        REQUIRE( counter() == 2 );
+    }
+}
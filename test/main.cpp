@@ -1,6 +1,7 @@
 #define CATCH_CONFIG_MAIN
 
 #include "c74_min_catch.h"
+#include "allocation_counter.h"
 
 using namespace c74::min;
 
@@ -37,3 +38,194 @@ TEST_CASE("Attribute - repetitions", "[attribute]") {
 		REQUIRE(static_cast<number>(my_attr) == 7.5);
 	}
 }
+
+
+// An audio object with attributes mapped to its audio inlets.
+
+class MappedObject : public object<MappedObject>, public sample_operator<3, 1> {
+public:
+	int offset_sets {};
+
+	attribute<number, threadsafe::undefined, limit::clamp> gain { this, "gain", 1.0, range {0.0, 2.0} };
+	attribute<number> offset { this, "offset", 0.0,
+		setter { MIN_FUNCTION {
+			++offset_sets;
+			return args;
+		}}
+	};
+
+	inlet<>  input		{ this, "(signal) input" };
+	inlet<>  gain_in	{ this, "(signal) gain", gain };
+	inlet<>  offset_in	{ this, "(signal) offset", offset };
+	outlet<> output		{ this, "(signal) output", "signal" };
+
+	sample operator()(sample in, sample, sample) {
+		return in * gain + offset;
+	}
+};
+
+
+TEST_CASE("Attribute - mapped to audio inlets", "[attribute]") {
+	c74::min::wrap_as_max_external<MappedObject>("MappedObject", "MappedObject", nullptr);
+
+	auto  self		{ wrapper_new<MappedObject>(symbol("MappedObject"), 0, nullptr) };
+	auto& instance	{ self->m_min_object };
+
+	const long frame_count { 16 };
+	sample input[frame_count];
+	sample gain[frame_count];
+	sample offset[frame_count];
+	sample output[frame_count] {};
+
+	for (auto i = 0; i < frame_count; ++i) {
+		input[i]	= 1.0;
+		gain[i]		= -1.0 + 0.25 * i;
+		offset[i]	= 10.0 + i;
+	}
+
+	const double*	ins[] { input, gain, offset };
+	double*			outs[] { output };
+
+	SECTION("Numeric attributes are written from every sample within their range, without allocating") {
+		short count[] { 1, 1, 0, 1 };
+		min_dsp64_io(self, count);
+		min_dsp64_attrmap(self, count);
+
+		allocation_counter allocations;
+		performer<MappedObject>::perform(self, nullptr, ins, 3, outs, 1, frame_count, 0, nullptr);
+		const auto allocation_count { allocations.count() };
+
+		REQUIRE(allocation_count == 0);
+		for (auto i = 0; i < frame_count; ++i)
+			REQUIRE(output[i] == Approx(std::max(0.0, std::min(2.0, gain[i]))));
+	}
+
+	SECTION("Attributes with a setter are set from every sample, without allocating") {
+		short count[] { 1, 1, 1, 1 };
+		min_dsp64_io(self, count);
+		min_dsp64_attrmap(self, count);
+
+		const auto offset_sets { instance.offset_sets };
+		allocation_counter allocations;
+		performer<MappedObject>::perform(self, nullptr, ins, 3, outs, 1, frame_count, 0, nullptr);
+		const auto allocation_count { allocations.count() };
+
+		REQUIRE(allocation_count == 0);
+		REQUIRE(instance.offset_sets == offset_sets + frame_count);
+		for (auto i = 0; i < frame_count; ++i)
+			REQUIRE(output[i] == Approx(std::max(0.0, std::min(2.0, gain[i])) + offset[i]));
+	}
+
+	c74::max::object_free(self);
+}
+
+
+class SmoothedObject : public object<SmoothedObject>, public vector_operator<> {
+public:
+	smoothed_attribute<limit::clamp> gain { this, "gain", 1.0, range {0.0, 2.0} };
+
+	void operator()(audio_bundle input, audio_bundle output) {}
+};
+
+
+TEST_CASE("Attribute - smoothed", "[attribute]") {
+	SmoothedObject my_object;
+	auto&          gain { my_object.gain };
+
+	my_object.dspsetup_smoothers(1000.0, 8);
+	gain.smoother().ramp_time(4.0);
+
+	SECTION("Setting the attribute, from any thread, ramps its smoothed value to the limited value") {
+		std::thread setter { [&] { gain = 3.0; } };
+		setter.join();
+
+		REQUIRE(static_cast<number>(gain) == 2.0);
+
+		my_object.advance_smoothers(8);
+
+		REQUIRE(gain.ramp()[0] == Approx(1.25));
+		REQUIRE(gain.ramp()[3] == Approx(2.0));
+		REQUIRE(gain.ramp()[7] == Approx(2.0));
+	}
+
+	SECTION("Samples from a mapped audio inlet set the target") {
+		auto writer { gain.sample_writer() };
+		REQUIRE(writer);
+
+		writer(0.5);
+		my_object.advance_smoothers(8);
+
+		REQUIRE(static_cast<number>(gain) == 0.5);
+		REQUIRE(gain.ramp()[3] == Approx(0.5));
+	}
+}
+
+
+// A class of typical size, with names too long for a std::string to store without allocating.
+
+class FootprintObject : public object<FootprintObject> {
+public:
+	inlet<>  input	{ this, "(anything) input" };
+	outlet<> output	{ this, "(anything) output" };
+
+	attribute<number> frequency	{ this, "frequency_in_hertz", 440.0 };
+	attribute<number> gain		{ this, "gain_in_decibels", 0.0 };
+	attribute<bool>   bypass	{ this, "bypass_processing", false };
+	attribute<symbol> mode		{ this, "processing_mode_name", "normal" };
+
+	message<> bang		{ this, "bang", MIN_FUNCTION { return {}; } };
+	message<> reset		{ this, "reset_all_the_state", MIN_FUNCTION { return {}; } };
+	message<> clear		{ this, "clear_the_history", MIN_FUNCTION { return {}; } };
+	message<> set		{ this, "set_without_output", MIN_FUNCTION { return {}; } };
+};
+
+
+TEST_CASE("Object - shared component names", "[object]") {
+	FootprintObject first;
+	FootprintObject second;
+
+	SECTION("Each instance finds its own messages and attributes by name") {
+		REQUIRE(second.messages().size() == 4);
+		REQUIRE(second.attributes().size() == 4);
+		REQUIRE(second.messages()["reset_all_the_state"] == &second.reset);
+		REQUIRE(first.messages()["reset_all_the_state"] == &first.reset);
+		REQUIRE(second.attributes()["gain_in_decibels"] == &second.gain);
+		REQUIRE(second.messages()["nonexistent"] == nullptr);
+		REQUIRE(second.messages().count("nonexistent") == 0);
+		REQUIRE(second.has_call("clear_the_history"));
+	}
+
+	SECTION("The instances share a single copy of each name") {
+		auto first_message  = first.messages().begin();
+		auto second_message = second.messages().begin();
+		for (; first_message != first.messages().end(); ++first_message, ++second_message) {
+			REQUIRE(&(*first_message).first == &(*second_message).first);
+			REQUIRE((*first_message).second != (*second_message).second);
+		}
+		REQUIRE(second.message_slots().capacity() == second.messages().size());
+	}
+}
+
+
+// Not run by default. Use `min-tests "[!benchmark]"` to report the memory used by each instance of a typical class
+// and the time taken to create one.
+
+TEST_CASE("Object - instance footprint", "[object][!benchmark]") {
+	FootprintObject first;	// registers the names of the class's messages and attributes
+
+	const size_t instance_count { 1000 };
+	std::vector<std::unique_ptr<FootprintObject>> instances;
+	instances.reserve(instance_count);
+
+	allocation_counter allocations;
+	for (auto i = 0u; i < instance_count; ++i)
+		instances.push_back(std::make_unique<FootprintObject>());
+
+	WARN("bytes per instance: " << sizeof(FootprintObject) << " in the object and "
+		<< (allocations.bytes() / instance_count - sizeof(FootprintObject)) << " more on the heap, in "
+		<< (allocations.count() / instance_count) << " allocations");
+
+	BENCHMARK("create and free an instance") {
+		return std::make_unique<FootprintObject>();
+	};
+}
@@ -0,0 +1,245 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#include "catch.hpp"
+#include "c74_min_api.h"
+#include "allocation_counter.h"
+
+using namespace c74::min;
+
+
+class message_dispatch_test : public object<message_dispatch_test> {
+public:
+    number sum {};
+
+    bang_message<> bang { this, "bang",
+        [this](const int inlet) {
+            sum = 0.0;
+        }
+    };
+
+    int_message<> integer { this, "int",
+        [this](const t_atom_long value, const int inlet) {
+            sum += value;
+        }
+    };
+
+    float_message<> number { this, "float",
+        [this](const double value, const int inlet) {
+            sum += value;
+        }
+    };
+
+    message<> set { this, "set",
+        MIN_FUNCTION {
+            sum = args[0];
+            return {};
+        }
+    };
+
+    symbol last_name;
+    long   last_size {};
+
+    view_message<> list { this, "list",
+        [this](const symbol name, const atom_reference& args, const int inlet) {
+            last_name = name;
+            last_size = args.size();
+            sum       = 0.0;
+            for (auto i = 0; i < args.size(); ++i)
+                sum += static_cast<double>(args[i]);
+        }
+    };
+
+    view_message<> anything { this, "anything",
+        [this](const symbol name, const atom_reference& args, const int inlet) {
+            last_name = name;
+            last_size = args.size();
+            sum       = args.empty() ? 0.0 : static_cast<double>(args.back());
+        }
+    };
+};
+
+
+SCENARIO ("messages are resolved to slots when the class is set up") {
+    c74::min::wrap_as_max_external<message_dispatch_test>("message_dispatch_test", "message_dispatch_test", nullptr);
+
+    GIVEN ("an instance of a class with int, float and bang messages") {
+        auto  self     = wrapper_new<message_dispatch_test>(symbol("message_dispatch_test"), 0, nullptr);
+        auto& instance = self->m_min_object;
+
+        REQUIRE( instance.message_slots().size() == instance.messages().size() );
+
+        THEN ("the wrapper finds the same messages as a lookup by name") {
+            REQUIRE( wrapper_find_message<message_dispatch_test, wrapper_message_name_int>(self) == instance.messages()["int"] );
+            REQUIRE( wrapper_find_message<message_dispatch_test, wrapper_message_name_float>(self) == instance.messages()["float"] );
+            REQUIRE( wrapper_find_message<message_dispatch_test, wrapper_message_name_bang>(self) == instance.messages()["bang"] );
+        }
+        AND_THEN ("a message the class does not have is not found") {
+            REQUIRE( wrapper_find_message<message_dispatch_test, wrapper_message_name_notify>(self) == nullptr );
+        }
+        AND_THEN ("messages sent by name are found through the class's table") {
+            for (const auto& a_message : instance.messages()) {
+                REQUIRE( wrapper_find_message(self, static_cast<c74::max::t_symbol*>(symbol(a_message.first))) == a_message.second );
+                REQUIRE( wrapper_find_message(self, a_message.first.c_str()) == a_message.second );
+            }
+            REQUIRE( wrapper_find_message(self, static_cast<c74::max::t_symbol*>(symbol("nonexistent"))) == nullptr );
+            REQUIRE( wrapper_find_message(self, "nonexistent") == nullptr );
+        }
+        AND_THEN ("calls from Max reach the messages") {
+            wrapper_method_int<message_dispatch_test, wrapper_message_name_int>(self->maxobj(), 3);
+            wrapper_method_float<message_dispatch_test, wrapper_message_name_float>(self->maxobj(), 0.5);
+            REQUIRE( instance.sum == Approx(3.5) );
+
+            wrapper_method_zero<message_dispatch_test, wrapper_message_name_bang>(self->maxobj());
+            REQUIRE( instance.sum == Approx(0.0) );
+        }
+        AND_THEN ("typed messages are called without allocating") {
+            allocation_counter allocations;
+
+            wrapper_method_int<message_dispatch_test, wrapper_message_name_int>(self->maxobj(), 3);
+            wrapper_method_float<message_dispatch_test, wrapper_message_name_float>(self->maxobj(), 0.5);
+            wrapper_method_zero<message_dispatch_test, wrapper_message_name_bang>(self->maxobj());
+            REQUIRE( allocations.count() == 0 );
+        }
+        AND_THEN ("typed messages sent from another thread are deferred without allocating") {
+            size_t      allocation_count {};
+            std::thread sender { [&] {
+                allocation_counter allocations;
+                wrapper_method_int<message_dispatch_test, wrapper_message_name_int>(self->maxobj(), 3);
+                allocation_count = allocations.count();
+            } };
+            sender.join();
+
+            REQUIRE( allocation_count == 0 );
+
+            deferred_message call;
+            REQUIRE( instance.deferred_messages().try_dequeue(call) );
+            call.call();
+            REQUIRE( instance.sum == Approx(3.0) );
+        }
+        AND_THEN ("typed messages can still be called with atoms") {
+            instance.try_call("int", 4);
+            instance.try_call("float", 0.25);
+            REQUIRE( instance.sum == Approx(4.25) );
+
+            instance.try_call("int", atoms { 2.9 });
+            REQUIRE( instance.sum == Approx(6.25) );
+        }
+        AND_THEN ("view messages receive long lists without copying or allocating") {
+            atoms values(200);
+            for (auto i = 0; i < 200; ++i)
+                values[i] = i;
+
+            allocation_counter allocations;
+
+            wrapper_method_generic<message_dispatch_test>(self->maxobj(), symbol("list"), static_cast<long>(values.size()), values.data());
+            REQUIRE( instance.last_name == "list" );
+            REQUIRE( instance.last_size == 200 );
+            REQUIRE( instance.sum == Approx(19900.0) );
+
+            wrapper_method_anything<message_dispatch_test, wrapper_message_name_anything>(self->maxobj(), symbol("foo"), static_cast<long>(values.size()), values.data());
+            REQUIRE( instance.last_name == "foo" );
+            REQUIRE( instance.last_size == 200 );
+            REQUIRE( instance.sum == Approx(199.0) );
+
+            REQUIRE( allocations.count() == 0 );
+        }
+        AND_THEN ("view messages can still be called with atoms") {
+            instance.try_call("anything", atoms { symbol("bar"), 1, 2 });
+            REQUIRE( instance.last_name == "bar" );
+            REQUIRE( instance.last_size == 2 );
+            REQUIRE( instance.sum == Approx(2.0) );
+
+            instance.try_call("list", atoms { 1, 2, 3 });
+            REQUIRE( instance.last_name == "list" );
+            REQUIRE( instance.sum == Approx(6.0) );
+        }
+        AND_THEN ("messages taking atoms can be called with a scalar") {
+            instance.set.dispatch_int(7);
+            REQUIRE( instance.sum == Approx(7.0) );
+
+            instance.set.dispatch_float(1.5);
+            REQUIRE( instance.sum == Approx(1.5) );
+        }
+
+        c74::max::object_free(self);
+    }
+}
+
+
+TEST_CASE ("Message table", "[message]") {
+    std::vector<std::string> names;
+    for (auto i = 0; i < 300; ++i)
+        names.push_back("message_" + std::to_string(i));
+
+    struct table_test : public object<table_test> {
+        std::vector<std::unique_ptr<message<>>> messages;
+    } instance;
+
+    for (const auto& name : names)
+        instance.messages.push_back(std::make_unique<message<>>(&instance, name, [](const atoms& args, const int inlet) -> atoms { return {}; }));
+
+    message_table table;
+    table.build(instance.message_slots());
+
+    for (auto i = 0u; i < names.size(); ++i) {
+        REQUIRE( table.find(static_cast<c74::max::t_symbol*>(symbol(names[i]))) == i );
+        REQUIRE( table.find(names[i].c_str()) == i );
+    }
+    REQUIRE( table.find(static_cast<c74::max::t_symbol*>(symbol("message_300"))) == message_table::npos );
+    REQUIRE( table.find("message_300") == message_table::npos );
+}
+
+
+// Not run by default. Use `min-tests "[!benchmark]"` to compare the per-call cost of the named lookup
+// that the wrapper methods used to perform with the slot lookup they perform now,
+// and the cost of typed and view messages with that of messages taking atoms.
+
+TEST_CASE ("Message lookup in the wrapper", "[message][!benchmark]") {
+    c74::min::wrap_as_max_external<message_dispatch_test>("message_dispatch_test", "message_dispatch_test", nullptr);
+
+    auto  self     = wrapper_new<message_dispatch_test>(symbol("message_dispatch_test"), 0, nullptr);
+    auto& instance = self->m_min_object;
+
+    BENCHMARK ("lookup by name") {
+        return instance.messages()[wrapper_message_name_int::name];
+    };
+
+    const auto int_symbol = static_cast<c74::max::t_symbol*>(symbol(wrapper_message_name_int::name));
+
+    BENCHMARK ("lookup by symbol through the class's table") {
+        return wrapper_find_message(self, int_symbol);
+    };
+
+    BENCHMARK ("lookup by slot") {
+        return wrapper_find_message<message_dispatch_test, wrapper_message_name_int>(self);
+    };
+
+    BENCHMARK ("int dispatch to a typed message") {
+        wrapper_method_int<message_dispatch_test, wrapper_message_name_int>(self->maxobj(), 1);
+        return instance.sum;
+    };
+
+    BENCHMARK ("int dispatch to a message taking atoms") {
+        instance.set.dispatch_int(1);
+        return instance.sum;
+    };
+
+    atoms values(200);
+    for (auto i = 0; i < 200; ++i)
+        values[i] = i;
+
+    BENCHMARK ("200 atom list to a view message") {
+        instance.list.dispatch_atoms(atom_reference(static_cast<long>(values.size()), values.data()));
+        return instance.sum;
+    };
+
+    BENCHMARK ("200 atom list to a message taking atoms") {
+        instance.list.message_base::dispatch_atoms(atom_reference(static_cast<long>(values.size()), values.data()));
+        return instance.sum;
+    };
+
+    c74::max::object_free(self);
+}
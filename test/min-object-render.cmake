@@ -0,0 +1,71 @@
+# Copyright 2018 The Min-API Authors. All rights reserved.
+# Use of this source code is governed by the MIT License found in the License.md file.
+
+# Include this after min-posttarget.cmake to add a ${PROJECT_NAME}_render target for an audio external.
+# It builds a program that renders audio offline through the external's class, along the same dsp path as Max,
+# and reports the time taken per sample, the multiple of realtime and any allocations made by the perform routine.
+# The class is the one named by MIN_EXTERNAL() in ${PROJECT_NAME}.cpp, or set C74_RENDER_CLASS before including this file.
+
+cmake_minimum_required(VERSION 3.10)
+
+set(RENDER_NAME "${PROJECT_NAME}_render")
+set(C74_RENDER_SOURCE "${CMAKE_CURRENT_SOURCE_DIR}/${PROJECT_NAME}.cpp")
+
+if (EXISTS "${C74_RENDER_SOURCE}")
+
+	if (NOT C74_RENDER_CLASS)
+		file(STRINGS "${C74_RENDER_SOURCE}" RENDER_EXTERNAL_LINE REGEX "^[ \t]*MIN_EXTERNAL(_CUSTOM)?[ \t]*\\(")
+		string(REGEX REPLACE ".*MIN_EXTERNAL(_CUSTOM)?[ \t]*\\([ \t]*([A-Za-z0-9_:]+).*" "\\2" C74_RENDER_CLASS "${RENDER_EXTERNAL_LINE}")
+	endif ()
+
+	if (NOT C74_RENDER_CLASS)
+		message(WARNING "${RENDER_NAME}: no MIN_EXTERNAL() found in ${C74_RENDER_SOURCE}; set C74_RENDER_CLASS to render this external")
+		return()
+	endif ()
+
+	configure_file("${CMAKE_CURRENT_LIST_DIR}/min-object-render.cpp.in" "${CMAKE_CURRENT_BINARY_DIR}/${RENDER_NAME}.cpp" @ONLY)
+
+	include_directories(
+		"${C74_INCLUDES}"
+		"${C74_MIN_API_DIR}/test"
+	)
+
+	set(RENDER_SOURCE_FILES "")
+	FOREACH(SOURCE_FILE ${SOURCE_FILES})
+		if (NOT SOURCE_FILE STREQUAL "${PROJECT_NAME}.cpp")
+			set(RENDER_SOURCE_FILES ${RENDER_SOURCE_FILES} ${SOURCE_FILE})
+		endif()
+	ENDFOREACH()
+
+	set(CMAKE_RUNTIME_OUTPUT_DIRECTORY "${CMAKE_CURRENT_SOURCE_DIR}/../../../tests")
+	set(CMAKE_RUNTIME_OUTPUT_DIRECTORY_DEBUG "${CMAKE_RUNTIME_OUTPUT_DIRECTORY}")
+	set(CMAKE_RUNTIME_OUTPUT_DIRECTORY_RELEASE "${CMAKE_RUNTIME_OUTPUT_DIRECTORY}")
+
+	add_executable(${RENDER_NAME} "${CMAKE_CURRENT_BINARY_DIR}/${RENDER_NAME}.cpp" ${RENDER_SOURCE_FILES})
+
+	if (NOT TARGET mock_kernel)
+		set(C74_MOCK_TARGET_DIR "${CMAKE_CURRENT_LIST_DIR}/../../../tests")
+		add_subdirectory(${CMAKE_CURRENT_LIST_DIR}/../test/mock ${CMAKE_BINARY_DIR}/mock)
+	endif ()
+
+	add_dependencies(${RENDER_NAME} mock_kernel)
+
+	target_compile_definitions(${RENDER_NAME} PUBLIC -DMIN_TEST)
+
+	set_property(TARGET ${RENDER_NAME} PROPERTY CXX_STANDARD 17)
+	set_property(TARGET ${RENDER_NAME} PROPERTY CXX_STANDARD_REQUIRED ON)
+
+	target_link_libraries(${RENDER_NAME} PUBLIC "mock_kernel")
+
+	if (APPLE)
+		set_target_properties(${RENDER_NAME} PROPERTIES LINK_FLAGS "-Wl,-F'${MAX_SDK_JIT_INCLUDES}', -weak_framework JitterAPI")
+	endif ()
+	if (WIN32)
+		set_target_properties(${RENDER_NAME} PROPERTIES COMPILE_PDB_NAME ${RENDER_NAME})
+	endif ()
+
+	# Render a fraction of a second as a test, so that an external that crashes or throws on the audio path fails the build's tests.
+	add_test(NAME ${RENDER_NAME}
+	         COMMAND ${RENDER_NAME} --seconds 0.1)
+
+endif ()
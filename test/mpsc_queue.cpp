@@ -0,0 +1,111 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#include "catch.hpp"
+#include "c74_min_api.h"
+
+using namespace c74::min;
+
+
+TEST_CASE ("MPSC Queue", "[queue]") {
+
+    SECTION ("capacity is rounded up to a power of two") {
+        mpsc_queue<int> q { 5 };
+        REQUIRE( q.capacity() == 8 );
+        REQUIRE( q.size_approx() == 0 );
+    }
+
+    SECTION ("the drop policy discards new items when full") {
+        mpsc_queue<int> q { 4, queue_overflow::drop };
+
+        for (auto i = 0; i < 6; ++i)
+            q.try_enqueue(i);
+
+        REQUIRE( q.size_approx() == 4 );
+        REQUIRE( q.dropped() == 2 );
+
+        int item;
+        for (auto i = 0; i < 4; ++i) {
+            REQUIRE( q.try_dequeue(item) );
+            REQUIRE( item == i );
+        }
+        REQUIRE( !q.try_dequeue(item) );
+    }
+
+    SECTION ("the overwrite policy discards the oldest items when full") {
+        mpsc_queue<int> q { 4, queue_overflow::overwrite };
+
+        for (auto i = 0; i < 6; ++i)
+            REQUIRE( q.try_enqueue(i) );
+
+        REQUIRE( q.dropped() == 2 );
+
+        int item;
+        for (auto i = 2; i < 6; ++i) {
+            REQUIRE( q.try_dequeue(item) );
+            REQUIRE( item == i );
+        }
+        REQUIRE( !q.try_dequeue(item) );
+    }
+
+    SECTION ("the grow policy keeps every item in order") {
+        mpsc_queue<int> q { 4, queue_overflow::grow };
+        int             item;
+
+        for (auto i = 0; i < 10; ++i)
+            q.try_enqueue(i);
+        REQUIRE( q.size_approx() == 10 );
+
+        for (auto i = 0; i < 5; ++i) {
+            REQUIRE( q.try_dequeue(item) );
+            REQUIRE( item == i );
+        }
+        for (auto i = 10; i < 12; ++i)
+            q.try_enqueue(i);
+        for (auto i = 5; i < 12; ++i) {
+            REQUIRE( q.try_dequeue(item) );
+            REQUIRE( item == i );
+        }
+        REQUIRE( !q.try_dequeue(item) );
+        REQUIRE( q.dropped() == 0 );
+    }
+
+    SECTION ("items from many threads all arrive, in order for each thread") {
+        const int                producer_count { 4 };
+        const int                items_per_producer { 20000 };
+        mpsc_queue<std::pair<int, int>> q { 64, queue_overflow::grow };
+        std::atomic<bool>        done { false };
+        std::vector<std::thread> producers;
+        std::vector<int>         next(producer_count, 0);
+        bool                     in_order { true };
+        int                      received {};
+
+        for (auto p = 0; p < producer_count; ++p) {
+            producers.emplace_back([&q, p, items_per_producer] {
+                for (auto i = 0; i < items_per_producer; ++i)
+                    q.try_enqueue({ p, i });
+            });
+        }
+
+        std::thread consumer { [&] {
+            std::pair<int, int> item;
+            while (!done || q.size_approx()) {
+                while (q.try_dequeue(item)) {
+                    in_order = in_order && item.second == next[item.first];
+                    next[item.first] = item.second + 1;
+                    ++received;
+                }
+            }
+        }};
+
+        for (auto& producer : producers)
+            producer.join();
+        done = true;
+        consumer.join();
+
+        REQUIRE( in_order );
+        REQUIRE( received == producer_count * items_per_producer );
+    }
+}
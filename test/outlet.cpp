@@ -0,0 +1,711 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#include "catch.hpp"
+#include "c74_min_api.h"
+#include "allocation_counter.h"
+
+using namespace c74::min;
+
+
+SCENARIO ("an atom_mailbox holds one value at a time") {
+    atom_mailbox mailbox { 4 };
+
+    GIVEN ("an empty mailbox") {
+        auto taken = 0;
+        auto take  = [&](const message_type a_type, const atom_reference& values) { ++taken; };
+
+        REQUIRE( !mailbox.take(take) );
+
+        WHEN ("values replace each other") {
+            atoms first { 1, 2, 3 };
+            atoms second { 4.5 };
+
+            REQUIRE( mailbox.replace(message_type::gimme, first.data(), first.size()) );
+            REQUIRE( !mailbox.replace(message_type::float_argument, second.data(), second.size()) );
+
+            THEN ("only the last is taken") {
+                mailbox.take([&](const message_type a_type, const atom_reference& values) {
+                    REQUIRE( a_type == message_type::float_argument );
+                    REQUIRE( values.size() == 1 );
+                    REQUIRE( values[0] == 4.5 );
+                });
+                REQUIRE( !mailbox.take(take) );
+            }
+        }
+        AND_WHEN ("values are offered") {
+            atoms first { symbol("foo"), 1 };
+            atoms second { symbol("bar"), 2 };
+
+            REQUIRE( mailbox.offer(message_type::gimme, first.data(), first.size()) );
+            REQUIRE( !mailbox.offer(message_type::gimme, second.data(), second.size()) );
+
+            THEN ("only the first is taken") {
+                mailbox.take([&](const message_type a_type, const atom_reference& values) {
+                    REQUIRE( values.size() == 2 );
+                    REQUIRE( values[0] == symbol("foo") );
+                });
+                REQUIRE( mailbox.offer(message_type::gimme, second.data(), second.size()) );
+            }
+        }
+        AND_WHEN ("a value is longer than the capacity") {
+            atoms values(5);
+
+            THEN ("it is dropped and counted") {
+                REQUIRE( !mailbox.replace(message_type::gimme, values.data(), values.size()) );
+                REQUIRE( mailbox.dropped() == 1 );
+                REQUIRE( !mailbox.take(take) );
+            }
+        }
+        AND_WHEN ("values are stored and taken") {
+            atoms values { 1, 2, 3, 4 };
+
+            allocation_counter allocations;
+            for (auto i = 0; i < 100; ++i) {
+                mailbox.replace(message_type::gimme, values.data(), values.size());
+                mailbox.take(take);
+            }
+            const auto allocation_count = allocations.count();
+
+            THEN ("no memory is allocated") {
+                REQUIRE( allocation_count == 0 );
+                REQUIRE( taken == 100 );
+            }
+        }
+    }
+}
+
+
+// Each sender sends lists whose atoms all have the same value, which counts up.
+// A list whose atoms differ was torn: the receiver saw part of one value and part of another.
+
+TEST_CASE ("atom_mailbox under contention", "[outlet]") {
+    const auto sender_count = 2;    // e.g. the audio thread and a worker thread
+    const auto send_count   = 100000;
+    const auto list_size    = 16;
+
+    atom_mailbox             mailbox { list_size };
+    std::atomic<bool>        sending { true };
+    std::vector<std::thread> senders;
+
+    for (auto s = 0; s < sender_count; ++s) {
+        senders.emplace_back([&mailbox, s] {
+            atoms values(list_size);
+
+            for (auto i = 0; i < send_count; ++i) {
+                for (auto& a : values)
+                    a = s * send_count + i;
+                mailbox.replace(message_type::gimme, values.data(), values.size());
+            }
+        });
+    }
+
+    long              torn {};
+    long              out_of_order {};
+    long              taken {};
+    std::vector<long> newest(sender_count, -1);
+
+    auto take = [&](const message_type a_type, const atom_reference& values) {
+        const long first = values[0];
+
+        for (auto i = 1; i < values.size(); ++i) {
+            if (static_cast<long>(values[i]) != first)
+                ++torn;
+        }
+
+        // values from one sender arrive in the order in which they were sent
+        auto& newest_from_sender = newest[first / send_count];
+        if (first <= newest_from_sender)
+            ++out_of_order;
+        newest_from_sender = first;
+        ++taken;
+    };
+
+    std::thread receiver { [&] {
+        while (sending)
+            mailbox.take(take);
+    } };
+
+    for (auto& sender : senders)
+        sender.join();
+    sending = false;
+    receiver.join();
+    mailbox.take(take);
+
+    REQUIRE( torn == 0 );
+    REQUIRE( out_of_order == 0 );
+    REQUIRE( taken > 0 );
+    REQUIRE( mailbox.dropped() == 0 );    // there is always a free slot for two senders
+
+    // the newest value of all is the last one taken
+    REQUIRE( (newest[0] == send_count - 1 || newest[1] == 2 * send_count - 1) );
+}
+
+
+SCENARIO ("an atom_ring queues values in order") {
+    atom_ring ring { 4, 3 };
+    atoms     values { 1, 2, 3 };
+
+    GIVEN ("a full ring") {
+        for (auto i = 0; i < 4; ++i) {
+            values[0] = i;
+            REQUIRE( ring.try_push(message_type::gimme, values.data(), values.size()) );
+        }
+        REQUIRE( ring.size_approx() == 4 );
+        REQUIRE( !ring.try_push(message_type::gimme, values.data(), values.size()) );
+
+        THEN ("values are popped in the order they were pushed") {
+            for (auto i = 0; i < 4; ++i) {
+                REQUIRE( ring.try_pop([&](const message_type a_type, const atom_reference& popped, atom_ring::clock::time_point) {
+                    REQUIRE( popped.size() == 3 );
+                    REQUIRE( popped[0] == i );
+                }) );
+            }
+            REQUIRE( !ring.try_pop([](const message_type, const atom_reference&, atom_ring::clock::time_point) {}) );
+        }
+        AND_THEN ("discarding the oldest value makes room for another") {
+            REQUIRE( ring.try_discard() );
+            REQUIRE( ring.try_push(message_type::int_argument, values.data(), 1) );
+            ring.try_pop([&](const message_type, const atom_reference& popped, atom_ring::clock::time_point) {
+                REQUIRE( popped[0] == 1 );
+            });
+        }
+    }
+}
+
+
+// As with the atom_mailbox, each sender sends lists whose atoms all have the same value, which counts up.
+
+TEST_CASE ("atom_ring under contention", "[outlet]") {
+    const auto sender_count = 4;
+    const auto send_count   = 50000;
+    const auto list_size    = 8;
+
+    atom_ring                ring { 64, list_size };
+    std::atomic<bool>        sending { true };
+    std::atomic<long>        pushed {};
+    std::vector<std::thread> senders;
+
+    for (auto s = 0; s < sender_count; ++s) {
+        senders.emplace_back([&, s] {
+            atoms values(list_size);
+
+            for (auto i = 0; i < send_count; ++i) {
+                for (auto& a : values)
+                    a = s * send_count + i;
+                if (ring.try_push(message_type::gimme, values.data(), values.size()))
+                    ++pushed;
+            }
+        });
+    }
+
+    long              torn {};
+    long              out_of_order {};
+    long              popped {};
+    std::vector<long> newest(sender_count, -1);
+
+    auto pop = [&](const message_type a_type, const atom_reference& values, atom_ring::clock::time_point) {
+        const long first = values[0];
+
+        for (auto i = 1; i < values.size(); ++i) {
+            if (static_cast<long>(values[i]) != first)
+                ++torn;
+        }
+
+        auto& newest_from_sender = newest[first / send_count];
+        if (first <= newest_from_sender)
+            ++out_of_order;
+        newest_from_sender = first;
+        ++popped;
+    };
+
+    std::thread receiver { [&] {
+        while (sending)
+            ring.try_pop(pop);
+    } };
+
+    for (auto& sender : senders)
+        sender.join();
+    sending = false;
+    receiver.join();
+    while (ring.try_pop(pop))
+        ;
+
+    REQUIRE( torn == 0 );
+    REQUIRE( out_of_order == 0 );
+    REQUIRE( popped == pushed );
+}
+
+
+SCENARIO ("reducers merge values element by element") {
+    coalesced_value value { 4 };
+
+    GIVEN ("an int") {
+        atoms first { 2 };
+        value.assign(message_type::int_argument, first.data(), first.size());
+
+        WHEN ("an int is added") {
+            atoms second { 3 };
+            reduce_sum(value, message_type::int_argument, atom_reference(1, second.data()));
+
+            THEN ("the sum is an int") {
+                REQUIRE( value.type() == message_type::int_argument );
+                REQUIRE( value[0].a_type == c74::max::A_LONG );
+                REQUIRE( value[0] == 5 );
+            }
+        }
+        AND_WHEN ("a float is added") {
+            atoms second { 0.5 };
+            reduce_sum(value, message_type::float_argument, atom_reference(1, second.data()));
+
+            THEN ("the sum is a float") {
+                REQUIRE( value.type() == message_type::float_argument );
+                REQUIRE( value[0] == Approx(2.5) );
+            }
+        }
+    }
+    AND_GIVEN ("a list") {
+        atoms first { 1, 5.0 };
+        value.assign(message_type::gimme, first.data(), first.size());
+
+        WHEN ("a longer list is merged") {
+            atoms second { 4, 2.0, 7, 8, 9 };
+            reduce_max(value, message_type::gimme, atom_reference(static_cast<long>(second.size()), second.data()));
+
+            THEN ("the greatest value of each element is kept, up to the capacity") {
+                REQUIRE( value.size() == 4 );
+                REQUIRE( value[0] == 4 );
+                REQUIRE( value[1] == Approx(5.0) );
+                REQUIRE( value[2] == 7 );
+                REQUIRE( value[3] == 8 );
+            }
+        }
+    }
+}
+
+
+TEST_CASE ("atom_accumulator under contention", "[outlet]") {
+    const auto sender_count = 4;
+    const auto send_count   = 50000;
+
+    atom_accumulator         accumulator { 2 };
+    std::atomic<bool>        sending { true };
+    std::vector<std::thread> senders;
+
+    accumulator.reduce_with(reduce_sum);
+
+    for (auto s = 0; s < sender_count; ++s) {
+        senders.emplace_back([&accumulator] {
+            atoms values { 1, 2 };
+            for (auto i = 0; i < send_count; ++i)
+                accumulator.merge(message_type::gimme, values.data(), values.size());
+        });
+    }
+
+    long totals[2] {};
+    long taken {};
+    auto take = [&](const message_type a_type, const atom_reference& values) {
+        totals[0] += static_cast<long>(values[0]);
+        totals[1] += static_cast<long>(values[1]);
+        ++taken;
+    };
+
+    std::thread receiver { [&] {
+        while (sending)
+            accumulator.take(take);
+    } };
+
+    for (auto& sender : senders)
+        sender.join();
+    sending = false;
+    receiver.join();
+    accumulator.take(take);
+
+    // every value is counted exactly once, whichever combined value it was merged into
+    REQUIRE( totals[0] == sender_count * send_count );
+    REQUIRE( totals[1] == 2 * sender_count * send_count );
+    REQUIRE( accumulator.merged() + taken == sender_count * send_count );
+    REQUIRE( accumulator.dropped() == 0 );
+}
+
+
+SCENARIO ("an event_ring holds events until they are due") {
+    event_ring ring { 4, 2 };
+    atoms      values { 1, 2 };
+
+    const auto now  = event_ring::clock::now();
+    auto       next = event_ring::clock::time_point::max();
+    auto       sent = 0;
+    auto       send = [&](const message_type a_type, const atom_reference& popped) {
+        REQUIRE( popped.size() == 2 );
+        ++sent;
+    };
+
+    GIVEN ("events due now and later") {
+        REQUIRE( ring.try_push(message_type::gimme, values.data(), values.size(), now) );
+        REQUIRE( ring.try_push(message_type::gimme, values.data(), values.size(), now + std::chrono::seconds(1)) );
+
+        THEN ("only the events that are due are popped") {
+            while (ring.try_pop_due(now, send, next))
+                ;
+            REQUIRE( sent == 1 );
+            REQUIRE( next == now + std::chrono::seconds(1) );
+            REQUIRE( ring.size_approx() == 1 );
+        }
+        AND_THEN ("the ring holds no more than its capacity") {
+            REQUIRE( ring.try_push(message_type::gimme, values.data(), values.size(), now) );
+            REQUIRE( ring.try_push(message_type::gimme, values.data(), values.size(), now) );
+            REQUIRE( !ring.try_push(message_type::gimme, values.data(), values.size(), now) );
+        }
+    }
+}
+
+
+class outlet_test : public object<outlet_test> {
+public:
+    outlet<thread_check::main, thread_action::first>     first     { this, "(anything) first" };
+    outlet<thread_check::main, thread_action::last>      last      { this, "(anything) last", 8 };
+    outlet<thread_check::main, thread_action::fifo>      fifo      { this, "(anything) fifo" };
+    outlet<thread_check::scheduler, thread_action::fifo> scheduler { this, "(anything) scheduler" };
+    outlet<thread_check::main, thread_action::coalesce>  sum       { this, "(anything) sum" };
+    outlet<thread_check::scheduler, thread_action::timed> timed    { this, "(anything) timed" };
+
+    outlet_test(const atoms& args = {}) {
+        sum.queue().reduce_with(reduce_sum);
+    }
+};
+
+
+SCENARIO ("outlets queue values sent from other threads") {
+    c74::min::wrap_as_max_external<outlet_test>("outlet_test", "outlet_test", nullptr);
+
+    auto  self     = wrapper_new<outlet_test>(symbol("outlet_test"), 0, nullptr);
+    auto& instance = self->m_min_object;
+
+    auto send_from_another_thread = [&](const int count) {
+        std::thread sender { [&] {
+            for (auto i = 0; i < count; ++i) {
+                instance.first.send(i);
+                instance.last.send(i * 0.5);
+                instance.last.send(atoms { i, i, i });
+                instance.fifo.send(i);
+            }
+        } };
+        sender.join();
+    };
+
+    GIVEN ("a fifo outlet that drops new values when full") {
+        instance.fifo.queue().configure(32, queue_overflow::drop);
+        send_from_another_thread(100);
+
+        THEN ("the values that did not fit are counted") {
+            REQUIRE( instance.fifo.queue().stats().capacity == 32 );
+            REQUIRE( instance.fifo.queue().stats().dropped == 68 );
+        }
+        AND_THEN ("the values that fit are sent") {
+            instance.fifo.queue().callback();
+
+            auto stats = instance.fifo.queue().stats();
+            REQUIRE( stats.sent == 32 );
+            REQUIRE( stats.high_water == 32 );
+            REQUIRE( stats.longest_latency >= stats.mean_latency );
+            REQUIRE( stats.mean_latency.count() > 0 );
+        }
+    }
+    AND_GIVEN ("a fifo outlet that drops old values when full") {
+        instance.fifo.queue().configure(32, queue_overflow::overwrite);
+        send_from_another_thread(100);
+        instance.fifo.queue().callback();
+
+        THEN ("the newest values are sent") {
+            REQUIRE( instance.fifo.queue().stats().dropped == 68 );
+            REQUIRE( instance.fifo.queue().stats().sent == 32 );
+        }
+    }
+    AND_GIVEN ("a fifo outlet that grows when full") {
+        instance.scheduler.queue().configure(32, queue_overflow::grow);
+
+        THEN ("values sent from another thread are dropped when it is full") {
+            std::thread sender { [&] {
+                for (auto i = 0; i < 40; ++i)
+                    instance.scheduler.send(i);
+            } };
+            sender.join();
+            REQUIRE( instance.scheduler.queue().stats().dropped == 8 );
+        }
+        AND_THEN ("values sent from the main thread are kept") {
+            for (auto i = 0; i < 100; ++i)
+                instance.scheduler.send(atoms { i, i, i });
+            instance.scheduler.queue().callback();
+
+            auto stats = instance.scheduler.queue().stats();
+            REQUIRE( stats.dropped == 0 );
+            REQUIRE( stats.overflowed == 68 );
+            REQUIRE( stats.sent == 100 );
+        }
+    }
+    AND_GIVEN ("a coalescing outlet") {
+        std::thread sender { [&] {
+            for (auto i = 0; i < 100; ++i)
+                instance.sum.send(i);
+        } };
+        sender.join();
+
+        THEN ("the values are merged into one") {
+            REQUIRE( instance.sum.queue().storage().merged() == 99 );
+            instance.sum.queue().callback();
+        }
+    }
+    AND_GIVEN ("a timed outlet") {
+        instance.timed.send(1);
+        REQUIRE( instance.timed.queue().dropped() == 1 );    // there is no dsp chain yet
+
+        instance.timed.queue().dspsetup(44100.0, 64);
+        instance.timed.queue().callback();
+        REQUIRE( instance.timed.queue().storage() != nullptr );
+        REQUIRE( instance.timed.queue().storage()->capacity() >= 64 );
+
+        WHEN ("values are sent from the audio thread") {
+            size_t allocation_count {};
+
+            std::thread audio { [&] {
+                audio_thread_scope audio_thread;
+                allocation_counter allocations;
+                instance.timed.send_at(0, 1);
+                instance.timed.send_at(441000, 2.0);    // 10 seconds from now
+                allocation_count = allocations.count();
+            } };
+            audio.join();
+
+            THEN ("they are queued without allocating") {
+                REQUIRE( allocation_count == 0 );
+                REQUIRE( instance.timed.queue().storage()->size_approx() == 2 );
+            }
+            AND_THEN ("the scheduler sends those that are due, and keeps running for the rest") {
+                instance.timed.queue().callback();
+                REQUIRE( instance.timed.queue().storage()->size_approx() == 1 );
+                REQUIRE( instance.timed.queue().dropped() == 1 );
+                REQUIRE( instance.timed.queue().running() );
+            }
+        }
+        WHEN ("every value queued has been sent") {
+            std::thread audio { [&] {
+                audio_thread_scope audio_thread;
+                instance.timed.send_at(0, 1);
+            } };
+            audio.join();
+            instance.timed.queue().callback();
+
+            THEN ("the scheduler clock stops") {
+                REQUIRE( instance.timed.queue().storage()->size_approx() == 0 );
+                REQUIRE( !instance.timed.queue().running() );
+            }
+            AND_THEN ("the next value sent from the audio thread starts it again") {
+                std::thread audio { [&] {
+                    audio_thread_scope audio_thread;
+                    instance.timed.send_at(0, 2);
+                } };
+                audio.join();
+                REQUIRE( instance.timed.queue().running() );
+            }
+        }
+    }
+    AND_GIVEN ("first and last outlets") {
+        send_from_another_thread(1000);
+        REQUIRE( instance.first.queue().storage().dropped() == 0 );
+        REQUIRE( instance.last.queue().storage().dropped() == 0 );
+    }
+
+    c74::max::object_free(self);
+}
+
+
+class outlet_check_test : public object<outlet_check_test> {
+public:
+    outlet<thread_check::main, thread_action::last>      main      { this, "(int) main" };
+    outlet<thread_check::scheduler, thread_action::last> scheduler { this, "(int) scheduler" };
+    outlet<thread_check::any, thread_action::last>       any       { this, "(int) any" };
+    outlet<thread_check::none, thread_action::last>      none      { this, "(int) none" };
+};
+
+
+TEST_CASE ("The main thread is cached, and other roles are not", "[outlet]") {
+    REQUIRE( current_thread_role() == thread_role::main );
+    REQUIRE( t_main_thread_role == thread_role::main );
+
+    thread_role role {};
+    std::thread other { [&role] { role = current_thread_role(); } };
+    other.join();
+    REQUIRE( role == thread_role::other );
+}
+
+
+TEST_CASE ("The audio thread is known while a perform routine runs", "[outlet]") {
+    REQUIRE( !is_audio_thread() );
+    {
+        audio_thread_scope outer;
+        {
+            audio_thread_scope inner;
+            REQUIRE( is_audio_thread() );
+        }
+        REQUIRE( is_audio_thread() );
+    }
+    REQUIRE( !is_audio_thread() );
+}
+
+
+// Not run by default. Use `min-tests "[!benchmark]"` to compare the cost of sending from the main thread
+// with each thread_check, and of the thread check itself with that of asking Max.
+// From the main thread the scheduler outlet queues its values rather than sending them.
+
+TEST_CASE ("Outlet sends with each thread check", "[outlet][!benchmark]") {
+    c74::min::wrap_as_max_external<outlet_check_test>("outlet_check_test", "outlet_check_test", nullptr);
+
+    auto  self     = wrapper_new<outlet_check_test>(symbol("outlet_check_test"), 0, nullptr);
+    auto& instance = self->m_min_object;
+
+    BENCHMARK ("asking Max for the main thread") {
+        return c74::max::systhread_ismainthread();
+    };
+
+    BENCHMARK ("cached check for the main thread") {
+        return outlet_call_is_safe<thread_check::main>();
+    };
+
+    BENCHMARK ("check for the main or scheduler thread") {
+        return outlet_call_is_safe<thread_check::any>();
+    };
+
+    BENCHMARK ("send with thread_check::none") {
+        instance.none.send(1);
+    };
+
+    BENCHMARK ("send with thread_check::main") {
+        instance.main.send(1);
+    };
+
+    BENCHMARK ("send with thread_check::any") {
+        instance.any.send(1);
+    };
+
+    BENCHMARK ("send with thread_check::scheduler") {
+        instance.scheduler.send(1);
+    };
+
+    c74::max::object_free(self);
+}
+
+
+SCENARIO ("arrays of numbers are sent without building atoms") {
+    outlet_check_test instance;
+
+    GIVEN ("numbers converted into atoms") {
+        numbers           values { 0.5, 1.5, 2.5 };
+        std::vector<long> longs { 1, 2, 3 };
+        c74::max::t_atom  converted[3];
+
+        outlet_convert(converted, values.data(), values.size());
+        REQUIRE( converted[2].a_type == c74::max::A_FLOAT );
+        REQUIRE( c74::max::atom_getfloat(&converted[2]) == Approx(2.5) );
+
+        outlet_convert(converted, longs.data(), longs.size());
+        REQUIRE( converted[1].a_type == c74::max::A_LONG );
+        REQUIRE( c74::max::atom_getlong(&converted[1]) == 2 );
+    }
+    AND_GIVEN ("a long list that has been sent before") {
+        numbers values(512, 0.25);
+        ints    integers(512, 3);
+
+        instance.main.send(values);
+        instance.main.send(integers);
+
+        allocation_counter allocations;
+        instance.main.send(values);
+        instance.main.send(integers.data(), integers.size());
+        instance.main.send(values.data(), 100);
+        const auto allocation_count = allocations.count();
+
+        THEN ("sending it again does not allocate") {
+            REQUIRE( allocation_count == 0 );
+        }
+    }
+    AND_GIVEN ("numbers sent from another thread") {
+        numbers values(8, 0.25);
+
+        std::thread sender { [&] {
+            instance.main.send(values);
+            instance.main.send(numbers(512));
+        } };
+        sender.join();
+
+        THEN ("they are queued by the outlet's thread_action") {
+            REQUIRE( instance.main.queue().storage().dropped() == 1 );    // the long list doesn't fit
+            instance.main.queue().callback();
+        }
+    }
+}
+
+
+SCENARIO ("a list send triggers a nested, longer list send through the same outlet") {
+    outlet_scratch scratch;
+    numbers        outer(4, 0.5);
+    numbers        inner(600, 2.0);
+
+    GIVEN ("an outer send whose list is being delivered") {
+        const outlet_scratch::lease outer_lease { scratch, outer.size() };
+        const auto                  outer_atoms = outer_lease.data();
+        outlet_convert(outer_atoms, outer.data(), outer.size());
+
+        WHEN ("an object downstream sends a longer list through the outlet before the delivery returns") {
+            c74::max::t_atom* inner_atoms {};
+            {
+                const outlet_scratch::lease inner_lease { scratch, inner.size() };
+                inner_atoms = inner_lease.data();
+                outlet_convert(inner_atoms, inner.data(), inner.size());
+
+                REQUIRE( c74::max::atom_getfloat(&inner_atoms[599]) == 2.0 );
+            }
+
+            THEN ("the nested send used a buffer of its own, and the outer list is intact") {
+                REQUIRE( inner_atoms != outer_atoms );
+                for (auto i = 0u; i < outer.size(); ++i)
+                    REQUIRE( c74::max::atom_getfloat(&outer_atoms[i]) == 0.5 );
+            }
+        }
+    }
+
+    GIVEN ("a send that has returned") {
+        c74::max::t_atom* first {};
+        {
+            const outlet_scratch::lease lease { scratch, 8 };
+            first = lease.data();
+        }
+
+        THEN ("the next send reuses the outlet's buffer") {
+            const outlet_scratch::lease lease { scratch, 8 };
+            REQUIRE( lease.data() == first );
+        }
+    }
+}
+
+
+// Not run by default. Use `min-tests "[!benchmark]"` to compare sending a list of numbers
+// by building atoms with sending the numbers themselves.
+
+TEST_CASE ("Outlet list sends", "[outlet][!benchmark]") {
+    outlet_check_test instance;
+    numbers           values(512, 0.25);
+
+    BENCHMARK ("512 numbers as atoms") {
+        atoms as(values.size());
+        for (auto i = 0u; i < values.size(); ++i)
+            as[i] = values[i];
+        instance.none.send(as);
+    };
+
+    BENCHMARK ("512 numbers as an array") {
+        instance.none.send(values);
+    };
+}
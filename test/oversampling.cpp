@@ -0,0 +1,178 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#include "catch.hpp"
+#include "c74_min_api.h"
+#include "allocation_counter.h"
+
+using namespace c74::min;
+
+
+// The magnitude of one frequency in a signal, in cycles per sample, which must be a whole number of cycles over the signal.
+
+static double magnitude(const sample* samples, const size_t count, const double frequency) {
+    double real {};
+    double imaginary {};
+    for (auto i = 0u; i < count; ++i) {
+        real += samples[i] * std::cos(2.0 * M_PI * frequency * i);
+        imaginary += samples[i] * std::sin(2.0 * M_PI * frequency * i);
+    }
+    return std::sqrt(real * real + imaginary * imaginary) * 2.0 / count;
+}
+
+
+TEST_CASE ("Half-band filters double and halve the samplerate", "[oversampling]") {
+    constexpr size_t   frame_count { 3000 };
+    constexpr double   frequency { 0.1 };
+    numbers            input(frame_count);
+    numbers            upsampled(frame_count * 2);
+    numbers            output(frame_count);
+    halfband_upsampler upsampler;
+    halfband_decimator decimator;
+
+    for (auto i = 0u; i < frame_count; ++i)
+        input[i] = std::sin(2.0 * M_PI * frequency * i);
+
+    upsampler.process(input.data(), upsampled.data(), frame_count);
+
+    SECTION ("upsampling keeps the signal and rejects its image") {
+        const auto window { upsampled.data() + 2000 };
+
+        REQUIRE( magnitude(window, 4000, frequency / 2.0) == Approx(1.0).epsilon(0.001) );
+        REQUIRE( magnitude(window, 4000, 0.5 - frequency / 2.0) < 0.0001 );
+    }
+
+    SECTION ("upsampling and then decimating delays the signal by the latency of both filters") {
+        constexpr auto latency { (halfband_upsampler::latency() + halfband_decimator::latency()) / 2 };
+
+        decimator.process(upsampled.data(), output.data(), frame_count);
+
+        REQUIRE( latency == 15 );
+        for (auto i = 100u; i < frame_count; ++i)
+            REQUIRE( output[i] == Approx(input[i - latency]).margin(0.0001) );
+    }
+}
+
+
+template<size_t factor>
+class oversampled_identity_test : public object<oversampled_identity_test<factor>>, public oversampled<factor, sample_operator<2, 1>> {
+public:
+    int calls {};
+
+    sample operator()(sample input, sample gain) {
+        ++calls;
+        return input * gain;
+    }
+};
+
+
+TEMPLATE_TEST_CASE_SIG ("Oversampled operators are called at a multiple of the samplerate", "[oversampling]",
+    ((size_t factor), factor), 2, 4, 8) {
+    using class_type = oversampled_identity_test<factor>;
+
+    const auto name { "oversampled_identity_test_" + std::to_string(factor) };
+    c74::min::wrap_as_max_external<class_type>(name.c_str(), name.c_str(), nullptr);
+
+    constexpr long frame_count { 64 };
+    auto           self { wrapper_new<class_type>(symbol(name), 0, nullptr) };
+    auto&          instance { self->m_min_object };
+    numbers        input(frame_count * 8);
+    numbers        gain(frame_count * 8, 0.5);
+    numbers        output(frame_count * 8);
+
+    for (auto i = 0u; i < input.size(); ++i)
+        input[i] = std::sin(2.0 * M_PI * 0.02 * i);
+
+    instance.samplerate(44100.0);
+    instance.dspsetup_oversampling(frame_count);
+
+    REQUIRE( instance.samplerate() == 44100.0 * factor );
+    REQUIRE( class_type::latency() == (factor == 2 ? 15 : factor == 4 ? 23 : 27) );
+    REQUIRE( min_getlatency(self) == class_type::latency() );
+
+    allocation_counter allocations;
+    for (auto offset = 0; offset < frame_count * 8; offset += frame_count) {
+        const double* ins[] { input.data() + offset, gain.data() + offset };
+        double*       outs[] { output.data() + offset };
+        performer<class_type>::perform(self, nullptr, ins, 2, outs, 1, frame_count, 0, nullptr);
+    }
+    const auto allocation_count { allocations.count() };
+
+    REQUIRE( allocation_count == 0 );
+    REQUIRE( instance.calls == frame_count * 8 * factor );
+
+    for (auto i = 100u; i < output.size(); ++i)
+        REQUIRE( output[i] == Approx(input[i - class_type::latency()] * 0.5).margin(0.0001) );
+
+    c74::max::object_free(self);
+}
+
+
+// Not run by default. Use `min-tests "[!benchmark]"` to compare the cost of a saturator at each oversampling factor.
+
+class saturate_test : public object<saturate_test>, public sample_operator<1, 1> {
+public:
+    sample operator()(sample input) {
+        return std::tanh(input * 4.0);
+    }
+};
+
+
+template<size_t factor>
+class oversampled_saturate_test : public object<oversampled_saturate_test<factor>>, public oversampled<factor, sample_operator<1, 1>> {
+public:
+    sample operator()(sample input) {
+        return std::tanh(input * 4.0);
+    }
+};
+
+
+template<class class_type>
+static minwrap<class_type>* new_benchmark_instance(const std::string& name) {
+    c74::min::wrap_as_max_external<class_type>(name.c_str(), name.c_str(), nullptr);
+    return wrapper_new<class_type>(symbol(name), 0, nullptr);
+}
+
+
+TEST_CASE ("Oversampling", "[oversampling][!benchmark]") {
+    constexpr long frame_count { 512 };
+    numbers        input(frame_count);
+    numbers        output(frame_count);
+    const double*  ins[] { input.data() };
+    double*        outs[] { output.data() };
+
+    for (auto i = 0; i < frame_count; ++i)
+        input[i] = std::sin(i * 0.1);
+
+    auto self { new_benchmark_instance<saturate_test>("saturate_test") };
+    auto self2 { new_benchmark_instance<oversampled_saturate_test<2>>("oversampled_saturate_test_2") };
+    auto self4 { new_benchmark_instance<oversampled_saturate_test<4>>("oversampled_saturate_test_4") };
+    auto self8 { new_benchmark_instance<oversampled_saturate_test<8>>("oversampled_saturate_test_8") };
+
+    self2->m_min_object.dspsetup_oversampling(frame_count);
+    self4->m_min_object.dspsetup_oversampling(frame_count);
+    self8->m_min_object.dspsetup_oversampling(frame_count);
+
+    BENCHMARK ("512 samples without oversampling") {
+        performer<saturate_test>::perform(self, nullptr, ins, 1, outs, 1, frame_count, 0, nullptr);
+    };
+
+    BENCHMARK ("512 samples oversampled 2 times") {
+        performer<oversampled_saturate_test<2>>::perform(self2, nullptr, ins, 1, outs, 1, frame_count, 0, nullptr);
+    };
+
+    BENCHMARK ("512 samples oversampled 4 times") {
+        performer<oversampled_saturate_test<4>>::perform(self4, nullptr, ins, 1, outs, 1, frame_count, 0, nullptr);
+    };
+
+    BENCHMARK ("512 samples oversampled 8 times") {
+        performer<oversampled_saturate_test<8>>::perform(self8, nullptr, ins, 1, outs, 1, frame_count, 0, nullptr);
+    };
+
+    c74::max::object_free(self8);
+    c74::max::object_free(self4);
+    c74::max::object_free(self2);
+    c74::max::object_free(self);
+}
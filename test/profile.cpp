@@ -0,0 +1,210 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+// Profiling changes the layout of Min's classes, so these tests are built as their own executable
+// with C74_MIN_WITH_PROFILING defined for the whole target.
+
+#define CATCH_CONFIG_MAIN
+
+#include "c74_min_catch.h"
+
+using namespace c74::min;
+
+
+class profile_test : public object<profile_test> {
+public:
+    number sum {};
+
+    message<> set { this, "set",
+        MIN_FUNCTION {
+            sum = args[0];
+            return {};
+        }
+    };
+
+    int_message<> integer { this, "int",
+        [this](const t_atom_long value, const int inlet) {
+            sum += value;
+        }
+    };
+
+    view_message<> list { this, "list",
+        [this](const symbol name, const atom_reference& args, const int inlet) {
+            sum = static_cast<double>(args.size());
+        }
+    };
+};
+
+
+TEST_CASE ("Histogram buckets", "[profile]") {
+    REQUIRE( profile_counters::bucket(0) == 0 );
+    REQUIRE( profile_counters::bucket(999) == 0 );
+    REQUIRE( profile_counters::bucket(1000) == 1 );
+    REQUIRE( profile_counters::bucket(3999) == 2 );
+    REQUIRE( profile_counters::bucket(4000) == 3 );
+    REQUIRE( profile_counters::bucket(uint64_t(1) << 62) == k_profile_histogram_size - 1 );
+
+    profile_counters counters;
+    counters.add(500);
+    counters.add(1500);
+    counters.add(2500);
+
+    REQUIRE( counters.count() == 3 );
+    REQUIRE( counters.total() == 4500 );
+    REQUIRE( counters.longest() == 2500 );
+    REQUIRE( counters.histogram(0) == 1 );
+    REQUIRE( counters.histogram(1) == 1 );
+    REQUIRE( counters.histogram(2) == 1 );
+}
+
+
+SCENARIO ("message calls are profiled by class, message and thread") {
+    c74::min::wrap_as_max_external<profile_test>("profile_test", "profile_test", nullptr);
+
+    GIVEN ("two instances of a class") {
+        auto  first_self  = wrapper_new<profile_test>(symbol("profile_test"), 0, nullptr);
+        auto  second_self = wrapper_new<profile_test>(symbol("profile_test"), 0, nullptr);
+        auto& first       = first_self->m_min_object;
+        auto& second      = second_self->m_min_object;
+
+        auto& profile     = first.profile();
+        auto  calls_of    = [&](const message_base& a_message) -> const profile_counters& {
+            return profile[a_message.slot()].calls(profile_thread::main);
+        };
+
+        const auto set_calls  = calls_of(first.set).count();
+        const auto int_calls  = calls_of(first.integer).count();
+        const auto list_calls = calls_of(first.list).count();
+
+        REQUIRE( &second.profile() == &profile );
+
+        WHEN ("messages are sent to both instances from the main thread") {
+            first.set(1.0);
+            second.set(2.0);
+            wrapper_method_int<profile_test, wrapper_message_name_int>(first_self->maxobj(), 3);
+
+            atoms values { 1, 2, 3 };
+            wrapper_method_generic<profile_test>(second_self->maxobj(), symbol("list"), static_cast<long>(values.size()), values.data());
+
+            THEN ("the calls are counted for the class") {
+                REQUIRE( calls_of(first.set).count() == set_calls + 2 );
+                REQUIRE( calls_of(first.integer).count() == int_calls + 1 );
+                REQUIRE( calls_of(first.list).count() == list_calls + 1 );
+                REQUIRE( profile[first.set.slot()].calls(profile_thread::other).count() == 0 );
+            }
+            AND_THEN ("every call is in the histogram") {
+                const auto& counters = calls_of(first.set);
+                uint64_t    total {};
+
+                for (auto i = 0u; i < k_profile_histogram_size; ++i)
+                    total += counters.histogram(i);
+                REQUIRE( total == counters.count() );
+                REQUIRE( counters.longest() * counters.count() >= counters.total() );
+            }
+        }
+
+        WHEN ("a message is sent from another thread") {
+            const auto deferrals = profile[first.set.slot()].deferrals().count();
+
+            std::thread sender { [&] { first.set(4.0); } };
+            sender.join();
+
+            REQUIRE( profile[first.set.slot()].deferrals().count() == deferrals );
+
+            deferred_message call;
+            REQUIRE( first.deferred_messages().try_dequeue(call) );
+            call.call();
+
+            THEN ("the delay before the call was run is counted along with the call itself") {
+                REQUIRE( first.sum == Approx(4.0) );
+                REQUIRE( profile[first.set.slot()].deferrals().count() == deferrals + 1 );
+                REQUIRE( calls_of(first.set).count() == set_calls + 1 );
+            }
+        }
+
+        AND_WHEN ("the profile is written to a dictionary") {
+            atoms name { symbol("profile_test_dictionary") };
+            wrapper_method_minprofile<profile_test>(first_self->maxobj(), symbol("minprofile"), static_cast<long>(name.size()), name.data());
+
+            THEN ("the counts are unchanged") {
+                REQUIRE( calls_of(first.set).count() == set_calls );
+            }
+        }
+
+        c74::max::object_free(second_self);
+        c74::max::object_free(first_self);
+    }
+}
+
+
+class dsp_load_test : public object<dsp_load_test>, public sample_operator<1, 1> {
+public:
+    sample operator()(sample input) {
+        return std::tanh(input);
+    }
+};
+
+
+SCENARIO ("the perform routine of each audio object is timed") {
+    c74::min::wrap_as_max_external<dsp_load_test>("dsp_load_test", "dsp_load_test", nullptr);
+
+    GIVEN ("two instances of an audio class") {
+        auto    first_self  = wrapper_new<dsp_load_test>(symbol("dsp_load_test"), 0, nullptr);
+        auto    second_self = wrapper_new<dsp_load_test>(symbol("dsp_load_test"), 0, nullptr);
+        auto&   load        = first_self->m_dsp_load;
+        auto    perform     = min_perform_routine<dsp_load_test>();
+        sample  input[64] {};
+        sample  output[64] {};
+        double* ins[] { input };
+        double* outs[] { output };
+
+        REQUIRE( load.vectors().count() == 0 );
+
+        WHEN ("one of them processes some vectors") {
+            min_dsp64_load(first_self, 48000.0);
+            for (auto i = 0; i < 10; ++i)
+                perform(first_self->maxobj(), nullptr, ins, 1, outs, 1, 64, 0, nullptr);
+
+            THEN ("its vectors are counted, and not those of the other instance") {
+                REQUIRE( load.vectors().count() == 10 );
+                REQUIRE( load.frames() == 640 );
+                REQUIRE( second_self->m_dsp_load.vectors().count() == 0 );
+            }
+            AND_THEN ("the load is a fraction of the duration of the vectors") {
+                const auto vector_duration = 64 * 1.0e9 / 48000.0;
+
+                REQUIRE( load.peak() == Approx(load.vectors().longest() / vector_duration) );
+                REQUIRE( load.recent() > 0.0 );
+                REQUIRE( load.recent() <= load.peak() );
+            }
+            AND_WHEN ("the load is written to a dictionary") {
+                atoms name { symbol("dsp_load_test_dictionary") };
+                wrapper_method_dspload<dsp_load_test>(first_self->maxobj(), symbol("dspload"), static_cast<long>(name.size()), name.data());
+
+                THEN ("the counts are unchanged") {
+                    REQUIRE( load.vectors().count() == 10 );
+                }
+            }
+        }
+
+        WHEN ("a vector with no frames is processed, and a vector before there is a samplerate") {
+            min_dsp64_load(first_self, 48000.0);
+            perform(first_self->maxobj(), nullptr, ins, 1, outs, 1, 64, 0, nullptr);
+            perform(first_self->maxobj(), nullptr, ins, 1, outs, 1, 0, 0, nullptr);
+            min_dsp64_load(first_self, 0.0);
+            perform(first_self->maxobj(), nullptr, ins, 1, outs, 1, 64, 0, nullptr);
+
+            THEN ("neither is counted, and the load stays finite") {
+                REQUIRE( load.vectors().count() == 1 );
+                REQUIRE( load.frames() == 64 );
+                REQUIRE( std::isfinite(load.recent()) );
+                REQUIRE( std::isfinite(load.peak()) );
+            }
+        }
+
+        c74::max::object_free(second_self);
+        c74::max::object_free(first_self);
+    }
+}
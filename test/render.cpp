@@ -0,0 +1,147 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#include "catch.hpp"
+#include "c74_min_render.h"
+#include "allocation_counter.h"
+
+using namespace c74::min;
+
+
+class render_test : public object<render_test>, public sample_operator<2, 1> {
+public:
+    inlet<>  input { this, "(signal) input" };
+    inlet<>  gain { this, "(signal) gain" };
+    outlet<> output { this, "(signal) output", "signal" };
+    outlet<> done { this, "(bang) done" };
+
+    sample operator()(sample input, sample gain) {
+        return input * gain * samplerate() / 48000.0;
+    }
+};
+
+
+SCENARIO ("audio is rendered offline through the perform routine") {
+    c74::min::wrap_as_max_external<render_test>("render_test", "render_test", nullptr);
+
+    GIVEN ("a class with two signal inlets and one signal outlet, set up at 48 kHz") {
+        audio_render<render_test> renderer { 48000.0, 32 };
+
+        REQUIRE( renderer.input_count() == 2 );
+        REQUIRE( renderer.output_count() == 1 );
+        REQUIRE( renderer.instance().samplerate() == 48000.0 );
+
+        WHEN ("a ramp and a repeating gain are rendered") {
+            renderer.generate(0, 1000, [](size_t i) { return i * 0.001; });
+            renderer.input(1, { 1.0, 2.0 });
+
+            const auto report { renderer.render<allocation_counter>(0.01) };
+
+            THEN ("every frame is processed, in whole vectors") {
+                REQUIRE( report.frame_count == 480 );
+                REQUIRE( renderer.output(0).size() == 480 );
+                for (auto i = 0u; i < 480; ++i)
+                    REQUIRE( renderer.output(0)[i] == Approx(i * 0.001 * (i % 2 ? 2.0 : 1.0)) );
+            }
+            AND_THEN ("the perform routine is measured, and does not allocate") {
+                REQUIRE( report.elapsed > 0.0 );
+                REQUIRE( report.longest_vector <= report.elapsed );
+                REQUIRE( report.realtime_multiple() == Approx(0.01 / report.elapsed) );
+                REQUIRE( report.allocations );
+                REQUIRE( *report.allocations == 0 );
+            }
+        }
+
+        WHEN ("nothing is rendered") {
+            const auto report { renderer.render(0.0) };
+
+            THEN ("the report's rates are 0 rather than divided by 0") {
+                REQUIRE( report.frame_count == 0 );
+                REQUIRE( report.ns_per_sample() == 0.0 );
+                REQUIRE( report.realtime_multiple() == 0.0 );
+                REQUIRE( render_report {}.longest_vector_load() == 0.0 );
+            }
+        }
+
+        WHEN ("allocations are not counted") {
+            const auto report { renderer.render(0.001, false) };
+
+            THEN ("the report says so, and no output is kept") {
+                REQUIRE( !report.allocations );
+                REQUIRE( renderer.output(0).empty() );
+            }
+        }
+    }
+}
+
+
+// Write a WAV file with the given format and sample bytes.
+
+static void write_wave_file(const std::string& path, const uint16_t format, const uint16_t channel_count, const uint16_t bits, const std::vector<unsigned char>& data) {
+    std::ofstream file { path, std::ios::binary };
+    auto          write = [&](const uint32_t value, const size_t size) {
+        for (auto i = 0u; i < size; ++i)
+            file.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    };
+
+    file << "RIFF";
+    write(static_cast<uint32_t>(36 + data.size()), 4);
+    file << "WAVEfmt ";
+    write(16, 4);
+    write(format, 2);
+    write(channel_count, 2);
+    write(22050, 4);
+    write(22050 * channel_count * bits / 8, 4);
+    write(channel_count * bits / 8, 2);
+    write(bits, 2);
+    file << "data";
+    write(static_cast<uint32_t>(data.size()), 4);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+
+TEST_CASE ("WAV files are read into channels of samples", "[render]") {
+    const std::string path { "render_test.wav" };
+    double            samplerate {};
+
+    SECTION ("16-bit integer samples") {
+        write_wave_file(path, 1, 2, 16, { 0x00, 0x40, 0x00, 0xC0, 0xFF, 0x7F, 0x00, 0x80 });
+
+        const auto channels { read_wave_file(path, &samplerate) };
+
+        REQUIRE( samplerate == 22050.0 );
+        REQUIRE( channels.size() == 2 );
+        REQUIRE( channels[0] == numbers { 0.5, 32767.0 / 32768.0 } );
+        REQUIRE( channels[1] == numbers { -0.5, -1.0 } );
+    }
+
+    SECTION ("32-bit floating-point samples") {
+        float                      values[] { 0.25f, -0.75f };
+        std::vector<unsigned char> data(sizeof values);
+        std::memcpy(data.data(), values, sizeof values);
+        write_wave_file(path, 3, 1, 32, data);
+
+        REQUIRE( read_wave_file(path) == std::vector<numbers> { { 0.25, -0.75 } } );
+    }
+
+    SECTION ("files in other formats are refused") {
+        write_wave_file(path, 2, 1, 4, { 0x00 });
+
+        REQUIRE_THROWS_AS( read_wave_file(path), std::runtime_error );
+    }
+
+    std::remove(path.c_str());
+}
+
+
+TEST_CASE ("The render program prints its usage when asked for help", "[render]") {
+    const char* help[] { "render", "--help" };
+    const char* short_help[] { "render", "-h" };
+    const char* unknown[] { "render", "--unknown" };
+
+    REQUIRE( render_main<render_test>(2, help) == EXIT_SUCCESS );
+    REQUIRE( render_main<render_test>(2, short_help) == EXIT_SUCCESS );
+    REQUIRE( render_main<render_test>(2, unknown) == EXIT_FAILURE );
+}
@@ -0,0 +1,394 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#include "catch.hpp"
+#include "c74_min_api.h"
+
+using namespace c74::min;
+
+
+// The same operator processed one sample at a time, and in batches of four.
+
+class gain_scalar_test : public object<gain_scalar_test>, public sample_operator<2, 1> {
+public:
+    sample operator()(sample input, sample gain) {
+        return std::sqrt(std::abs(input)) * gain + 0.5;
+    }
+};
+
+
+class gain_lanes_test : public object<gain_lanes_test>, public sample_operator<2, 1>, public sample_lanes<4> {
+public:
+    int batch_calls {};
+    int sample_calls {};
+
+    sample_batch<4> operator()(sample_batch<4> input, sample_batch<4> gain) {
+        ++batch_calls;
+        return sqrt(abs(input)) * gain + 0.5;
+    }
+
+    sample operator()(sample input, sample gain) {
+        ++sample_calls;
+        return std::sqrt(std::abs(input)) * gain + 0.5;
+    }
+};
+
+
+class split_lanes_test : public object<split_lanes_test>, public sample_operator<1, 2>, public sample_lanes<8> {
+public:
+    template<class T>
+    std::array<T, 2> operator()(T input) {
+        using std::max;
+        using std::min;
+        return {{ max(input, T(0.0)), min(input, T(0.0)) }};
+    }
+};
+
+
+TEST_CASE ("Arithmetic on batches of samples applies to every lane", "[sample_operator]") {
+    sample          source[4] { -4.0, 1.0, 9.0, 16.0 };
+    auto            batch { sample_batch<4>::load(source) };
+    sample_batch<4> result { sqrt(abs(batch)) * 2.0 - 1.0 };
+    sample          destination[4] {};
+
+    result.store(destination);
+
+    REQUIRE( sample_batch<4>::size() == 4 );
+    REQUIRE( destination[0] == Approx(3.0) );
+    REQUIRE( destination[1] == Approx(1.0) );
+    REQUIRE( destination[2] == Approx(5.0) );
+    REQUIRE( destination[3] == Approx(7.0) );
+    REQUIRE( max(batch, sample_batch<4>(2.0))[0] == Approx(2.0) );
+    REQUIRE( min(batch, sample_batch<4>(2.0))[3] == Approx(2.0) );
+    REQUIRE( (-batch)[0] == Approx(4.0) );
+}
+
+
+SCENARIO ("sample operators with lanes process batches of samples") {
+    c74::min::wrap_as_max_external<gain_scalar_test>("gain_scalar_test", "gain_scalar_test", nullptr);
+    c74::min::wrap_as_max_external<gain_lanes_test>("gain_lanes_test", "gain_lanes_test", nullptr);
+    c74::min::wrap_as_max_external<split_lanes_test>("split_lanes_test", "split_lanes_test", nullptr);
+
+    GIVEN ("a vector whose length is not a multiple of the lane count") {
+        constexpr long frame_count { 67 };
+        sample         input[frame_count];
+        sample         gain[frame_count];
+
+        for (auto i = 0; i < frame_count; ++i) {
+            input[i] = std::sin(i * 0.1) * 2.0;
+            gain[i]  = 0.01 * i;
+        }
+
+        const double* ins[] { input, gain };
+
+        WHEN ("it is processed with and without lanes") {
+            auto          scalar_self { wrapper_new<gain_scalar_test>(symbol("gain_scalar_test"), 0, nullptr) };
+            auto          lanes_self { wrapper_new<gain_lanes_test>(symbol("gain_lanes_test"), 0, nullptr) };
+            sample        scalar_output[frame_count] {};
+            sample        lanes_output[frame_count] {};
+            double*       scalar_outs[] { scalar_output };
+            double*       lanes_outs[] { lanes_output };
+
+            performer<gain_scalar_test>::perform(scalar_self, nullptr, ins, 2, scalar_outs, 1, frame_count, 0, nullptr);
+            performer<gain_lanes_test>::perform(lanes_self, nullptr, ins, 2, lanes_outs, 1, frame_count, 0, nullptr);
+
+            THEN ("whole batches are processed together and the rest one sample at a time") {
+                REQUIRE( lanes_self->m_min_object.batch_calls == 16 );
+                REQUIRE( lanes_self->m_min_object.sample_calls == 3 );
+            }
+            AND_THEN ("the output is the same") {
+                for (auto i = 0; i < frame_count; ++i)
+                    REQUIRE( lanes_output[i] == Approx(scalar_output[i]) );
+            }
+
+            c74::max::object_free(lanes_self);
+            c74::max::object_free(scalar_self);
+        }
+
+        WHEN ("it is processed by an operator with two outputs") {
+            auto    self { wrapper_new<split_lanes_test>(symbol("split_lanes_test"), 0, nullptr) };
+            sample  positive[frame_count] {};
+            sample  negative[frame_count] {};
+            double* outs[] { positive, negative };
+
+            performer<split_lanes_test>::perform(self, nullptr, ins, 1, outs, 2, frame_count, 0, nullptr);
+
+            THEN ("each output is written") {
+                for (auto i = 0; i < frame_count; ++i) {
+                    REQUIRE( positive[i] == Approx(std::max(input[i], 0.0)) );
+                    REQUIRE( negative[i] == Approx(std::min(input[i], 0.0)) );
+                }
+            }
+
+            c74::max::object_free(self);
+        }
+    }
+}
+
+
+// The same filter with an instance for each channel, and with one instance processing channels in lanes.
+
+class biquad_scalar_test : public object<biquad_scalar_test>, public sample_operator<2, 1> {
+public:
+    sample operator()(sample input, sample gain) {
+        const auto output { input * 0.2 + m_z1 };
+        m_z1 = input * 0.4 + output * 0.5 + m_z2;
+        m_z2 = input * 0.2 - output * 0.3;
+        return output * gain;
+    }
+
+private:
+    sample m_z1 {};
+    sample m_z2 {};
+};
+
+
+template<size_t lane_count>
+class biquad_lanes_test : public object<biquad_lanes_test<lane_count>>, public sample_operator<2, 1>, public mc_lanes<lane_count> {
+public:
+    using batch = sample_batch<lane_count>;
+
+    void reset() {
+        m_z1.assign(this->group_count(), {});
+        m_z2.assign(this->group_count(), {});
+    }
+
+    batch operator()(batch input, batch gain) {
+        auto&      z1 { m_z1[this->group()] };
+        auto&      z2 { m_z2[this->group()] };
+        const auto output { input * 0.2 + z1 };
+        z1 = input * 0.4 + output * 0.5 + z2;
+        z2 = input * 0.2 - output * 0.3;
+        return output * gain;
+    }
+
+private:
+    vector<batch> m_z1;
+    vector<batch> m_z2;
+};
+
+
+SCENARIO ("sample operators with mc lanes process a channel in each lane") {
+    c74::min::wrap_as_max_external<biquad_scalar_test>("biquad_scalar_test", "biquad_scalar_test", nullptr);
+    c74::min::wrap_as_max_external<biquad_lanes_test<4>>("biquad_lanes4_test", "biquad_lanes4_test", nullptr);
+
+    GIVEN ("six channels of input and one channel of gain") {
+        constexpr long frame_count { 16 };
+        constexpr long channel_count { 6 };
+        sample         inputs[channel_count + 1][frame_count];
+        const double*  ins[channel_count + 1];
+
+        for (auto channel = 0; channel < channel_count + 1; ++channel) {
+            for (auto i = 0; i < frame_count; ++i)
+                inputs[channel][i] = channel < channel_count ? std::sin(i * 0.3 + channel) : 0.5 + i * 0.01;
+            ins[channel] = inputs[channel];
+        }
+
+        auto  self { wrapper_new<biquad_lanes_test<4>>(symbol("biquad_lanes4_test"), 0, nullptr) };
+        auto& instance { self->m_min_object };
+
+        REQUIRE( min_inputchanged(self, 0, channel_count) );
+        REQUIRE( min_inputchanged(self, 1, 1) == false );
+        REQUIRE( min_multichanneloutputs(self, 0) == channel_count );
+        REQUIRE( instance.group_count() == 2 );
+        REQUIRE( min_inputchanged(self, 2, channel_count * 2) == false );    // there is no third inlet
+        REQUIRE( instance.channel_count() == channel_count );
+
+        instance.reset();
+
+        WHEN ("two vectors are processed with lanes and with an instance for each channel") {
+            sample  lanes_outputs[channel_count][frame_count] {};
+            sample  scalar_outputs[channel_count][frame_count] {};
+            double* lanes_outs[channel_count];
+            std::vector<minwrap<biquad_scalar_test>*> scalar_selves;
+
+            for (auto channel = 0; channel < channel_count; ++channel) {
+                lanes_outs[channel] = lanes_outputs[channel];
+                scalar_selves.push_back(wrapper_new<biquad_scalar_test>(symbol("biquad_scalar_test"), 0, nullptr));
+            }
+
+            for (auto vector = 0; vector < 2; ++vector) {
+                performer<biquad_lanes_test<4>>::perform(self, nullptr, ins, channel_count + 1, lanes_outs, channel_count, frame_count, 0, nullptr);
+
+                for (auto channel = 0; channel < channel_count; ++channel) {
+                    const double* scalar_ins[] { inputs[channel], inputs[channel_count] };
+                    double*       scalar_outs[] { scalar_outputs[channel] };
+                    performer<biquad_scalar_test>::perform(scalar_selves[channel], nullptr, scalar_ins, 2, scalar_outs, 1, frame_count, 0, nullptr);
+                }
+            }
+
+            THEN ("each channel keeps its own state, and the gain applies to every channel") {
+                for (auto channel = 0; channel < channel_count; ++channel) {
+                    for (auto i = 0; i < frame_count; ++i)
+                        REQUIRE( lanes_outputs[channel][i] == Approx(scalar_outputs[channel][i]) );
+                }
+            }
+
+            for (auto scalar_self : scalar_selves)
+                c74::max::object_free(scalar_self);
+        }
+
+        c74::max::object_free(self);
+    }
+}
+
+
+class scaled_lanes_test : public object<scaled_lanes_test>, public sample_operator<2, 1>, public mc_lanes<4> {
+public:
+    using batch = sample_batch<4>;
+
+    attribute<number> scale { this, "scale", 2.0 };
+
+    batch operator()(batch input, batch) {
+        return input * static_cast<number>(scale);
+    }
+};
+
+
+SCENARIO ("sample operators with mc lanes leave attributes mapped to inlets without channels alone") {
+    c74::min::wrap_as_max_external<scaled_lanes_test>("scaled_lanes_test", "scaled_lanes_test", nullptr);
+
+    GIVEN ("an attribute mapped to an inlet with no channels") {
+        constexpr long frame_count { 8 };
+        sample         input[frame_count] { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0 };
+        sample         output[frame_count] {};
+        const double*  ins[] { input };
+        double*        outs[] { output };
+
+        auto  self { wrapper_new<scaled_lanes_test>(symbol("scaled_lanes_test"), 0, nullptr) };
+        auto& instance { self->m_min_object };
+
+        instance.input_channel_count(0, 1);
+        instance.input_channel_count(1, 0);
+        instance.mapped_attributes().add(1, &instance.scale);
+
+        WHEN ("a vector is processed") {
+            performer<scaled_lanes_test>::perform(self, nullptr, ins, 1, outs, 1, frame_count, 0, nullptr);
+
+            THEN ("the attribute keeps its value") {
+                REQUIRE( static_cast<number>(instance.scale) == 2.0 );
+                for (auto i = 0; i < frame_count; ++i)
+                    REQUIRE( output[i] == input[i] * 2.0 );
+            }
+        }
+
+        c74::max::object_free(self);
+    }
+}
+
+
+// Not run by default. Use `min-tests "[!benchmark]"` to compare processing a vector one sample at a time
+// with processing it in batches.
+
+template<class min_class_type>
+static void perform_vector(minwrap<min_class_type>* self, const double** ins, double** outs, const long frame_count) {
+    performer<min_class_type>::perform(self, nullptr, ins, 2, outs, 1, frame_count, 0, nullptr);
+}
+
+
+class mix_scalar_test : public object<mix_scalar_test>, public sample_operator<2, 1> {
+public:
+    sample operator()(sample a, sample b) {
+        return a * 0.75 + b * 0.25;
+    }
+};
+
+
+template<size_t lane_count>
+class mix_lanes_test : public object<mix_lanes_test<lane_count>>, public sample_operator<2, 1>, public sample_lanes<lane_count> {
+public:
+    template<class T>
+    T operator()(T a, T b) {
+        return a * 0.75 + b * 0.25;
+    }
+};
+
+
+TEST_CASE ("Sample operator vectors", "[sample_operator][!benchmark]") {
+    c74::min::wrap_as_max_external<mix_scalar_test>("mix_scalar_test", "mix_scalar_test", nullptr);
+    c74::min::wrap_as_max_external<mix_lanes_test<4>>("mix_lanes4_test", "mix_lanes4_test", nullptr);
+    c74::min::wrap_as_max_external<mix_lanes_test<8>>("mix_lanes8_test", "mix_lanes8_test", nullptr);
+
+    constexpr long frame_count { 512 };
+    numbers        a(frame_count, 0.25);
+    numbers        b(frame_count, 0.5);
+    numbers        output(frame_count);
+    const double*  ins[] { a.data(), b.data() };
+    double*        outs[] { output.data() };
+
+    auto scalar_self { wrapper_new<mix_scalar_test>(symbol("mix_scalar_test"), 0, nullptr) };
+    auto lanes4_self { wrapper_new<mix_lanes_test<4>>(symbol("mix_lanes4_test"), 0, nullptr) };
+    auto lanes8_self { wrapper_new<mix_lanes_test<8>>(symbol("mix_lanes8_test"), 0, nullptr) };
+
+    BENCHMARK ("512 samples one at a time") {
+        perform_vector(scalar_self, ins, outs, frame_count);
+    };
+
+    BENCHMARK ("512 samples in batches of 4") {
+        perform_vector(lanes4_self, ins, outs, frame_count);
+    };
+
+    BENCHMARK ("512 samples in batches of 8") {
+        perform_vector(lanes8_self, ins, outs, frame_count);
+    };
+
+    c74::max::object_free(lanes8_self);
+    c74::max::object_free(lanes4_self);
+    c74::max::object_free(scalar_self);
+}
+
+
+// Not run by default. Use `min-tests "[!benchmark]"` to compare filtering 16 channels with an instance for each channel
+// with filtering them in lanes of one instance.
+
+TEST_CASE ("Sample operator channels", "[sample_operator][!benchmark]") {
+    c74::min::wrap_as_max_external<biquad_scalar_test>("biquad_scalar_test", "biquad_scalar_test", nullptr);
+    c74::min::wrap_as_max_external<biquad_lanes_test<4>>("biquad_lanes4_test", "biquad_lanes4_test", nullptr);
+    c74::min::wrap_as_max_external<biquad_lanes_test<8>>("biquad_lanes8_test", "biquad_lanes8_test", nullptr);
+
+    constexpr long       frame_count { 64 };
+    constexpr long       channel_count { 16 };
+    std::vector<numbers> inputs(channel_count + 1, numbers(frame_count, 0.25));
+    std::vector<numbers> outputs(channel_count, numbers(frame_count));
+    const double*        ins[channel_count + 1];
+    double*              outs[channel_count];
+
+    for (auto channel = 0; channel < channel_count; ++channel) {
+        ins[channel]  = inputs[channel].data();
+        outs[channel] = outputs[channel].data();
+    }
+    ins[channel_count] = inputs[channel_count].data();
+
+    std::vector<minwrap<biquad_scalar_test>*> scalar_selves;
+    for (auto channel = 0; channel < channel_count; ++channel)
+        scalar_selves.push_back(wrapper_new<biquad_scalar_test>(symbol("biquad_scalar_test"), 0, nullptr));
+
+    auto lanes4_self { wrapper_new<biquad_lanes_test<4>>(symbol("biquad_lanes4_test"), 0, nullptr) };
+    auto lanes8_self { wrapper_new<biquad_lanes_test<8>>(symbol("biquad_lanes8_test"), 0, nullptr) };
+    for (auto lanes_self : { static_cast<mc_lanes_base*>(&lanes4_self->m_min_object), static_cast<mc_lanes_base*>(&lanes8_self->m_min_object) })
+        lanes_self->input_channel_count(0, channel_count);
+    lanes4_self->m_min_object.reset();
+    lanes8_self->m_min_object.reset();
+
+    BENCHMARK ("16 channels with an instance for each") {
+        for (auto channel = 0; channel < channel_count; ++channel) {
+            const double* scalar_ins[] { ins[channel], ins[channel_count] };
+            performer<biquad_scalar_test>::perform(scalar_selves[channel], nullptr, scalar_ins, 2, outs + channel, 1, frame_count, 0, nullptr);
+        }
+    };
+
+    BENCHMARK ("16 channels in lanes of 4") {
+        performer<biquad_lanes_test<4>>::perform(lanes4_self, nullptr, ins, channel_count + 1, outs, channel_count, frame_count, 0, nullptr);
+    };
+
+    BENCHMARK ("16 channels in lanes of 8") {
+        performer<biquad_lanes_test<8>>::perform(lanes8_self, nullptr, ins, channel_count + 1, outs, channel_count, frame_count, 0, nullptr);
+    };
+
+    c74::max::object_free(lanes8_self);
+    c74::max::object_free(lanes4_self);
+    for (auto scalar_self : scalar_selves)
+        c74::max::object_free(scalar_self);
+}
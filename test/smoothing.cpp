@@ -0,0 +1,171 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#include "catch.hpp"
+#include "c74_min_api.h"
+#include "allocation_counter.h"
+
+using namespace c74::min;
+
+
+class smoothing_test : public object<smoothing_test>, public sample_operator<1, 1> {
+public:
+    smoother m_gain { this, 0.0, 1.0 };
+
+    sample operator()(sample input) {
+        return input * m_gain.value();
+    }
+};
+
+
+TEST_CASE ("Smoothers ramp to their targets on the audio thread", "[smoothing]") {
+    smoothing_test instance;
+    auto&          gain { instance.m_gain };
+
+    REQUIRE( instance.smoothers().size() == 1 );
+
+    instance.dspsetup_smoothers(8000.0, 16);    // a ramp time of 1 ms is 8 samples
+
+    SECTION ("a linear ramp reaches the target at the end of the ramp time") {
+        gain.target(1.0);
+        instance.advance_smoothers(16);
+
+        REQUIRE( gain.ramping() == false );
+        for (auto i = 0; i < 8; ++i)
+            REQUIRE( gain[i] == Approx((i + 1) / 8.0) );
+        for (auto i = 8; i < 16; ++i)
+            REQUIRE( gain[i] == 1.0 );
+    }
+
+    SECTION ("a ramp continues into the next vector") {
+        gain.target(1.0);
+        instance.advance_smoothers(4);
+
+        REQUIRE( gain.ramping() );
+        REQUIRE( gain[3] == Approx(0.5) );
+
+        instance.advance_smoothers(4);
+
+        REQUIRE( gain[0] == Approx(0.625) );
+        REQUIRE( gain[3] == 1.0 );
+        REQUIRE( gain.ramping() == false );
+    }
+
+    SECTION ("an exponential ramp approaches the target and then jumps to it") {
+        gain.shape(ramp_shape::exponential);
+        gain.target(1.0);
+        instance.advance_smoothers(16);
+
+        for (auto i = 1; i < 8; ++i)
+            REQUIRE( gain[i] > gain[i - 1] );
+        REQUIRE( gain[7] == Approx(0.999) );
+        REQUIRE( gain[8] == 1.0 );
+    }
+
+    SECTION ("the ramp time can be given in any unit of time") {
+        gain.ramp_time<dataspace::time::seconds>(0.002);
+        REQUIRE( gain.ramp_time() == Approx(2.0) );
+
+        gain.target(1.0);
+        instance.advance_smoothers(16);
+
+        REQUIRE( gain[7] == Approx(0.5) );
+        REQUIRE( gain[15] == 1.0 );
+    }
+
+    SECTION ("targets are set from another thread and the ramp computed without allocating") {
+        std::thread setter { [&] { gain.target(2.0); } };
+        setter.join();
+
+        allocation_counter allocations;
+        instance.advance_smoothers(16);
+        const auto allocation_count { allocations.count() };
+
+        REQUIRE( allocation_count == 0 );
+        REQUIRE( gain[15] == 2.0 );
+    }
+}
+
+
+SCENARIO ("a sample operator reads its smoother one sample at a time") {
+    c74::min::wrap_as_max_external<smoothing_test>("smoothing_test", "smoothing_test", nullptr);
+
+    GIVEN ("an instance with a target set") {
+        auto   self { wrapper_new<smoothing_test>(symbol("smoothing_test"), 0, nullptr) };
+        sample input[16];
+        sample output[16] {};
+
+        std::fill(input, input + 16, 2.0);
+        self->m_min_object.dspsetup_smoothers(8000.0, 16);
+        self->m_min_object.m_gain.target(1.0);
+
+        const double* ins[] { input };
+        double*       outs[] { output };
+
+        WHEN ("a vector is processed") {
+            performer<smoothing_test>::perform(self, nullptr, ins, 1, outs, 1, 16, 0, nullptr);
+
+            THEN ("each sample is processed with its own value of the ramp") {
+                for (auto i = 0; i < 8; ++i)
+                    REQUIRE( output[i] == Approx(2.0 * (i + 1) / 8.0) );
+                REQUIRE( output[15] == Approx(2.0) );
+            }
+        }
+
+        c74::max::object_free(self);
+    }
+}
+
+
+class smoothing_lanes_test : public object<smoothing_lanes_test>, public sample_operator<1, 1>, public mc_lanes<4> {
+public:
+    using batch = sample_batch<4>;
+
+    smoother m_gain { this, 0.0, 1.0 };
+
+    batch operator()(batch input) {
+        return input * m_gain.value<batch>();
+    }
+};
+
+
+SCENARIO ("a sample operator with mc lanes reads the same smoothed value in every lane") {
+    c74::min::wrap_as_max_external<smoothing_lanes_test>("smoothing_lanes_test", "smoothing_lanes_test", nullptr);
+
+    GIVEN ("an instance with six channels and a target set") {
+        constexpr long       frame_count { 16 };
+        constexpr long       channel_count { 6 };
+        std::vector<numbers> inputs(channel_count, numbers(frame_count, 2.0));
+        std::vector<numbers> outputs(channel_count, numbers(frame_count));
+        const double*        ins[channel_count];
+        double*              outs[channel_count];
+
+        for (auto channel = 0; channel < channel_count; ++channel) {
+            ins[channel]  = inputs[channel].data();
+            outs[channel] = outputs[channel].data();
+        }
+
+        auto  self { wrapper_new<smoothing_lanes_test>(symbol("smoothing_lanes_test"), 0, nullptr) };
+        auto& instance { self->m_min_object };
+
+        instance.input_channel_count(0, channel_count);
+        instance.dspsetup_smoothers(8000.0, frame_count);
+        instance.m_gain.target(1.0);
+
+        WHEN ("a vector is processed") {
+            performer<smoothing_lanes_test>::perform(self, nullptr, ins, channel_count, outs, channel_count, frame_count, 0, nullptr);
+
+            THEN ("every channel is processed with the value of the ramp at its frame") {
+                for (auto channel = 0; channel < channel_count; ++channel) {
+                    for (auto i = 0; i < 8; ++i)
+                        REQUIRE( outputs[channel][i] == Approx(2.0 * (i + 1) / 8.0) );
+                    REQUIRE( outputs[channel][15] == Approx(2.0) );
+                }
+            }
+        }
+
+        c74::max::object_free(self);
+    }
+}
@@ -0,0 +1,210 @@
+/// @file
+///	@ingroup 	minapi
+///	@copyright	Copyright 2018 The Min-API Authors. All rights reserved.
+///	@license	Use of this source code is governed by the MIT License found in the License.md file.
+
+#include "catch.hpp"
+#include "c74_min_api.h"
+#include "allocation_counter.h"
+
+#include <set>
+
+using namespace c74::min;
+
+
+TEST_CASE ("Worker pools run each job once", "[worker_pool]") {
+    worker_pool pool { 3 };
+
+    REQUIRE( pool.thread_count() == 3 );
+
+    SECTION ("over many runs, without allocating") {
+        std::vector<std::atomic<int>> runs(37);
+        auto job = [&](const size_t index) {
+            runs[index].fetch_add(1);
+        };
+
+        allocation_counter allocations;
+        auto               all_run { true };
+        for (auto i = 0; i < 1000; ++i)
+            all_run = pool.run(runs.size(), job) && all_run;
+        const auto allocation_count { allocations.count() };
+
+        REQUIRE( allocation_count == 0 );
+        REQUIRE( all_run );
+        for (auto& count : runs)
+            REQUIRE( count == 1000 );
+    }
+
+    SECTION ("after the workers have gone to sleep") {
+        std::atomic<int> run_count {};
+        auto job = [&](const size_t) {
+            ++run_count;
+        };
+
+        pool.run(8, job);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        pool.run(8, job);
+
+        REQUIRE( run_count == 16 );
+    }
+
+    SECTION ("on more than one thread, when the jobs take a while") {
+        std::mutex                  mutex;
+        std::set<std::thread::id>   threads;
+        auto job = [&](const size_t) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            std::lock_guard<std::mutex> lock { mutex };
+            threads.insert(std::this_thread::get_id());
+        };
+
+        pool.run(64, job);
+
+        REQUIRE( threads.size() > 1 );
+    }
+}
+
+
+TEST_CASE ("Worker pools without workers leave the jobs to the caller", "[worker_pool]") {
+    worker_pool pool { 0 };
+    auto        run_count { 0 };
+    auto job = [&](const size_t) {
+        ++run_count;
+    };
+
+    REQUIRE( pool.run(4, job) == false );
+    REQUIRE( run_count == 0 );
+}
+
+
+TEST_CASE ("Worker pools that are shut down leave the jobs to the caller", "[worker_pool]") {
+    worker_pool pool { 2, std::chrono::microseconds(0) };
+    auto        run_count { 0 };
+    auto job = [&](const size_t) {
+        ++run_count;
+    };
+
+    REQUIRE( pool.spin_time() == std::chrono::microseconds(0) );
+    REQUIRE( pool.run(4, job) );
+    REQUIRE( run_count == 4 );
+
+    pool.shutdown();
+    pool.shutdown();
+
+    REQUIRE( pool.run(4, job) == false );
+    REQUIRE( run_count == 4 );
+}
+
+
+TEST_CASE ("The shared worker pool leaves some processors free", "[worker_pool]") {
+    REQUIRE( worker_pool::default_thread_count() < std::max(std::thread::hardware_concurrency(), 1u) );
+    REQUIRE( worker_pool::default_thread_count() <= std::max(std::thread::hardware_concurrency() / 4, 1u) );
+    REQUIRE( worker_pool::shared().thread_count() == worker_pool::default_thread_count() );
+}
+
+
+// An mc object that adds the same input to each of its output channels, which it spreads across threads.
+// It has a pool of its own, so that it has workers even on a machine with one processor.
+
+static worker_pool s_test_pool { 3 };
+
+class mc_parallel_test : public object<mc_parallel_test>, public mc_operator<>, public mc_parallel<2, 8> {
+public:
+    mc_parallel_test()
+    : mc_parallel { s_test_pool }
+    {}
+
+    inlet<>  input  { this, "(multichannelsignal) input" };
+    outlet<> output { this, "(multichannelsignal) output", "multichannelsignal" };
+
+    std::atomic<int> calls {};
+
+    void operator()(audio_bundle input, audio_bundle output, const size_t first_channel) {
+        ++calls;
+        for (auto channel = 0; channel < output.channel_count(); ++channel) {
+            for (auto i = 0; i < output.frame_count(); ++i)
+                output.samples(channel)[i] = input.samples(0)[i] + first_channel + channel;
+        }
+    }
+};
+
+
+SCENARIO ("an mc object processes groups of its channels on different threads") {
+    c74::min::wrap_as_max_external<mc_parallel_test>("mc_parallel_test", "mc_parallel_test", nullptr);
+
+    auto   self { wrapper_new<mc_parallel_test>(symbol("mc_parallel_test"), 0, nullptr) };
+    auto&  instance { self->m_min_object };
+    sample input[16];
+    sample outputs[9][16] {};
+
+    for (auto i = 0; i < 16; ++i)
+        input[i] = i * 0.5;
+
+    const double* ins[] { input };
+    double*       outs[9];
+    for (auto channel = 0; channel < 9; ++channel)
+        outs[channel] = outputs[channel];
+
+    GIVEN ("as many channels as the minimum") {
+        WHEN ("a vector is processed") {
+            performer<mc_parallel_test>::perform(self, nullptr, const_cast<double**>(ins), 1, outs, 9, 16, 0, nullptr);
+
+            THEN ("every channel is processed by one of the calls for each group") {
+                REQUIRE( instance.calls == 5 );
+                for (auto channel = 0; channel < 9; ++channel) {
+                    for (auto i = 0; i < 16; ++i)
+                        REQUIRE( outputs[channel][i] == input[i] + channel );
+                }
+            }
+        }
+    }
+
+    GIVEN ("fewer channels than the minimum") {
+        WHEN ("a vector is processed") {
+            performer<mc_parallel_test>::perform(self, nullptr, const_cast<double**>(ins), 1, outs, 4, 16, 0, nullptr);
+
+            THEN ("all of the channels are processed by one call") {
+                REQUIRE( instance.calls == 1 );
+                REQUIRE( outputs[3][15] == input[15] + 3 );
+            }
+        }
+    }
+
+    c74::max::object_free(self);
+}
+
+
+// Not run by default. Use `min-tests "[!benchmark]"` to compare processing 128 channels on one thread
+// with spreading them across the shared pool.
+
+TEST_CASE ("Worker pool", "[worker_pool][!benchmark]") {
+    constexpr size_t channel_count { 128 };
+    constexpr size_t frame_count { 64 };
+
+    std::vector<numbers> channels(channel_count, numbers(frame_count, 0.5));
+
+    auto job = [&](const size_t index) {
+        for (auto channel = index * 8; channel < (index + 1) * 8; ++channel) {
+            auto& samples { channels[channel] };
+            for (auto pass = 0; pass < 16; ++pass) {
+                for (auto i = 1u; i < frame_count; ++i)
+                    samples[i] = std::tanh(samples[i] * 0.9 + samples[i - 1] * 0.1);
+            }
+        }
+    };
+
+    auto& pool { worker_pool::shared() };
+
+    BENCHMARK ("128 channels on one thread") {
+        for (auto index = 0u; index < channel_count / 8; ++index)
+            job(index);
+        return channels[0][1];
+    };
+
+    BENCHMARK ("128 channels with " + std::to_string(pool.thread_count()) + " workers") {
+        if (!pool.run(channel_count / 8, job)) {
+            for (auto index = 0u; index < channel_count / 8; ++index)
+                job(index);
+        }
+        return channels[0][1];
+    };
+}